@@ -0,0 +1,91 @@
+#pragma once
+
+
+#include <cstdint>
+#include "../game/labels.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace AI {
+
+	enum class TypeOfMove : uint8_t {
+		Settlement,
+		City,
+		Road,
+		Wall,
+		Pass
+	};
+
+	TypeOfMove typeOfMoveFromString(const std::string& moveType) {
+		if (moveType == "settlement") { return TypeOfMove::Settlement; }
+		if (moveType == "city") { return TypeOfMove::City; }
+		if (moveType == "road") { return TypeOfMove::Road; }
+		if (moveType == "wall") { return TypeOfMove::Wall; }
+		if (moveType == "pass") { return TypeOfMove::Pass; }
+		throw std::runtime_error("Unknown move type: " + moveType);
+	}
+
+	std::string toString(TypeOfMove typeOfMove) {
+		switch (typeOfMove) {
+		case TypeOfMove::Settlement: return "settlement";
+		case TypeOfMove::City: return "city";
+		case TypeOfMove::Road: return "road";
+		case TypeOfMove::Wall: return "wall";
+		case TypeOfMove::Pass: return "pass";
+		}
+		throw std::runtime_error("Invalid type of move.");
+	}
+
+	/* Actions are indexed so that a move fits in a byte.
+	* Indices 0 to 53 represent vertices V01 to V54, indices 54 to 125 represent edges E01 to E72, and index 126 represents passing.
+	*/
+	constexpr int INDEX_OF_FIRST_EDGE_ACTION = Game::NUMBER_OF_VERTICES;
+	constexpr int INDEX_OF_PASS_ACTION = Game::NUMBER_OF_VERTICES + Game::NUMBER_OF_EDGES;
+	constexpr int NUMBER_OF_ACTIONS = INDEX_OF_PASS_ACTION + 1;
+
+	int getIndexOfAction(const std::string& move, const std::string& moveType) {
+		if (moveType == "pass") {
+			return INDEX_OF_PASS_ACTION;
+		}
+		if (moveType == "road") {
+			return INDEX_OF_FIRST_EDGE_ACTION + Game::getIndexOfLabel(move, Game::NUMBER_OF_EDGES);
+		}
+		return Game::getIndexOfLabel(move, Game::NUMBER_OF_VERTICES);
+	}
+
+	// Function `getMoveOfAction` returns the label of the vertex or edge of an action, or "pass".
+	std::string getMoveOfAction(int indexOfAction) {
+		if (indexOfAction == INDEX_OF_PASS_ACTION) {
+			return "pass";
+		}
+		if (indexOfAction >= INDEX_OF_FIRST_EDGE_ACTION) {
+			return Game::formatLabel('E', indexOfAction - INDEX_OF_FIRST_EDGE_ACTION + 1);
+		}
+		return Game::formatLabel('V', indexOfAction + 1);
+	}
+
+	/* Type `VisitDistribution` is a sparse distribution over actions, such as the fractions of visits of the children of the root of a search.
+	* Each pair holds an index of an action and its probability; actions that are absent have probability 0.
+	*/
+	using VisitDistribution = std::vector<std::pair<int, float>>;
+
+	/* Enumeration `PolicyHead` selects what the policy head of a network predicts.
+	* A scalar head scores one candidate move from the grid representation of the move with a sigmoid.
+	* An actions head predicts logits of all `NUMBER_OF_ACTIONS` actions from the features of a state,
+	* so that one evaluation gives priors of every child of a node and training can use the whole distribution of visits of a search.
+	*/
+	enum class PolicyHead {
+		Scalar,
+		Actions
+	};
+
+	PolicyHead policyHeadFromString(const std::string& string) {
+		if (string == "scalar") { return PolicyHead::Scalar; }
+		if (string == "actions") { return PolicyHead::Actions; }
+		throw std::runtime_error("Unknown policy head: " + string);
+	}
+
+}
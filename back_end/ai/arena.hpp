@@ -0,0 +1,210 @@
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include "../game/game_state.hpp"
+#include "../logger.hpp"
+#include <mutex>
+#include "neural_network.hpp"
+#include "../random.hpp"
+#include "self_play.hpp"
+#include <stdexcept>
+#include <stop_token>
+#include "strategy.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace AI {
+
+	constexpr int NUMBER_OF_SEATS_OF_ARENA = 3;
+
+	/* Structure `ResultOfMatch` summarizes a match between a candidate network and the best network.
+	* `winRate` is the pairwise score of the candidate against the seats of the best network,
+	* where a win of the candidate beats both other seats, a win of another seat beats the candidate and ties the candidate with the third seat, and
+	* a game without a winner ties all seats. Networks of equal strength have a win rate of 0.5.
+	*/
+	struct ResultOfMatch {
+		int numberOfGames{ 0 };
+		int numberOfWins{ 0 };
+		int numberOfLosses{ 0 };
+		int numberOfDraws{ 0 };
+		double winRate{ 0.0 };
+		double differenceOfElo{ 0.0 };
+		bool candidateIsPromoted{ false };
+	};
+
+	/* Class `Arena` plays matches between a candidate network and the best network to decide whether the candidate is promoted.
+	* Games run in parallel on `numberOfThreads` threads. Each game uses `runMcts` with a fixed number of simulations and no Dirichlet noise, and
+	* its dice are rolled by a generator seeded from `seed` and the index of the game, so that a match is reproducible.
+	* Consecutive groups of 3 games share dice and seat the candidate once in each seat, so that neither seats nor dice favor a network.
+	*/
+	class Arena {
+	public:
+
+		Arena(
+			int numberOfGamesToUse,
+			int numberOfSimulationsToUse,
+			double cPuctToUse,
+			double toleranceToUse,
+			double winRateThresholdToUse,
+			uint64_t seedToUse,
+			int numberOfThreadsToUse
+		) : numberOfGames(numberOfGamesToUse),
+			numberOfSimulations(numberOfSimulationsToUse),
+			cPuct(cPuctToUse),
+			tolerance(toleranceToUse),
+			winRateThreshold(winRateThresholdToUse),
+			seed(seedToUse),
+			numberOfThreads(numberOfThreadsToUse > 0 ? numberOfThreadsToUse : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))
+		{
+			// Do nothing.
+		}
+
+		// Method `isEnabled` returns whether candidates are gated by matches; with no games, every candidate is promoted.
+		bool isEnabled() const {
+			return numberOfGames > 0;
+		}
+
+		/* Method `playMatch` plays `numberOfGames` games between a candidate and the best network and
+		* promotes the candidate when its win rate reaches the threshold. A match stopped before all games complete does not promote.
+		*/
+		ResultOfMatch playMatch(WrapperOfNeuralNetwork& candidate, WrapperOfNeuralNetwork& best, std::stop_token stopToken) const {
+			Logger::info("[ARENA] A match of " + std::to_string(numberOfGames) + " games on " + std::to_string(numberOfThreads) + " threads is starting.");
+			std::chrono::steady_clock::time_point timeOfStart = std::chrono::steady_clock::now();
+			// Element i of `vectorOfWinners` is the seat that won game i, 0 if game i had no winner, or -1 if game i was not played.
+			std::vector<int> vectorOfWinners(numberOfGames, -1);
+			std::atomic<int> indexOfNextGame{ 0 };
+			std::mutex mutexOfException;
+			std::exception_ptr exception;
+			{
+				std::vector<std::jthread> vectorOfThreads;
+				int numberOfThreadsToStart = std::min(numberOfThreads, numberOfGames);
+				for (int i = 0; i < numberOfThreadsToStart; i++) {
+					vectorOfThreads.emplace_back([&]() {
+						for (int indexOfGame = indexOfNextGame++; indexOfGame < numberOfGames && !stopToken.stop_requested(); indexOfGame = indexOfNextGame++) {
+							try {
+								vectorOfWinners[indexOfGame] = playGame(indexOfGame, candidate, best);
+							}
+							catch (...) {
+								std::lock_guard<std::mutex> lock(mutexOfException);
+								if (!exception) {
+									exception = std::current_exception();
+								}
+								indexOfNextGame = numberOfGames;
+							}
+						}
+					});
+				}
+			}
+			if (exception) {
+				std::rethrow_exception(exception);
+			}
+
+			ResultOfMatch resultOfMatch;
+			double score = 0.0;
+			for (int indexOfGame = 0; indexOfGame < numberOfGames; indexOfGame++) {
+				int winner = vectorOfWinners[indexOfGame];
+				if (winner < 0) {
+					continue;
+				}
+				resultOfMatch.numberOfGames++;
+				if (winner == 0) {
+					resultOfMatch.numberOfDraws++;
+					score += 1.0;
+				}
+				else if (winner == getSeatOfCandidate(indexOfGame)) {
+					resultOfMatch.numberOfWins++;
+					score += 2.0;
+				}
+				else {
+					resultOfMatch.numberOfLosses++;
+					score += 0.5;
+				}
+			}
+			if (resultOfMatch.numberOfGames > 0) {
+				// Each game compares the candidate with 2 seats of the best network.
+				resultOfMatch.winRate = score / (2.0 * resultOfMatch.numberOfGames);
+				resultOfMatch.differenceOfElo = calculateDifferenceOfElo(resultOfMatch.winRate, 2 * resultOfMatch.numberOfGames);
+			}
+			resultOfMatch.candidateIsPromoted =
+				resultOfMatch.numberOfGames == numberOfGames &&
+				resultOfMatch.winRate >= winRateThreshold;
+
+			std::chrono::duration<double> durationOfMatch = std::chrono::steady_clock::now() - timeOfStart;
+			Logger::info(
+				"[ARENA] The candidate won " + std::to_string(resultOfMatch.numberOfWins) +
+				", lost " + std::to_string(resultOfMatch.numberOfLosses) +
+				", and drew " + std::to_string(resultOfMatch.numberOfDraws) +
+				" of " + std::to_string(resultOfMatch.numberOfGames) + " games in " + std::to_string(durationOfMatch.count()) + " s" +
+				" with win rate " + std::to_string(resultOfMatch.winRate) +
+				" and estimated Elo difference " + std::to_string(resultOfMatch.differenceOfElo) +
+				"; the candidate was " + (resultOfMatch.candidateIsPromoted ? "promoted." : "rejected.")
+			);
+			return resultOfMatch;
+		}
+
+	private:
+		double cPuct;
+		int numberOfGames;
+		int numberOfSimulations;
+		int numberOfThreads;
+		uint64_t seed;
+		double tolerance;
+		double winRateThreshold;
+
+		static int getSeatOfCandidate(int indexOfGame) {
+			return indexOfGame % NUMBER_OF_SEATS_OF_ARENA + 1;
+		}
+
+		/* Function `calculateDifferenceOfElo` converts a win rate into a difference of Elo ratings.
+		* The win rate is clamped by half a game at either end so that a sweep yields a finite estimate.
+		*/
+		static double calculateDifferenceOfElo(double winRate, int numberOfComparisons) {
+			double margin = 0.5 / numberOfComparisons;
+			double clampedWinRate = std::clamp(winRate, margin, 1.0 - margin);
+			return -400.0 * std::log10(1.0 / clampedWinRate - 1.0);
+		}
+
+		// Method `playGame` plays one game of a match and returns the seat that won, or 0 if no seat won within the maximum number of moves.
+		int playGame(int indexOfGame, WrapperOfNeuralNetwork& candidate, WrapperOfNeuralNetwork& best) const {
+			const int seatOfCandidate = getSeatOfCandidate(indexOfGame);
+			Random::Xoshiro256PlusPlus generatorOfDice(Random::deriveSeed(seed, Random::Purpose::Arena, static_cast<uint64_t>(indexOfGame / NUMBER_OF_SEATS_OF_ARENA)));
+			constexpr double dirichletMixingWeight = 0.0;
+			constexpr double dirichletShape = 1.0;
+			GameState gameState;
+			int numberOfMovesPlayed = 0;
+			while (gameState.phase != Game::Phase::Done && numberOfMovesPlayed < MAXIMUM_NUMBER_OF_MOVES) {
+				if (gameState.phase == Game::Phase::RollDice) {
+					gameState.rollDice(generatorOfDice);
+					gameState.updatePhase();
+					continue;
+				}
+				int currentPlayer = gameState.currentPlayer;
+				WrapperOfNeuralNetwork& neuralNet = (currentPlayer == seatOfCandidate) ? candidate : best;
+				SearchResult searchResult = runMcts(
+					gameState,
+					neuralNet,
+					numberOfSimulations,
+					cPuct,
+					tolerance,
+					dirichletMixingWeight,
+					dirichletShape
+				);
+				if (searchResult.move.empty()) {
+					throw std::runtime_error("[ARENA] MCTS did not return a valid move.");
+				}
+				applyMoveOfSearch(gameState, currentPlayer, searchResult.move, searchResult.moveType);
+				numberOfMovesPlayed++;
+			}
+			return (gameState.phase == Game::Phase::Done) ? gameState.winner : 0;
+		}
+	};
+
+}
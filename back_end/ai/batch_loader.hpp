@@ -0,0 +1,170 @@
+#pragma once
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include "packed_training_examples.hpp"
+#include <random>
+#include "../random.hpp"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace AI {
+
+	/* Structure `MiniBatch` holds contiguous rows of features, values, and policies of examples gathered in shuffled order,
+	* with the widths of rows of the packed examples they were gathered from.
+	*/
+	struct MiniBatch {
+		int indexOfEpoch{ 0 };
+		int64_t numberOfExamples{ 0 };
+		int64_t numberOfFeatures{ 0 };
+		int64_t numberOfPolicyTargets{ 0 };
+		std::vector<uint8_t> features;
+		std::vector<float> values;
+		std::vector<float> policies;
+	};
+
+	/* Class `BatchLoader` shuffles packed training examples once per epoch and gathers mini batches on a background thread,
+	* so that the next mini batch is assembled while the current one trains.
+	* At most `NUMBER_OF_PREFETCHED_BATCHES` assembled batches wait to be taken, so the loader runs ahead by at most
+	* `NUMBER_OF_PREFETCHED_BATCHES` batches, plus the one it is assembling, and memory for batches stays bounded.
+	*/
+	class BatchLoader {
+	public:
+
+		static constexpr size_t NUMBER_OF_PREFETCHED_BATCHES = 2;
+
+		BatchLoader(const PackedTrainingExamples& packedTrainingExamplesToUse, int batchSizeToUse, int numberOfEpochsToUse, uint64_t seed) :
+			packedTrainingExamples(packedTrainingExamplesToUse),
+			batchSize(batchSizeToUse),
+			numberOfEpochs(numberOfEpochsToUse),
+			randomEngine(seed)
+		{
+			if (batchSize < 1) {
+				throw std::invalid_argument("A batch loader requires a positive batch size.");
+			}
+			thread = std::jthread([this](std::stop_token stopToken) {
+				load(stopToken);
+			});
+		}
+
+		~BatchLoader() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				thread.request_stop();
+			}
+			conditionVariable.notify_all();
+		}
+
+		BatchLoader(const BatchLoader&) = delete;
+		BatchLoader& operator=(const BatchLoader&) = delete;
+
+		/* Method `next` waits for the next mini batch and returns nothing after the last mini batch of the last epoch.
+		* If gathering mini batches threw, `next` rethrows that exception instead.
+		*/
+		std::optional<MiniBatch> next() {
+			std::unique_lock<std::mutex> lock(mutex);
+			conditionVariable.wait(lock, [this] { return !queueOfBatches.empty() || loadingIsFinished; });
+			if (exceptionOfLoading) {
+				std::rethrow_exception(exceptionOfLoading);
+			}
+			if (queueOfBatches.empty()) {
+				return std::nullopt;
+			}
+			MiniBatch miniBatch = std::move(queueOfBatches.front());
+			queueOfBatches.pop_front();
+			lock.unlock();
+			conditionVariable.notify_all();
+			return miniBatch;
+		}
+
+	private:
+		const PackedTrainingExamples& packedTrainingExamples;
+		int batchSize;
+		int numberOfEpochs;
+		Random::Xoshiro256PlusPlus randomEngine;
+		std::mutex mutex;
+		std::condition_variable conditionVariable;
+		std::deque<MiniBatch> queueOfBatches;
+		bool loadingIsFinished = false;
+		std::exception_ptr exceptionOfLoading;
+		std::jthread thread;
+
+		/* Method `load` runs on the background thread and gathers mini batches.
+		* An exception is stored for `next` to rethrow, since one escaping the thread would terminate the program
+		* and one swallowed would leave `next` waiting forever.
+		*/
+		void load(std::stop_token stopToken) {
+			std::exception_ptr exception;
+			try {
+				gatherMiniBatches(stopToken);
+			}
+			catch (...) {
+				exception = std::current_exception();
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				exceptionOfLoading = exception;
+				loadingIsFinished = true;
+			}
+			conditionVariable.notify_all();
+		}
+
+		void gatherMiniBatches(std::stop_token stopToken) {
+			const int64_t numberOfFeatures = packedTrainingExamples.numberOfFeatures;
+			const int64_t numberOfPolicyTargets = packedTrainingExamples.numberOfPolicyTargets;
+			int64_t numberOfExamples = packedTrainingExamples.numberOfExamples;
+			std::vector<int64_t> vectorOfIndicesOfExamples(numberOfExamples);
+			std::iota(vectorOfIndicesOfExamples.begin(), vectorOfIndicesOfExamples.end(), int64_t{ 0 });
+			for (int indexOfEpoch = 0; indexOfEpoch < numberOfEpochs && !stopToken.stop_requested(); indexOfEpoch++) {
+				std::shuffle(vectorOfIndicesOfExamples.begin(), vectorOfIndicesOfExamples.end(), randomEngine);
+				for (int64_t indexOfFirstExample = 0; indexOfFirstExample < numberOfExamples; indexOfFirstExample += batchSize) {
+					int64_t numberOfExamplesInBatch = std::min<int64_t>(batchSize, numberOfExamples - indexOfFirstExample);
+					MiniBatch miniBatch;
+					miniBatch.indexOfEpoch = indexOfEpoch;
+					miniBatch.numberOfExamples = numberOfExamplesInBatch;
+					miniBatch.numberOfFeatures = numberOfFeatures;
+					miniBatch.numberOfPolicyTargets = numberOfPolicyTargets;
+					miniBatch.features.resize(numberOfExamplesInBatch * numberOfFeatures);
+					miniBatch.values.resize(numberOfExamplesInBatch);
+					miniBatch.policies.resize(numberOfExamplesInBatch * numberOfPolicyTargets);
+					for (int64_t i = 0; i < numberOfExamplesInBatch; i++) {
+						int64_t indexOfExample = vectorOfIndicesOfExamples[indexOfFirstExample + i];
+						std::memcpy(
+							miniBatch.features.data() + i * numberOfFeatures,
+							packedTrainingExamples.features.data() + indexOfExample * numberOfFeatures,
+							numberOfFeatures
+						);
+						miniBatch.values[i] = packedTrainingExamples.values[indexOfExample];
+						std::memcpy(
+							miniBatch.policies.data() + i * numberOfPolicyTargets,
+							packedTrainingExamples.policies.data() + indexOfExample * numberOfPolicyTargets,
+							numberOfPolicyTargets * sizeof(float)
+						);
+					}
+
+					std::unique_lock<std::mutex> lock(mutex);
+					conditionVariable.wait(lock, [this, &stopToken] {
+						return queueOfBatches.size() < NUMBER_OF_PREFETCHED_BATCHES || stopToken.stop_requested();
+					});
+					if (stopToken.stop_requested()) {
+						break;
+					}
+					queueOfBatches.push_back(std::move(miniBatch));
+					lock.unlock();
+					conditionVariable.notify_all();
+				}
+			}
+		}
+	};
+
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstdio>
+#include <crow/json.h>
+#include <filesystem>
+#include <fstream>
+#include "../json_writer.hpp"
+#include "../logger.hpp"
+#include <mutex>
+#include "neural_network.hpp"
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace AI {
+
+	// Structure `Checkpoint` locates the files of parameters of a model and of state of its optimizer saved together.
+	struct Checkpoint {
+		long long number{ 0 };
+		std::string pathToParameters;
+		std::string pathToStateOfOptimizer;
+	};
+
+	/* Class `CheckpointManager` saves parameters of a model and state of its optimizer as numbered checkpoints in a directory,
+	* keeps the newest checkpoints and the best checkpoint, and records them in `manifest.json`.
+	* The best checkpoint is the last checkpoint promoted by the arena, and it is never deleted while it is the best.
+	* Every file is written to a temporary file and renamed into place, and the manifest is replaced only after
+	* both files of a checkpoint are complete, so a reader that follows the manifest never sees a partial checkpoint.
+	*/
+	class CheckpointManager {
+	public:
+
+		CheckpointManager(const std::string& pathToDirectoryToUse, int numberOfCheckpointsToKeepToUse) :
+			pathToDirectory(pathToDirectoryToUse),
+			numberOfCheckpointsToKeep(std::max(1, numberOfCheckpointsToKeepToUse))
+		{
+			std::filesystem::create_directories(pathToDirectory);
+			readManifest();
+			if (!vectorOfNumbersOfCheckpoints.empty()) {
+				Logger::info("[CHECKPOINTS] Found " + std::to_string(vectorOfNumbersOfCheckpoints.size()) + " checkpoints in " + pathToDirectory + "; the latest is " + std::to_string(vectorOfNumbersOfCheckpoints.back()) + ".");
+			}
+		}
+
+		CheckpointManager(const CheckpointManager&) = delete;
+		CheckpointManager& operator=(const CheckpointManager&) = delete;
+
+		// Method `getLatestCheckpoint` returns the newest complete checkpoint, if any.
+		std::optional<Checkpoint> getLatestCheckpoint() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (vectorOfNumbersOfCheckpoints.empty()) {
+				return std::nullopt;
+			}
+			return makeCheckpoint(vectorOfNumbersOfCheckpoints.back());
+		}
+
+		// Method `getBestCheckpoint` returns the checkpoint most recently marked as best, if any.
+		std::optional<Checkpoint> getBestCheckpoint() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (numberOfBestCheckpoint == 0) {
+				return std::nullopt;
+			}
+			return makeCheckpoint(numberOfBestCheckpoint);
+		}
+
+		// Method `markCheckpointAsBest` records a checkpoint as the best in the manifest.
+		void markCheckpointAsBest(const Checkpoint& checkpoint) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (std::find(vectorOfNumbersOfCheckpoints.begin(), vectorOfNumbersOfCheckpoints.end(), checkpoint.number) == vectorOfNumbersOfCheckpoints.end()) {
+				throw std::invalid_argument("Checkpoint " + std::to_string(checkpoint.number) + " is not kept and cannot be marked as best.");
+			}
+			numberOfBestCheckpoint = checkpoint.number;
+			writeManifest();
+			Logger::info("[CHECKPOINTS] Checkpoint " + std::to_string(checkpoint.number) + " was marked as best.");
+		}
+
+		/* Method `saveCheckpoint` saves the parameters and buffers of a network and the state of its optimizer as the next checkpoint,
+		* records it in the manifest, and deletes checkpoints beyond the newest `numberOfCheckpointsToKeep` other than the best checkpoint.
+		*/
+		Checkpoint saveCheckpoint(const NeuralNetwork& neuralNetwork, const torch::optim::Optimizer& optimizer) {
+			std::lock_guard<std::mutex> lock(mutex);
+			long long number = vectorOfNumbersOfCheckpoints.empty() ? 1 : vectorOfNumbersOfCheckpoints.back() + 1;
+			Checkpoint checkpoint = makeCheckpoint(number);
+			std::vector<torch::Tensor> vectorOfTensorsOfState = getTensorsOfState(neuralNetwork);
+			saveAtomically(checkpoint.pathToParameters, [&](const std::string& pathToTemporaryFile) {
+				torch::save(vectorOfTensorsOfState, pathToTemporaryFile);
+			});
+			saveAtomically(checkpoint.pathToStateOfOptimizer, [&](const std::string& pathToTemporaryFile) {
+				torch::serialize::OutputArchive outputArchive;
+				optimizer.save(outputArchive);
+				outputArchive.save_to(pathToTemporaryFile);
+			});
+			vectorOfNumbersOfCheckpoints.push_back(number);
+			std::vector<long long> vectorOfNumbersOfCheckpointsToKeep;
+			std::vector<long long> vectorOfNumbersOfCheckpointsToDelete;
+			const size_t indexOfFirstCheckpointToKeep = vectorOfNumbersOfCheckpoints.size() - std::min(vectorOfNumbersOfCheckpoints.size(), static_cast<size_t>(numberOfCheckpointsToKeep));
+			for (size_t i = 0; i < vectorOfNumbersOfCheckpoints.size(); i++) {
+				if (i >= indexOfFirstCheckpointToKeep || vectorOfNumbersOfCheckpoints[i] == numberOfBestCheckpoint) {
+					vectorOfNumbersOfCheckpointsToKeep.push_back(vectorOfNumbersOfCheckpoints[i]);
+				}
+				else {
+					vectorOfNumbersOfCheckpointsToDelete.push_back(vectorOfNumbersOfCheckpoints[i]);
+				}
+			}
+			vectorOfNumbersOfCheckpoints = std::move(vectorOfNumbersOfCheckpointsToKeep);
+			writeManifest();
+			for (long long numberOfCheckpointToDelete : vectorOfNumbersOfCheckpointsToDelete) {
+				Checkpoint checkpointToDelete = makeCheckpoint(numberOfCheckpointToDelete);
+				std::error_code errorCode;
+				std::filesystem::remove(checkpointToDelete.pathToParameters, errorCode);
+				std::filesystem::remove(checkpointToDelete.pathToStateOfOptimizer, errorCode);
+			}
+			Logger::info("[CHECKPOINTS] Checkpoint " + std::to_string(number) + " was saved.");
+			return checkpoint;
+		}
+
+		// Method `loadStateOfOptimizer` restores the state of an optimizer from a checkpoint.
+		static void loadStateOfOptimizer(const Checkpoint& checkpoint, torch::optim::Optimizer& optimizer) {
+			torch::serialize::InputArchive inputArchive;
+			inputArchive.load_from(checkpoint.pathToStateOfOptimizer);
+			optimizer.load(inputArchive);
+		}
+
+	private:
+		std::string pathToDirectory;
+		int numberOfCheckpointsToKeep;
+		mutable std::mutex mutex;
+		std::vector<long long> vectorOfNumbersOfCheckpoints;
+		long long numberOfBestCheckpoint{ 0 };
+
+		std::string getPathToManifest() const {
+			return (std::filesystem::path(pathToDirectory) / "manifest.json").string();
+		}
+
+		Checkpoint makeCheckpoint(long long number) const {
+			char nameOfParameters[64];
+			char nameOfStateOfOptimizer[64];
+			std::snprintf(nameOfParameters, sizeof(nameOfParameters), "model_%08lld.pt", number);
+			std::snprintf(nameOfStateOfOptimizer, sizeof(nameOfStateOfOptimizer), "optimizer_%08lld.pt", number);
+			return Checkpoint{
+				number,
+				(std::filesystem::path(pathToDirectory) / nameOfParameters).string(),
+				(std::filesystem::path(pathToDirectory) / nameOfStateOfOptimizer).string()
+			};
+		}
+
+		/* Method `readManifest` reads the numbers of checkpoints and the number of the best checkpoint from the manifest.
+		* Checkpoints whose files are missing are skipped, and an unreadable manifest is treated as empty.
+		*/
+		void readManifest() {
+			vectorOfNumbersOfCheckpoints.clear();
+			numberOfBestCheckpoint = 0;
+			std::ifstream file(getPathToManifest());
+			if (!file.is_open()) {
+				return;
+			}
+			std::stringstream buffer;
+			buffer << file.rdbuf();
+			crow::json::rvalue manifest = crow::json::load(buffer.str());
+			if (!manifest || !manifest.has("checkpoints")) {
+				Logger::warn("CheckpointManager", "Manifest " + getPathToManifest() + " could not be parsed and was ignored.");
+				return;
+			}
+			for (const crow::json::rvalue& number : manifest["checkpoints"]) {
+				Checkpoint checkpoint = makeCheckpoint(number.i());
+				if (std::filesystem::exists(checkpoint.pathToParameters) && std::filesystem::exists(checkpoint.pathToStateOfOptimizer)) {
+					vectorOfNumbersOfCheckpoints.push_back(checkpoint.number);
+				}
+			}
+			std::sort(vectorOfNumbersOfCheckpoints.begin(), vectorOfNumbersOfCheckpoints.end());
+			if (manifest.has("best")) {
+				long long number = manifest["best"].i();
+				if (std::find(vectorOfNumbersOfCheckpoints.begin(), vectorOfNumbersOfCheckpoints.end(), number) != vectorOfNumbersOfCheckpoints.end()) {
+					numberOfBestCheckpoint = number;
+				}
+			}
+		}
+
+		void writeManifest() const {
+			Json::JsonWriter jsonWriter;
+			jsonWriter.beginObject();
+			jsonWriter.key("latest").value(vectorOfNumbersOfCheckpoints.back());
+			if (numberOfBestCheckpoint != 0) {
+				jsonWriter.key("best").value(numberOfBestCheckpoint);
+			}
+			jsonWriter.key("checkpoints").beginArray();
+			for (long long number : vectorOfNumbersOfCheckpoints) {
+				jsonWriter.value(number);
+			}
+			jsonWriter.endArray();
+			jsonWriter.endObject();
+			std::string contents = jsonWriter.str();
+			saveAtomically(getPathToManifest(), [&](const std::string& pathToTemporaryFile) {
+				std::ofstream file(pathToTemporaryFile, std::ios::binary | std::ios::trunc);
+				file << contents;
+				if (!file) {
+					throw std::runtime_error("Manifest " + pathToTemporaryFile + " could not be written.");
+				}
+			});
+		}
+	};
+
+}
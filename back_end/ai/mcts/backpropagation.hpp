@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include "chance.hpp"
 #include "node.hpp"
 
 
@@ -8,12 +9,16 @@ namespace AI {
 	namespace MCTS {
 
 		// Backpropagate the rollout value up the tree.
+		// A chance node whose sums have been visited takes the expectimax value of its sums instead of the average of the values through it.
 		// TODO: Consider adding discount factors or more advanced statistics.
 		void backpropagate(MCTSNode* node, double value) {
 			while (node != nullptr) {
 				node->visitCount += 1;
 				node->totalValue += value;
 				node->averageValue = node->totalValue / node->visitCount;
+				if (isChanceNode(node) && !node->isLeaf()) {
+					node->averageValue = getExpectedValueOfChanceNode(node);
+				}
 				node = node->parent;
 			}
 		}
@@ -0,0 +1,93 @@
+#pragma once
+
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "node.hpp"
+#include <stdexcept>
+#include <string>
+
+
+namespace AI {
+	namespace MCTS {
+
+		/* A node whose game state is in phase `RollDice` is a chance node.
+		* Its children are the 11 sums of the production dice, each reached with the probability of its sum, rather than moves chosen by a player.
+		* Only the sum affects `collectResources`, so each sum is applied with one representative pair of faces, and
+		* the white event die, which no rule of the game state reads, is not branched on.
+		*/
+		const std::string MOVE_TYPE_OF_ROLL = "roll";
+		constexpr int MINIMUM_SUM_OF_DICE = 2;
+		constexpr int MAXIMUM_SUM_OF_DICE = 12;
+
+		double getProbabilityOfSumOfDice(int sumOfDice) {
+			if (sumOfDice < MINIMUM_SUM_OF_DICE || sumOfDice > MAXIMUM_SUM_OF_DICE) {
+				return 0.0;
+			}
+			return (6 - std::abs(sumOfDice - 7)) / 36.0;
+		}
+
+		std::string formatMoveOfRoll(int sumOfDice) {
+			return MOVE_TYPE_OF_ROLL + " " + std::to_string(sumOfDice);
+		}
+
+		bool isChanceNode(const MCTSNode* node) {
+			return node->gameState.phase == Game::Phase::RollDice;
+		}
+
+		/* Function `expandChanceNode` creates a child for each sum of the dice whose prior probability is the probability of the sum.
+		* The game state of a child has the sum applied with faces `sum / 2` and `sum - sum / 2`, its resources collected, and its phase advanced to the turn.
+		*/
+		void expandChanceNode(MCTSNode* node) {
+			for (int sumOfDice = MINIMUM_SUM_OF_DICE; sumOfDice <= MAXIMUM_SUM_OF_DICE; sumOfDice++) {
+				std::string move = formatMoveOfRoll(sumOfDice);
+				if (node->unorderedMapOfMovesToChildren.contains(move)) {
+					continue;
+				}
+				std::unique_ptr<MCTSNode> child = std::make_unique<MCTSNode>(node->gameState, move, node, MOVE_TYPE_OF_ROLL);
+				int redProductionDie = sumOfDice / 2;
+				child->gameState.applyRollOfDice(redProductionDie, sumOfDice - redProductionDie, "");
+				child->gameState.updatePhase();
+				child->priorProbability = getProbabilityOfSumOfDice(sumOfDice);
+				node->unorderedMapOfMovesToChildren[move] = std::move(child);
+			}
+		}
+
+		/* Function `selectOutcome` selects the sum of a chance node whose share of visits lags its probability the most.
+		* Visits of the children then follow the probabilities of the sums as closely as whole visits allow,
+		* which has the expectation of sampling the dice without its variance and without drawing random numbers.
+		*/
+		MCTSNode* selectOutcome(MCTSNode* node) {
+			MCTSNode* selectedChild = nullptr;
+			double largestDeficit = -std::numeric_limits<double>::infinity();
+			for (const auto& [move, child] : node->unorderedMapOfMovesToChildren) {
+				double deficit = child->priorProbability * (node->visitCount + 1) - child->visitCount;
+				if (deficit > largestDeficit || (deficit == largestDeficit && child->priorProbability > selectedChild->priorProbability)) {
+					largestDeficit = deficit;
+					selectedChild = child.get();
+				}
+			}
+			if (selectedChild == nullptr) {
+				throw std::runtime_error("No outcome of a chance node was selected during MCTS.");
+			}
+			return selectedChild;
+		}
+
+		/* Function `getExpectedValueOfChanceNode` returns the average of the values of the visited sums of a chance node
+		* weighted by their probabilities, which is the expectimax value of the node over the sums searched so far.
+		*/
+		double getExpectedValueOfChanceNode(const MCTSNode* node) {
+			double sumOfWeightedValues = 0.0;
+			double sumOfProbabilities = 0.0;
+			for (const auto& [move, child] : node->unorderedMapOfMovesToChildren) {
+				if (child->visitCount > 0) {
+					sumOfWeightedValues += child->priorProbability * child->averageValue;
+					sumOfProbabilities += child->priorProbability;
+				}
+			}
+			return (sumOfProbabilities > 0.0) ? sumOfWeightedValues / sumOfProbabilities : node->averageValue;
+		}
+
+	}
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 
+#include "../action_space.hpp"
 #include "../../game/board.hpp"
-#include "../../db/database.hpp"
+#include "chance.hpp"
+#include <cmath>
 #include "../neural_network.hpp"
 #include "node.hpp"
 
@@ -10,156 +12,84 @@
 namespace AI {
 	namespace MCTS {
 
-		/* Function `expandNode`, for each move determined to be available by board geometry and current state,
+		/* Function `expandNode`, for each legal move generated by the move generator of the game state of the node,
 		* creates a child node and sets its prior probability based on the move type.
+		* A network with a scalar policy head scores each child separately. A network with an actions head evaluates the state of the node once,
+		* and the priors of the children are a softmax of the logits of their actions.
+		* A chance node is expanded into the sums of the dice without evaluating the network.
 		*/
 		void expandNode(MCTSNode* node, WrapperOfNeuralNetwork& neuralNet) {
-			Board board;
-			std::vector<std::string> vectorOfLabelsOfAvailableVerticesOrEdges;
-			GameState gameState = node->gameState;
-			Game::Phase phase = gameState.phase;
-
-			if (phase == Game::Phase::FirstSettlement) {
-				std::vector<std::string> vectorOfLabelsOfOccupiedVertices = board.getVectorOfLabelsOfOccupiedVertices(gameState);
-				vectorOfLabelsOfAvailableVerticesOrEdges = board.getVectorOfLabelsOfAvailableVertices(vectorOfLabelsOfOccupiedVertices);
-			}
-			else if (phase == Game::Phase::FirstRoad || phase == Game::Phase::SecondRoad) {
-				std::vector<std::string> vectorOfLabelsOfOccupiedEdges = board.getVectorOfLabelsOfOccupiedEdges(gameState);
-				vectorOfLabelsOfAvailableVerticesOrEdges = board.getVectorOfLabelsOfAvailableEdgesExtendingFromLastBuilding(node->gameState.lastBuilding, vectorOfLabelsOfOccupiedEdges);
-			}
-			else if (phase == Game::Phase::FirstCity) {
-				std::vector<std::string> vectorOfLabelsOfOccupiedVertices = board.getVectorOfLabelsOfOccupiedVertices(gameState);
-				vectorOfLabelsOfAvailableVerticesOrEdges = board.getVectorOfLabelsOfAvailableVertices(vectorOfLabelsOfOccupiedVertices);
-			}
-			else if (phase == Game::Phase::Turn) {
-				const int currentPlayer = node->gameState.currentPlayer;
-				const ResourceBag& resources = node->gameState.resources[currentPlayer];
-
-				std::unordered_set<std::string> unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer;
-				const auto& labelsOfEdgesWithRoadsOfPlayer = node->gameState.roads.at(currentPlayer);
-				for (const std::string& labelOfEdgeWithRoadOfPlayer : labelsOfEdgesWithRoadsOfPlayer) {
-					auto verticesOfEdge = board.getVerticesOfEdge(labelOfEdgeWithRoadOfPlayer);
-					unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.insert(verticesOfEdge.first);
-					unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.insert(verticesOfEdge.second);
-				}
-
-				std::vector<std::string> vectorOfLabelsOfOccupiedVertices = board.getVectorOfLabelsOfOccupiedVertices(gameState);
-				std::vector<std::string> vectorOfLabelsOfAvailableVertices = board.getVectorOfLabelsOfAvailableVertices(vectorOfLabelsOfOccupiedVertices);
-
-				for (const std::string& labelOfVertex : vectorOfLabelsOfAvailableVertices) {
-					if (unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(labelOfVertex)) {
-						if (resources.brick >= 1 && resources.grain >= 1 && resources.lumber >= 1 && resources.wool >= 1) {
-							vectorOfLabelsOfAvailableVerticesOrEdges.push_back(labelOfVertex);
-						}
-					}
-				}
-
-				std::vector<std::string> vectorOfLabelsOfOccupiedEdges = board.getVectorOfLabelsOfOccupiedEdges(gameState);
-				std::vector<std::string> vectorOfLabelsOfAvailableEdges = board.getVectorOfLabelsOfAvailableEdges(vectorOfLabelsOfOccupiedEdges);
-
-				for (const std::string& labelOfEdge : vectorOfLabelsOfAvailableEdges) {
-					auto verticesOfEdge = board.getVerticesOfEdge(labelOfEdge);
-					if (unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(verticesOfEdge.first) || unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(verticesOfEdge.second)) {
-						if (resources.brick >= 1 && resources.lumber >= 1) {
-							vectorOfLabelsOfAvailableVerticesOrEdges.push_back(labelOfEdge);
-						}
-					}
-				}
-
-				const std::vector<std::string>& vectorOfLabelsOfVerticesOfSettlementsOfPlayer = node->gameState.settlements.at(currentPlayer);
-				for (const std::string& labelOfVertex : vectorOfLabelsOfVerticesOfSettlementsOfPlayer) {
-					if (resources.grain >= 2 && resources.ore >= 3) {
-						vectorOfLabelsOfAvailableVerticesOrEdges.push_back(labelOfVertex);
-					}
-				}
-
-				const auto& cities = node->gameState.cities.at(currentPlayer);
-				const auto& walls = node->gameState.walls.at(currentPlayer);
-				for (const std::string& labelOfVertex : cities) {
-					bool alreadyHasWall = std::find(walls.begin(), walls.end(), labelOfVertex) != walls.end();
-					if (!alreadyHasWall && node->gameState.resources[currentPlayer].brick >= 2) {
-						vectorOfLabelsOfAvailableVerticesOrEdges.push_back(labelOfVertex);
-					}
-				}
-
-				vectorOfLabelsOfAvailableVerticesOrEdges.push_back("pass");
+			if (isChanceNode(node)) {
+				expandChanceNode(node);
+				return;
 			}
+			Board board(node->gameState.precomputedBoardLayout);
+			std::vector<Game::Move> vectorOfLegalMoves = node->gameState.getVectorOfLegalMoves();
 
-			// Create a child for each label of available vertex or edge.
+			// Create a child for each legal move.
 			std::vector<std::vector<float>> vectorOfFeatureVectors;
 			std::vector<MCTSNode*> vectorOfChildren;
-			for (const std::string& labelOfAvailableVertexOrEdge : vectorOfLabelsOfAvailableVerticesOrEdges) {
-				if (node->unorderedMapOfMovesToChildren.find(labelOfAvailableVertexOrEdge) != node->unorderedMapOfMovesToChildren.end()) {
+			vectorOfChildren.reserve(vectorOfLegalMoves.size());
+			if (neuralNet.getPolicyHead() == PolicyHead::Scalar) {
+				vectorOfFeatureVectors.reserve(vectorOfLegalMoves.size());
+			}
+			for (const Game::Move& legalMove : vectorOfLegalMoves) {
+				if (node->unorderedMapOfMovesToChildren.find(legalMove.label) != node->unorderedMapOfMovesToChildren.end()) {
 					continue;
 				}
-				GameState gameStateOfChild = node->gameState;
-				std::string moveType;
-
-				if (labelOfAvailableVertexOrEdge == "pass") {
-					gameStateOfChild.updatePhase();
-					moveType = "pass";
-				}
-				else {
-					int currentPlayer = gameStateOfChild.currentPlayer;
-					if (phase == Game::Phase::FirstSettlement) {
-						gameStateOfChild.placeSettlement(currentPlayer, labelOfAvailableVertexOrEdge);
-						moveType = "settlement";
-					}
-					else if (phase == Game::Phase::FirstRoad || phase == Game::Phase::SecondRoad) {
-						gameStateOfChild.placeRoad(currentPlayer, labelOfAvailableVertexOrEdge);
-						moveType = "road";
-					}
-					else if (phase == Game::Phase::FirstCity) {
-						gameStateOfChild.placeCity(currentPlayer, labelOfAvailableVertexOrEdge);
-						moveType = "city";
-					}
-					else if (phase == Game::Phase::Turn) {
-						if (board.isLabelOfVertex(labelOfAvailableVertexOrEdge)) {
-							const auto& cities = gameStateOfChild.cities.at(currentPlayer);
-							bool hasCity = std::find(cities.begin(), cities.end(), labelOfAvailableVertexOrEdge) != cities.end();
-							if (hasCity && gameStateOfChild.resources[currentPlayer].brick >= 2) {
-								gameStateOfChild.placeCityWall(currentPlayer, labelOfAvailableVertexOrEdge);
-								moveType = "wall";
-							}
-							else {
-								const std::vector<std::string>& vectorOfLabelsOfVerticesOfSettlementsOfPlayer = gameStateOfChild.settlements.at(currentPlayer);
-								bool hadSettlement = std::find(
-									vectorOfLabelsOfVerticesOfSettlementsOfPlayer.begin(),
-									vectorOfLabelsOfVerticesOfSettlementsOfPlayer.end(),
-									labelOfAvailableVertexOrEdge
-								) != vectorOfLabelsOfVerticesOfSettlementsOfPlayer.end();
-								if (hadSettlement &&
-									gameStateOfChild.resources[currentPlayer].grain >= 2 &&
-									gameStateOfChild.resources[currentPlayer].ore >= 3
-									) {
-									gameStateOfChild.placeCity(currentPlayer, labelOfAvailableVertexOrEdge);
-									moveType = "city";
-								}
-								else {
-									gameStateOfChild.placeSettlement(currentPlayer, labelOfAvailableVertexOrEdge);
-									moveType = "settlement";
-								}
-							}
-						}
-						else if (board.isLabelOfEdge(labelOfAvailableVertexOrEdge)) {
-							gameStateOfChild.placeRoad(currentPlayer, labelOfAvailableVertexOrEdge);
-							moveType = "road";
-						}
-					}
-				}
+				const std::string& moveType = legalMove.type;
+				// The child copies the game state of the node once and makes its move in place.
 				std::unique_ptr<AI::MCTS::MCTSNode> child = std::make_unique<MCTSNode>(
-					gameStateOfChild,
-					labelOfAvailableVertexOrEdge,
+					node->gameState,
+					legalMove.label,
 					node,
 					moveType
 				);
+				GameState& gameStateOfChild = child->gameState;
+				const int currentPlayer = gameStateOfChild.currentPlayer;
+				if (moveType == "pass") {
+					gameStateOfChild.updatePhase();
+				}
+				else if (moveType == "settlement") {
+					gameStateOfChild.placeSettlement(currentPlayer, legalMove.label);
+				}
+				else if (moveType == "city") {
+					gameStateOfChild.placeCity(currentPlayer, legalMove.label);
+				}
+				else if (moveType == "wall") {
+					gameStateOfChild.placeCityWall(currentPlayer, legalMove.label);
+				}
+				else {
+					gameStateOfChild.placeRoad(currentPlayer, legalMove.label);
+				}
 				MCTSNode* pointerToChild = child.get();
-				std::vector<float> featureVector = board.getGridRepresentationForMove(labelOfAvailableVertexOrEdge, moveType);
-				vectorOfFeatureVectors.push_back(featureVector);
+				if (neuralNet.getPolicyHead() == PolicyHead::Scalar) {
+					vectorOfFeatureVectors.push_back(board.getGridRepresentationForMove(legalMove.label, moveType));
+				}
 				vectorOfChildren.push_back(pointerToChild);
-				node->unorderedMapOfMovesToChildren[labelOfAvailableVertexOrEdge] = std::move(child);
+				node->unorderedMapOfMovesToChildren[legalMove.label] = std::move(child);
+			}
+			if (neuralNet.getPolicyHead() == PolicyHead::Actions) {
+				if (vectorOfChildren.empty()) {
+					return;
+				}
+				std::vector<float> vectorOfLogits = neuralNet.evaluateState(node->gameState, node->gameState.currentPlayer).second;
+				std::vector<double> vectorOfLogitsOfChildren;
+				vectorOfLogitsOfChildren.reserve(vectorOfChildren.size());
+				for (MCTSNode* child : vectorOfChildren) {
+					vectorOfLogitsOfChildren.push_back(vectorOfLogits[getIndexOfAction(child->move, child->moveType)]);
+				}
+				double maximumLogit = *std::max_element(vectorOfLogitsOfChildren.begin(), vectorOfLogitsOfChildren.end());
+				double sumOfExponentials = 0.0;
+				for (double& logit : vectorOfLogitsOfChildren) {
+					logit = std::exp(logit - maximumLogit);
+					sumOfExponentials += logit;
+				}
+				for (size_t i = 0; i < vectorOfChildren.size(); i++) {
+					vectorOfChildren[i]->priorProbability = vectorOfLogitsOfChildren[i] / sumOfExponentials;
+				}
 			}
-			if (!vectorOfFeatureVectors.empty()) {
+			else if (!vectorOfFeatureVectors.empty()) {
 				std::vector<std::pair<double, double>> vectorOfPairsOfValuesAndPolicies = neuralNet.evaluateStructures(vectorOfFeatureVectors);
 				size_t i = 0;
 				for (const auto& [value, policy] : vectorOfPairsOfValuesAndPolicies) {
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <memory>
 #include "../../game/game_state.hpp"
+#include "../../json_writer.hpp"
 
 
 namespace AI {
@@ -15,7 +16,8 @@ namespace AI {
         // A child node represents a game state reached by making a specified move of a specified type.
         class MCTSNode {
         public:
-            inline static int nextIndex = 0;
+            // Indices only label nodes for debugging, and each thread numbers the nodes of its own searches.
+            inline static thread_local int nextIndex = 0;
             int index;
             GameState gameState;
             std::string move;
@@ -50,25 +52,26 @@ namespace AI {
                 return unorderedMapOfMovesToChildren.empty();
             }
 
-            crow::json::wvalue toJson() const {
-                crow::json::wvalue json;
-                json["index"] = index;
-                json["gameState"] = gameState.toJson();
-                json["move"] = move;
-                json["moveType"] = moveType;
-                json["visitCount"] = visitCount;
-                json["totalValue"] = totalValue;
-                json["averageValue"] = averageValue;
-                json["priorProbability"] = priorProbability;
-
-                crow::json::wvalue jsonArrayOfChildren(crow::json::type::List);
-                int i = 0;
+            std::string toJson() const {
+                Json::JsonWriter writer;
+                writer.beginObject();
+                writer.key("index").value(index);
+                writer.key("gameState");
+                gameState.writeJson(writer);
+                writer.key("move").value(move);
+                writer.key("moveType").value(moveType);
+                writer.key("visitCount").value(visitCount);
+                writer.key("totalValue").value(totalValue);
+                writer.key("averageValue").value(averageValue);
+                writer.key("priorProbability").value(priorProbability);
+                writer.key("children").beginArray();
 				for (const auto& [representationOfMove, child] : unorderedMapOfMovesToChildren) {
-					jsonArrayOfChildren[i++] = child->index;
+					writer.value(child->index);
 				}
-                json["children"] = std::move(jsonArrayOfChildren);
-				json["parent"] = parent ? std::to_string(parent->index) : "null";
-                return json;
+                writer.endArray();
+                writer.key("parent").value(parent ? std::to_string(parent->index) : "null");
+                writer.endObject();
+                return writer.str();
             }
         };
 
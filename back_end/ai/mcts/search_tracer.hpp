@@ -0,0 +1,321 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "../../json_writer.hpp"
+#include <map>
+#include "node.hpp"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace AI {
+	namespace MCTS {
+
+		constexpr uint32_t VERSION_OF_FORMAT_OF_SEARCH_TRACE = 1;
+
+		/* Structure `TracedSimulation` is the binary record of one sampled simulation.
+		* Times are nanoseconds from the start of the search. The path from the root to the selected leaf is stored as
+		* `depth` identifiers of moves in `SearchTrace::vectorOfIdentifiersOfMovesOfPaths` starting at `indexOfFirstStepOfPath`.
+		* `widthOfExpansion` is the number of children created at the leaf, which is 0 if the leaf was expanded before or is terminal.
+		*/
+		struct TracedSimulation {
+			uint32_t indexOfSimulation;
+			uint32_t indexOfFirstStepOfPath;
+			uint16_t depth;
+			uint16_t widthOfExpansion;
+			float value;
+			int64_t timeOfStart;
+			int64_t durationOfSelection;
+			int64_t durationOfExpansion;
+			int64_t durationOfEvaluation;
+			int64_t durationOfBackpropagation;
+		};
+		static_assert(std::is_trivially_copyable_v<TracedSimulation> && sizeof(TracedSimulation) == 56, "A traced simulation is written to files as raw bytes.");
+
+		/* Structure `SearchTrace` holds the sampled simulations of one search.
+		* Moves of paths are interned, so a step of a path is a 16 bit identifier into `vectorOfMoves`.
+		*/
+		struct SearchTrace {
+			std::string moveTypeOfRoot;
+			uint32_t intervalOfSampling{ 1 };
+			uint32_t numberOfSimulations{ 0 };
+			uint32_t numberOfSimulationsNotRecorded{ 0 };
+			std::vector<std::string> vectorOfMoves;
+			std::vector<TracedSimulation> vectorOfSimulations;
+			std::vector<uint16_t> vectorOfIdentifiersOfMovesOfPaths;
+		};
+
+		/* Class `SearchTracer` records every `intervalOfSampling`-th simulation of a search into a `SearchTrace`.
+		* `runMcts` takes a pointer to a tracer that is null unless a caller asks for a trace, and
+		* reads the clock only for sampled simulations, so a search without a tracer pays one untaken branch per phase of a simulation.
+		* Recording stops after `maximumNumberOfSimulations` records so that a long search cannot grow a trace without bound.
+		*/
+		class SearchTracer {
+		public:
+
+			// Type `TimesOfSimulation` holds the times at the start of a simulation and at the end of selection, expansion, evaluation, and backpropagation.
+			using TimesOfSimulation = std::array<std::chrono::steady_clock::time_point, 5>;
+
+			explicit SearchTracer(int intervalOfSamplingToUse, int maximumNumberOfSimulationsToUse = 65536) :
+				maximumNumberOfSimulations(static_cast<size_t>(std::max(1, maximumNumberOfSimulationsToUse)))
+			{
+				if (intervalOfSamplingToUse < 1) {
+					throw std::invalid_argument("The interval of sampling of a search tracer must be positive.");
+				}
+				searchTrace.intervalOfSampling = static_cast<uint32_t>(intervalOfSamplingToUse);
+			}
+
+			void beginSearch(const std::string& moveTypeOfRoot, std::chrono::steady_clock::time_point timeOfStart) {
+				searchTrace.moveTypeOfRoot = moveTypeOfRoot;
+				timeOfStartOfSearch = timeOfStart;
+			}
+
+			void endSearch(int numberOfSimulationsRun) {
+				searchTrace.numberOfSimulations = static_cast<uint32_t>(numberOfSimulationsRun);
+			}
+
+			bool isSampled(int indexOfSimulation) const {
+				return indexOfSimulation % static_cast<int>(searchTrace.intervalOfSampling) == 0;
+			}
+
+			/* Method `recordSimulation` records a sampled simulation whose selection ended at `leaf`.
+			* The path is recovered from the parents of the leaf, which backpropagation does not change.
+			*/
+			void recordSimulation(int indexOfSimulation, const MCTSNode* leaf, size_t widthOfExpansion, double value, const TimesOfSimulation& timesOfSimulation) {
+				if (searchTrace.vectorOfSimulations.size() >= maximumNumberOfSimulations) {
+					searchTrace.numberOfSimulationsNotRecorded++;
+					return;
+				}
+				const size_t indexOfFirstStepOfPath = searchTrace.vectorOfIdentifiersOfMovesOfPaths.size();
+				for (const MCTSNode* node = leaf; node != nullptr && node->parent != nullptr; node = node->parent) {
+					searchTrace.vectorOfIdentifiersOfMovesOfPaths.push_back(internMove(node->move));
+				}
+				std::reverse(searchTrace.vectorOfIdentifiersOfMovesOfPaths.begin() + indexOfFirstStepOfPath, searchTrace.vectorOfIdentifiersOfMovesOfPaths.end());
+
+				TracedSimulation tracedSimulation{};
+				tracedSimulation.indexOfSimulation = static_cast<uint32_t>(indexOfSimulation);
+				tracedSimulation.indexOfFirstStepOfPath = static_cast<uint32_t>(indexOfFirstStepOfPath);
+				tracedSimulation.depth = static_cast<uint16_t>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.size() - indexOfFirstStepOfPath);
+				tracedSimulation.widthOfExpansion = static_cast<uint16_t>(widthOfExpansion);
+				tracedSimulation.value = static_cast<float>(value);
+				tracedSimulation.timeOfStart = toNanoseconds(timesOfSimulation[0] - timeOfStartOfSearch);
+				tracedSimulation.durationOfSelection = toNanoseconds(timesOfSimulation[1] - timesOfSimulation[0]);
+				tracedSimulation.durationOfExpansion = toNanoseconds(timesOfSimulation[2] - timesOfSimulation[1]);
+				tracedSimulation.durationOfEvaluation = toNanoseconds(timesOfSimulation[3] - timesOfSimulation[2]);
+				tracedSimulation.durationOfBackpropagation = toNanoseconds(timesOfSimulation[4] - timesOfSimulation[3]);
+				searchTrace.vectorOfSimulations.push_back(tracedSimulation);
+			}
+
+			const SearchTrace& getTrace() const {
+				return searchTrace;
+			}
+
+		private:
+			size_t maximumNumberOfSimulations;
+			SearchTrace searchTrace;
+			std::chrono::steady_clock::time_point timeOfStartOfSearch;
+			std::unordered_map<std::string, uint16_t> unorderedMapOfMovesToIdentifiers;
+
+			static int64_t toNanoseconds(std::chrono::steady_clock::duration duration) {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+			}
+
+			uint16_t internMove(const std::string& move) {
+				auto [iterator, moveIsNew] = unorderedMapOfMovesToIdentifiers.try_emplace(move, static_cast<uint16_t>(searchTrace.vectorOfMoves.size()));
+				if (moveIsNew) {
+					searchTrace.vectorOfMoves.push_back(move);
+				}
+				return iterator->second;
+			}
+		};
+
+		/* Function `saveSearchTrace` writes a trace as magic "CTNT", a version, the type of move of the root, the interval of sampling,
+		* the numbers of simulations run and not recorded, the interned moves, the raw records of simulations, and the steps of paths.
+		* Numbers are written in the byte order of the machine, as are shards of the replay buffer.
+		*/
+		void saveSearchTrace(const SearchTrace& searchTrace, const std::string& path) {
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			auto writeNumber = [&file](uint32_t number) {
+				file.write(reinterpret_cast<const char*>(&number), sizeof(number));
+			};
+			auto writeString = [&file, &writeNumber](const std::string& string) {
+				writeNumber(static_cast<uint32_t>(string.size()));
+				file.write(string.data(), static_cast<std::streamsize>(string.size()));
+			};
+			file.write("CTNT", 4);
+			writeNumber(VERSION_OF_FORMAT_OF_SEARCH_TRACE);
+			writeString(searchTrace.moveTypeOfRoot);
+			writeNumber(searchTrace.intervalOfSampling);
+			writeNumber(searchTrace.numberOfSimulations);
+			writeNumber(searchTrace.numberOfSimulationsNotRecorded);
+			writeNumber(static_cast<uint32_t>(searchTrace.vectorOfMoves.size()));
+			for (const std::string& move : searchTrace.vectorOfMoves) {
+				writeString(move);
+			}
+			writeNumber(static_cast<uint32_t>(searchTrace.vectorOfSimulations.size()));
+			file.write(reinterpret_cast<const char*>(searchTrace.vectorOfSimulations.data()), static_cast<std::streamsize>(searchTrace.vectorOfSimulations.size() * sizeof(TracedSimulation)));
+			writeNumber(static_cast<uint32_t>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.size()));
+			file.write(reinterpret_cast<const char*>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.data()), static_cast<std::streamsize>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.size() * sizeof(uint16_t)));
+			if (!file) {
+				throw std::runtime_error("Search trace " + path + " could not be written.");
+			}
+		}
+
+		// Function `loadSearchTrace` reads a trace written by `saveSearchTrace` and throws if the file is not a complete trace of a known version.
+		SearchTrace loadSearchTrace(const std::string& path) {
+			std::ifstream file(path, std::ios::binary);
+			auto readNumber = [&file]() {
+				uint32_t number = 0;
+				file.read(reinterpret_cast<char*>(&number), sizeof(number));
+				return number;
+			};
+			auto readString = [&file, &readNumber]() {
+				std::string string(readNumber(), '\0');
+				file.read(string.data(), static_cast<std::streamsize>(string.size()));
+				return string;
+			};
+			char magic[4] = {};
+			file.read(magic, 4);
+			if (!file || std::memcmp(magic, "CTNT", 4) != 0 || readNumber() != VERSION_OF_FORMAT_OF_SEARCH_TRACE) {
+				throw std::runtime_error("File " + path + " is not a search trace of version " + std::to_string(VERSION_OF_FORMAT_OF_SEARCH_TRACE) + ".");
+			}
+			SearchTrace searchTrace;
+			searchTrace.moveTypeOfRoot = readString();
+			searchTrace.intervalOfSampling = readNumber();
+			searchTrace.numberOfSimulations = readNumber();
+			searchTrace.numberOfSimulationsNotRecorded = readNumber();
+			searchTrace.vectorOfMoves.resize(readNumber());
+			for (std::string& move : searchTrace.vectorOfMoves) {
+				move = readString();
+			}
+			searchTrace.vectorOfSimulations.resize(readNumber());
+			file.read(reinterpret_cast<char*>(searchTrace.vectorOfSimulations.data()), static_cast<std::streamsize>(searchTrace.vectorOfSimulations.size() * sizeof(TracedSimulation)));
+			searchTrace.vectorOfIdentifiersOfMovesOfPaths.resize(readNumber());
+			file.read(reinterpret_cast<char*>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.data()), static_cast<std::streamsize>(searchTrace.vectorOfIdentifiersOfMovesOfPaths.size() * sizeof(uint16_t)));
+			if (!file) {
+				throw std::runtime_error("Search trace " + path + " is truncated.");
+			}
+			for (const TracedSimulation& tracedSimulation : searchTrace.vectorOfSimulations) {
+				if (static_cast<size_t>(tracedSimulation.indexOfFirstStepOfPath) + tracedSimulation.depth > searchTrace.vectorOfIdentifiersOfMovesOfPaths.size()) {
+					throw std::runtime_error("Search trace " + path + " has a path outside its steps.");
+				}
+			}
+			for (uint16_t identifierOfMove : searchTrace.vectorOfIdentifiersOfMovesOfPaths) {
+				if (identifierOfMove >= searchTrace.vectorOfMoves.size()) {
+					throw std::runtime_error("Search trace " + path + " has a step with an unknown move.");
+				}
+			}
+			return searchTrace;
+		}
+
+		/* Function `exportChromeTrace` converts a trace into the JSON of the Trace Event Format, which chrome://tracing and Perfetto open.
+		* Each sampled simulation is a complete event with its depth, width of expansion, value, and path as arguments,
+		* and contains complete events for selection, expansion, evaluation, and backpropagation.
+		*/
+		std::string exportChromeTrace(const SearchTrace& searchTrace) {
+			Json::JsonWriter writer;
+			auto writeEvent = [&writer](const std::string& name, int64_t timeOfStart, int64_t duration) {
+				writer.key("name").value(name);
+				writer.key("cat").value("mcts");
+				writer.key("ph").value("X");
+				writer.key("ts").value(static_cast<double>(timeOfStart) / 1000.0);
+				writer.key("dur").value(static_cast<double>(duration) / 1000.0);
+				writer.key("pid").value(1);
+				writer.key("tid").value(1);
+			};
+			writer.beginObject();
+			writer.key("displayTimeUnit").value("ns");
+			writer.key("traceEvents").beginArray();
+			for (const TracedSimulation& tracedSimulation : searchTrace.vectorOfSimulations) {
+				const int64_t durationOfSimulation =
+					tracedSimulation.durationOfSelection + tracedSimulation.durationOfExpansion + tracedSimulation.durationOfEvaluation + tracedSimulation.durationOfBackpropagation;
+				std::string path;
+				for (uint16_t i = 0; i < tracedSimulation.depth; i++) {
+					if (i > 0) {
+						path += " > ";
+					}
+					path += searchTrace.vectorOfMoves[searchTrace.vectorOfIdentifiersOfMovesOfPaths[tracedSimulation.indexOfFirstStepOfPath + i]];
+				}
+				writer.beginObject();
+				writeEvent("simulation " + std::to_string(tracedSimulation.indexOfSimulation), tracedSimulation.timeOfStart, durationOfSimulation);
+				writer.key("args").beginObject();
+				writer.key("depth").value(static_cast<int>(tracedSimulation.depth));
+				writer.key("widthOfExpansion").value(static_cast<int>(tracedSimulation.widthOfExpansion));
+				writer.key("value").value(static_cast<double>(tracedSimulation.value));
+				writer.key("path").value(path);
+				writer.endObject();
+				writer.endObject();
+				int64_t timeOfStartOfPhase = tracedSimulation.timeOfStart;
+				const std::array<std::pair<const char*, int64_t>, 4> arrayOfPhases = { {
+					{ "selection", tracedSimulation.durationOfSelection },
+					{ "expansion", tracedSimulation.durationOfExpansion },
+					{ "evaluation", tracedSimulation.durationOfEvaluation },
+					{ "backpropagation", tracedSimulation.durationOfBackpropagation }
+				} };
+				for (const auto& [nameOfPhase, durationOfPhase] : arrayOfPhases) {
+					writer.beginObject();
+					writeEvent(nameOfPhase, timeOfStartOfPhase, durationOfPhase);
+					writer.endObject();
+					timeOfStartOfPhase += durationOfPhase;
+				}
+			}
+			writer.endArray();
+			writer.endObject();
+			return writer.str();
+		}
+
+		/* Function `exportTree` converts the paths of a trace into a compact tree of text with one line per node, indented by depth.
+		* A line holds the move, the number of sampled simulations that passed through the node, and the mean value of those simulations at their leaves.
+		* Children are ordered by number of simulations, so the lines read as the principal variations of the sample.
+		*/
+		std::string exportTree(const SearchTrace& searchTrace) {
+			struct NodeOfTree {
+				int numberOfSimulations = 0;
+				double sumOfValues = 0.0;
+				std::map<uint16_t, NodeOfTree> mapOfMovesToChildren;
+			};
+			NodeOfTree root;
+			for (const TracedSimulation& tracedSimulation : searchTrace.vectorOfSimulations) {
+				NodeOfTree* node = &root;
+				node->numberOfSimulations++;
+				node->sumOfValues += tracedSimulation.value;
+				for (uint16_t i = 0; i < tracedSimulation.depth; i++) {
+					node = &node->mapOfMovesToChildren[searchTrace.vectorOfIdentifiersOfMovesOfPaths[tracedSimulation.indexOfFirstStepOfPath + i]];
+					node->numberOfSimulations++;
+					node->sumOfValues += tracedSimulation.value;
+				}
+			}
+			std::string text =
+				"# " + std::to_string(searchTrace.vectorOfSimulations.size()) + " of " + std::to_string(searchTrace.numberOfSimulations) +
+				" simulations sampled every " + std::to_string(searchTrace.intervalOfSampling) + "\n";
+			auto writeNode = [&](auto& writeNodeRecursively, const NodeOfTree& node, const std::string& move, int depth) -> void {
+				char meanValue[32];
+				std::snprintf(meanValue, sizeof(meanValue), "%.3f", node.numberOfSimulations > 0 ? node.sumOfValues / node.numberOfSimulations : 0.0);
+				text += std::string(2 * depth, ' ') + move + " n=" + std::to_string(node.numberOfSimulations) + " v=" + meanValue + "\n";
+				std::vector<std::pair<uint16_t, const NodeOfTree*>> vectorOfChildren;
+				for (const auto& [identifierOfMove, child] : node.mapOfMovesToChildren) {
+					vectorOfChildren.emplace_back(identifierOfMove, &child);
+				}
+				std::stable_sort(vectorOfChildren.begin(), vectorOfChildren.end(), [](const auto& first, const auto& second) {
+					return first.second->numberOfSimulations > second.second->numberOfSimulations;
+				});
+				for (const auto& [identifierOfMove, child] : vectorOfChildren) {
+					writeNodeRecursively(writeNodeRecursively, *child, searchTrace.vectorOfMoves[identifierOfMove], depth + 1);
+				}
+			};
+			writeNode(writeNode, root, "root (" + searchTrace.moveTypeOfRoot + ")", 0);
+			return text;
+		}
+
+	}
+}
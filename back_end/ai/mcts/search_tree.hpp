@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include "chance.hpp"
+#include <memory>
+#include "node.hpp"
+#include <string>
+
+
+namespace AI {
+	namespace MCTS {
+
+		/* Class `SearchTree` keeps the tree of a search between moves of a game, so that the next search starts from
+		* the subtree of the move that was made and from the subtree of the sum of the dice that was rolled.
+		* A tree whose root does not match the game state of the next search is discarded.
+		*/
+		class SearchTree {
+		public:
+
+			/* Method `getRoot` returns the root for a search from a game state,
+			* which is the kept root if its phase and current player match the game state or a new root otherwise.
+			*/
+			MCTSNode* getRoot(const GameState& gameState, const std::string& moveTypeOfRoot) {
+				if (root == nullptr || root->gameState.phase != gameState.phase || root->gameState.currentPlayer != gameState.currentPlayer) {
+					root = std::make_unique<MCTSNode>(gameState, "", nullptr, moveTypeOfRoot);
+				}
+				return root.get();
+			}
+
+			// Method `advance` keeps the subtree of a move made from the root and discards the rest of the tree.
+			void advance(const std::string& move) {
+				if (root == nullptr) {
+					return;
+				}
+				auto iterator = root->unorderedMapOfMovesToChildren.find(move);
+				if (iterator == root->unorderedMapOfMovesToChildren.end()) {
+					root.reset();
+					return;
+				}
+				std::unique_ptr<MCTSNode> child = std::move(iterator->second);
+				child->parent = nullptr;
+				root = std::move(child);
+			}
+
+			/* Method `advanceThroughRoll` keeps the subtree of the sum of the dice rolled from a chance node at the root and
+			* gives the new root the game state after the roll, including the faces rolled.
+			*/
+			void advanceThroughRoll(const GameState& gameStateAfterRoll) {
+				if (root == nullptr || !isChanceNode(root.get())) {
+					root.reset();
+					return;
+				}
+				advance(formatMoveOfRoll(gameStateAfterRoll.redProductionDie + gameStateAfterRoll.yellowProductionDie));
+				if (root != nullptr) {
+					root->gameState = gameStateAfterRoll;
+				}
+			}
+
+			void reset() {
+				root.reset();
+			}
+
+		private:
+			std::unique_ptr<MCTSNode> root;
+		};
+
+	}
+}
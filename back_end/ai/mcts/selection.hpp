@@ -6,8 +6,9 @@ namespace AI {
 
 		// Function `selectChild` is a function that selects a best child using Predictor Upper Confidence bound applied to Trees.
 		MCTSNode* selectChild(MCTSNode* node, double cPuct, double tolerance) {
+			// Among children scoring within tolerance of the best score, the least visited child, then the child of highest prior, is selected.
 			double bestScore = -std::numeric_limits<double>::infinity();
-			std::vector<MCTSNode*> vectorOfBestCandidates;
+			MCTSNode* bestCandidate = nullptr;
 
 			for (const auto& [move, pointerToChild] : node->unorderedMapOfMovesToChildren) {
 				MCTSNode* child = pointerToChild.get();
@@ -16,25 +17,21 @@ namespace AI {
 				double score = child->averageValue + u;
 				if (score > bestScore + tolerance) {
 					bestScore = score;
-					vectorOfBestCandidates.clear();
-					vectorOfBestCandidates.push_back(child);
+					bestCandidate = child;
 				}
-				else if (std::abs(score - bestScore) <= tolerance) {
-					vectorOfBestCandidates.push_back(child);
+				else if (
+					std::abs(score - bestScore) <= tolerance &&
+					(
+						(child->visitCount < bestCandidate->visitCount) ||
+						(child->visitCount == bestCandidate->visitCount && child->priorProbability > bestCandidate->priorProbability)
+					)
+				) {
+					bestCandidate = child;
 				}
 			}
-			if (vectorOfBestCandidates.empty()) {
+			if (bestCandidate == nullptr) {
 				throw std::runtime_error("No best candidate was selected during MCTS.");
 			}
-			MCTSNode* bestCandidate = vectorOfBestCandidates[0];
-			for (MCTSNode* candidate : vectorOfBestCandidates) {
-				if (
-					(candidate->visitCount < bestCandidate->visitCount) ||
-					(candidate->visitCount == bestCandidate->visitCount && candidate->priorProbability > bestCandidate->priorProbability)
-				) {
-					bestCandidate = candidate;
-				}
-			}
 			return bestCandidate;
 		}
 
@@ -4,14 +4,22 @@
 namespace AI {
 	namespace MCTS {
 
-		// Function `rollout` uses the neural network to evaluate the leaf node.
+		/* Function `rollout` uses the neural network to evaluate the leaf node.
+		* A network with an actions head evaluates the state of the leaf from the perspective of the player who made the move of the leaf.
+		*/
 		/* TODO: Consider whether self playing a full game is sufficient to simulate multiple moves, or
 		* whether multiple moves should be simulated here using a simple multi-step loop with a max depth or using another technique.
 		*/
 		double rollout(MCTSNode* node, WrapperOfNeuralNetwork& neuralNet) {
-			Board board;
-			std::string move = node->move;
-			std::string moveType = node->moveType;
+			if (neuralNet.getPolicyHead() == PolicyHead::Actions) {
+				int playerWhoMadeMove = (node->parent != nullptr) ? node->parent->gameState.currentPlayer : node->gameState.currentPlayer;
+				return neuralNet.evaluateState(node->gameState, playerWhoMadeMove).first;
+			}
+			Board board(node->gameState.precomputedBoardLayout);
+			// The grid representation of a sum of the dice is the grid of the board, as for passing.
+			bool isSumOfDice = (node->moveType == MOVE_TYPE_OF_ROLL);
+			std::string move = isSumOfDice ? "pass" : node->move;
+			std::string moveType = isSumOfDice ? "pass" : node->moveType;
 			std::vector<float> featureVector = board.getGridRepresentationForMove(move, moveType);
 			std::vector<std::vector<float>> vectorOfFeatureVectors = { featureVector };
 			auto eval = neuralNet.evaluateStructures(vectorOfFeatureVectors)[0];
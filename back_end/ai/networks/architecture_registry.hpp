@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include <functional>
+#include <map>
+#include <memory>
+#include "multilayer_perceptron.hpp"
+#include <mutex>
+#include "network.hpp"
+#include "residual_cnn.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace AI {
+
+	using FactoryOfNeuralNetwork = std::function<NeuralNetwork(const SpecificationOfNeuralNetwork&)>;
+
+	/* Class `ArchitectureRegistry` maps names of architectures, which are selected with key "architecture" of `config.json`,
+	* to factories of networks. Architectures "mlp" and "residualCnn" are registered by default, and
+	* other architectures can be registered before networks are created.
+	*/
+	class ArchitectureRegistry {
+	public:
+
+		static void registerArchitecture(const std::string& nameOfArchitecture, FactoryOfNeuralNetwork factory) {
+			std::lock_guard<std::mutex> lock(getMutex());
+			getMapOfNamesAndFactories()[nameOfArchitecture] = std::move(factory);
+		}
+
+		static NeuralNetwork create(const SpecificationOfNeuralNetwork& specification) {
+			FactoryOfNeuralNetwork factory;
+			{
+				std::lock_guard<std::mutex> lock(getMutex());
+				auto iterator = getMapOfNamesAndFactories().find(specification.architecture);
+				if (iterator == getMapOfNamesAndFactories().end()) {
+					throw std::invalid_argument("Architecture " + specification.architecture + " is not registered.");
+				}
+				factory = iterator->second;
+			}
+			return factory(specification);
+		}
+
+		static std::vector<std::string> getNamesOfArchitectures() {
+			std::lock_guard<std::mutex> lock(getMutex());
+			std::vector<std::string> vectorOfNames;
+			for (const auto& [nameOfArchitecture, factory] : getMapOfNamesAndFactories()) {
+				vectorOfNames.push_back(nameOfArchitecture);
+			}
+			return vectorOfNames;
+		}
+
+	private:
+
+		static std::mutex& getMutex() {
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		static std::map<std::string, FactoryOfNeuralNetwork>& getMapOfNamesAndFactories() {
+			static std::map<std::string, FactoryOfNeuralNetwork> mapOfNamesAndFactories = {
+				{ "mlp", [](const SpecificationOfNeuralNetwork& specification) {
+					return NeuralNetwork(std::shared_ptr<NeuralNetworkImpl>(std::make_shared<MultilayerPerceptronImpl>(specification)));
+				} },
+				{ "residualCnn", [](const SpecificationOfNeuralNetwork& specification) {
+					return NeuralNetwork(std::shared_ptr<NeuralNetworkImpl>(std::make_shared<ResidualCnnImpl>(specification)));
+				} }
+			};
+			return mapOfNamesAndFactories;
+		}
+	};
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+
+#include "network.hpp"
+
+
+namespace AI {
+
+	/* `struct` `MultilayerPerceptronImpl` is a network of two fully connected hidden layers over the flattened input row,
+	* with a value head and a policy head. It is registered as architecture "mlp".
+	* The names and order of layers match the network that preceded the registry of architectures, so existing files of parameters load.
+	*/
+	struct MultilayerPerceptronImpl : NeuralNetworkImpl {
+		/* Create layers that are members of this structure
+		* so that each layer exists as part of the class's state and can be accessed by any member function.
+		* Mark submodules as mutable so they can be used in a const forward function.
+		*/
+		mutable torch::nn::Linear layer1{ nullptr };
+		mutable torch::nn::Linear layer2{ nullptr };
+		mutable torch::nn::Linear layerToCalculateValue{ nullptr };
+		mutable torch::nn::Linear layerToCalculatePolicy{ nullptr };
+		int64_t numberOfPolicyOutputs;
+
+		explicit MultilayerPerceptronImpl(const SpecificationOfNeuralNetwork& specification) :
+			numberOfPolicyOutputs(specification.getNumberOfPolicyOutputs())
+		{
+			/* Register each layer with libtorch to make libtorch aware of these layers
+			* and to allow automatically managing parameters and integrating layers.
+			*/
+			constexpr int64_t numberOfOutputs = 1;
+			const int64_t numberOfNeurons = specification.numberOfNeurons;
+			layer1 = register_module("layer1", torch::nn::Linear(specification.getNumberOfFeatures(), numberOfNeurons));
+			layer2 = register_module("layer2", torch::nn::Linear(numberOfNeurons, numberOfNeurons));
+			layerToCalculateValue = register_module("layerToCalculateValue", torch::nn::Linear(numberOfNeurons, numberOfOutputs));
+			layerToCalculatePolicy = register_module("layerToCalculatePolicy", torch::nn::Linear(numberOfNeurons, numberOfPolicyOutputs));
+		}
+
+		std::vector<torch::Tensor> forward(torch::Tensor inputTensorForBatch) const override {
+			torch::Tensor outputOfLayer1 = torch::relu(layer1->forward(inputTensorForBatch));
+			torch::Tensor outputOfLayer2 = torch::relu(layer2->forward(outputOfLayer1));
+			torch::Tensor tensorOfPredictedValues = torch::tanh(layerToCalculateValue->forward(outputOfLayer2));
+			torch::Tensor tensorOfPredictedPolicies = layerToCalculatePolicy->forward(outputOfLayer2);
+			if (numberOfPolicyOutputs == 1) {
+				tensorOfPredictedPolicies = torch::sigmoid(tensorOfPredictedPolicies);
+			}
+			return { tensorOfPredictedValues, tensorOfPredictedPolicies };
+		}
+	};
+
+}
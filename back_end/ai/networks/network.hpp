@@ -0,0 +1,83 @@
+#pragma once
+
+
+#include "../action_space.hpp"
+#include "../../game/board.hpp"
+#include <cstdint>
+#include "../state_features.hpp"
+#include <stdexcept>
+#include <string>
+#include <torch/torch.h>
+#include <vector>
+
+
+namespace AI {
+
+	/* Structure `SpecificationOfNeuralNetwork` selects an architecture registered in `ArchitectureRegistry` and its sizes.
+	* Sizes that an architecture does not use are ignored.
+	*/
+	struct SpecificationOfNeuralNetwork {
+		std::string architecture = "mlp";
+		PolicyHead policyHead = PolicyHead::Scalar;
+		int64_t numberOfNeurons = 128;
+		int64_t numberOfChannels = 32;
+		int64_t numberOfResidualBlocks = 4;
+
+		/* Method `getNumberOfFeatures` returns the width of an input row:
+		* the 441 codes of the cells of the grid representation of a move for a scalar policy head, or
+		* `NUMBER_OF_FEATURES_OF_STATE` features of a state for an actions head.
+		*/
+		int64_t getNumberOfFeatures() const {
+			return (policyHead == PolicyHead::Actions) ? NUMBER_OF_FEATURES_OF_STATE : Board::NUMBER_OF_CELLS_OF_GRID;
+		}
+
+		int64_t getNumberOfPolicyOutputs() const {
+			return (policyHead == PolicyHead::Actions) ? NUMBER_OF_ACTIONS : 1;
+		}
+	};
+
+	/* `struct` `NeuralNetworkImpl` is the interface that every architecture implements, so that
+	* evaluation, self play, and training use any architecture in the same way.
+	* The name `NeuralNetworkImpl` is required by macro `TORCH_MODULE`.
+	*/
+	struct NeuralNetworkImpl : torch::nn::Module {
+		virtual ~NeuralNetworkImpl() = default;
+
+		/* Method `forward` maps a batch of input rows with shape [B, F] to
+		* predicted values with shape [B, 1] in [-1, 1] and predicted policies with shape [B, P].
+		* With one policy output, a policy is a probability of a candidate move after a sigmoid.
+		* With more policy outputs, policies are unnormalized logits of actions, to which callers apply a softmax over legal actions.
+		*/
+		virtual std::vector<torch::Tensor> forward(torch::Tensor inputTensorForBatch) const = 0;
+	};
+
+	/* Class `NeuralNetwork` is a template for a wrapper that holds a shared pointer to an implementation of `NeuralNetworkImpl` and
+	* simplifies use of `NeuralNetworkImpl` with libtorch's module system.
+	*/
+	TORCH_MODULE(NeuralNetwork);
+
+	/* Function `getTensorsOfState` returns the parameters of a network followed by its buffers, such as running statistics of batch normalization.
+	* These tensors are what is saved to and loaded from files of parameters and copied between networks.
+	* A network without buffers has exactly its parameters, so files saved before buffers were included still load.
+	*/
+	std::vector<torch::Tensor> getTensorsOfState(const NeuralNetwork& neuralNetwork) {
+		std::vector<torch::Tensor> vectorOfTensors = neuralNetwork->parameters();
+		for (const torch::Tensor& buffer : neuralNetwork->buffers()) {
+			vectorOfTensors.push_back(buffer);
+		}
+		return vectorOfTensors;
+	}
+
+	// Function `copyTensorsOfState` copies tensors, such as those returned by `getTensorsOfState` or loaded from a file, into the state of a network.
+	void copyTensorsOfState(const std::vector<torch::Tensor>& vectorOfSourceTensors, const NeuralNetwork& neuralNetwork) {
+		std::vector<torch::Tensor> vectorOfTensors = getTensorsOfState(neuralNetwork);
+		if (vectorOfTensors.size() != vectorOfSourceTensors.size()) {
+			throw std::runtime_error("Numbers of parameters are mismatched.");
+		}
+		torch::NoGradGuard noGrad;
+		for (size_t i = 0; i < vectorOfTensors.size(); i++) {
+			vectorOfTensors[i].data().copy_(vectorOfSourceTensors[i].data());
+		}
+	}
+
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+
+#include "../../game/board.hpp"
+#include <cstdint>
+#include "../../game/labels.hpp"
+#include "network.hpp"
+#include "../state_features.hpp"
+#include <string>
+#include <vector>
+
+
+namespace AI {
+
+	// `struct` `ResidualBlockImpl` is two 3 x 3 convolutions with batch normalization and a skip connection.
+	struct ResidualBlockImpl : torch::nn::Module {
+		torch::nn::Conv2d convolution1{ nullptr };
+		torch::nn::BatchNorm2d batchNormalization1{ nullptr };
+		torch::nn::Conv2d convolution2{ nullptr };
+		torch::nn::BatchNorm2d batchNormalization2{ nullptr };
+
+		explicit ResidualBlockImpl(int64_t numberOfChannels) {
+			convolution1 = register_module("convolution1", torch::nn::Conv2d(torch::nn::Conv2dOptions(numberOfChannels, numberOfChannels, 3).padding(1).bias(false)));
+			batchNormalization1 = register_module("batchNormalization1", torch::nn::BatchNorm2d(numberOfChannels));
+			convolution2 = register_module("convolution2", torch::nn::Conv2d(torch::nn::Conv2dOptions(numberOfChannels, numberOfChannels, 3).padding(1).bias(false)));
+			batchNormalization2 = register_module("batchNormalization2", torch::nn::BatchNorm2d(numberOfChannels));
+		}
+
+		torch::Tensor forward(torch::Tensor input) {
+			torch::Tensor output = torch::relu(batchNormalization1->forward(convolution1->forward(input)));
+			output = batchNormalization2->forward(convolution2->forward(output));
+			return torch::relu(output + input);
+		}
+	};
+
+	TORCH_MODULE(ResidualBlock);
+
+	/* `struct` `ResidualCnnImpl` is a tower of residual blocks over planes of the 21 x 21 grid of the board,
+	* with a value head and a policy head that each reduce the tower with a 1 x 1 convolution. It is registered as architecture "residualCnn".
+	*
+	* For a scalar policy head, the codes of the cells of the grid representation of a move become 13 one hot planes.
+	* For an actions head, the features of a state become planes:
+	* 12 planes of settlements, cities, walls, and roads of each player on the cells of their vertices and edges,
+	* 3 planes of the cells of hexes, vertices, and edges,
+	* one constant plane per count of resources and per phase, and
+	* 7 planes of the resource and pips of each hex of the layout of the board on the cell of the hex.
+	*/
+	struct ResidualCnnImpl : NeuralNetworkImpl {
+		static constexpr int64_t DIMENSION_OF_GRID = Board::DIMENSION_OF_GRID;
+		static constexpr int64_t NUMBER_OF_CELLS_OF_GRID = Board::NUMBER_OF_CELLS_OF_GRID;
+		static constexpr int64_t NUMBER_OF_CODES_OF_CELLS = 13;
+		static constexpr int64_t NUMBER_OF_PLANES_OF_BOARD = 3;
+		static constexpr int64_t NUMBER_OF_PLANES_OF_STRUCTURES = ReplayRecord::NUMBER_OF_PLAYERS * 4;
+		static constexpr int64_t NUMBER_OF_FEATURES_OF_STRUCTURES = ReplayRecord::NUMBER_OF_PLAYERS * NUMBER_OF_FEATURES_OF_STRUCTURES_OF_PLAYER;
+		static constexpr int64_t NUMBER_OF_CONSTANT_PLANES = NUMBER_OF_FEATURES_OF_STATE - NUMBER_OF_FEATURES_OF_STRUCTURES - NUMBER_OF_FEATURES_OF_BOARD_LAYOUT;
+		static constexpr int64_t NUMBER_OF_PLANES_OF_BOARD_LAYOUT = NUMBER_OF_FEATURES_OF_HEX;
+
+		/* Mark submodules as mutable so they can be used in a const forward function.
+		*/
+		mutable torch::nn::Conv2d convolutionOfStem{ nullptr };
+		mutable torch::nn::BatchNorm2d batchNormalizationOfStem{ nullptr };
+		mutable std::vector<ResidualBlock> vectorOfResidualBlocks;
+		mutable torch::nn::Conv2d convolutionOfValueHead{ nullptr };
+		mutable torch::nn::BatchNorm2d batchNormalizationOfValueHead{ nullptr };
+		mutable torch::nn::Linear hiddenLayerOfValueHead{ nullptr };
+		mutable torch::nn::Linear layerToCalculateValue{ nullptr };
+		mutable torch::nn::Conv2d convolutionOfPolicyHead{ nullptr };
+		mutable torch::nn::BatchNorm2d batchNormalizationOfPolicyHead{ nullptr };
+		mutable torch::nn::Linear layerToCalculatePolicy{ nullptr };
+		PolicyHead policyHead;
+		int64_t numberOfPolicyOutputs;
+		torch::Tensor indicesOfCellsOfFeaturesOfStructures;
+		torch::Tensor indicesOfCellsOfFeaturesOfBoardLayout;
+		torch::Tensor planesOfBoard;
+
+		explicit ResidualCnnImpl(const SpecificationOfNeuralNetwork& specification) :
+			policyHead(specification.policyHead),
+			numberOfPolicyOutputs(specification.getNumberOfPolicyOutputs())
+		{
+			const int64_t numberOfChannels = specification.numberOfChannels;
+			int64_t numberOfInputPlanes = NUMBER_OF_CODES_OF_CELLS;
+			if (policyHead == PolicyHead::Actions) {
+				numberOfInputPlanes = NUMBER_OF_PLANES_OF_STRUCTURES + NUMBER_OF_PLANES_OF_BOARD + NUMBER_OF_CONSTANT_PLANES + NUMBER_OF_PLANES_OF_BOARD_LAYOUT;
+				createPlanesOfBoard();
+			}
+			convolutionOfStem = register_module("convolutionOfStem", torch::nn::Conv2d(torch::nn::Conv2dOptions(numberOfInputPlanes, numberOfChannels, 3).padding(1).bias(false)));
+			batchNormalizationOfStem = register_module("batchNormalizationOfStem", torch::nn::BatchNorm2d(numberOfChannels));
+			for (int64_t i = 0; i < specification.numberOfResidualBlocks; i++) {
+				vectorOfResidualBlocks.push_back(register_module("residualBlock" + std::to_string(i), ResidualBlock(numberOfChannels)));
+			}
+			convolutionOfValueHead = register_module("convolutionOfValueHead", torch::nn::Conv2d(torch::nn::Conv2dOptions(numberOfChannels, 1, 1).bias(false)));
+			batchNormalizationOfValueHead = register_module("batchNormalizationOfValueHead", torch::nn::BatchNorm2d(1));
+			hiddenLayerOfValueHead = register_module("hiddenLayerOfValueHead", torch::nn::Linear(NUMBER_OF_CELLS_OF_GRID, specification.numberOfNeurons));
+			layerToCalculateValue = register_module("layerToCalculateValue", torch::nn::Linear(specification.numberOfNeurons, 1));
+			convolutionOfPolicyHead = register_module("convolutionOfPolicyHead", torch::nn::Conv2d(torch::nn::Conv2dOptions(numberOfChannels, 2, 1).bias(false)));
+			batchNormalizationOfPolicyHead = register_module("batchNormalizationOfPolicyHead", torch::nn::BatchNorm2d(2));
+			layerToCalculatePolicy = register_module("layerToCalculatePolicy", torch::nn::Linear(2 * NUMBER_OF_CELLS_OF_GRID, numberOfPolicyOutputs));
+		}
+
+		std::vector<torch::Tensor> forward(torch::Tensor inputTensorForBatch) const override {
+			torch::Tensor output = torch::relu(batchNormalizationOfStem->forward(convolutionOfStem->forward(createPlanes(inputTensorForBatch))));
+			for (ResidualBlock& residualBlock : vectorOfResidualBlocks) {
+				output = residualBlock->forward(output);
+			}
+			torch::Tensor outputOfValueHead = torch::relu(batchNormalizationOfValueHead->forward(convolutionOfValueHead->forward(output))).flatten(1);
+			outputOfValueHead = torch::relu(hiddenLayerOfValueHead->forward(outputOfValueHead));
+			torch::Tensor tensorOfPredictedValues = torch::tanh(layerToCalculateValue->forward(outputOfValueHead));
+			torch::Tensor outputOfPolicyHead = torch::relu(batchNormalizationOfPolicyHead->forward(convolutionOfPolicyHead->forward(output))).flatten(1);
+			torch::Tensor tensorOfPredictedPolicies = layerToCalculatePolicy->forward(outputOfPolicyHead);
+			if (numberOfPolicyOutputs == 1) {
+				tensorOfPredictedPolicies = torch::sigmoid(tensorOfPredictedPolicies);
+			}
+			return { tensorOfPredictedValues, tensorOfPredictedPolicies };
+		}
+
+	private:
+
+		/* Method `createPlanesOfBoard` registers as buffers the planes of the cells of hexes, vertices, and edges,
+		* which are the same for every layout, and the index, in the flattened planes of structures or of the layout,
+		* of the cell of each feature of a structure or of a hex.
+		*/
+		void createPlanesOfBoard() {
+			Board board;
+			std::vector<float> vectorOfPlanesOfBoard(NUMBER_OF_PLANES_OF_BOARD * NUMBER_OF_CELLS_OF_GRID, 0.0f);
+			for (int indexOfHex = 0; indexOfHex < Game::NUMBER_OF_HEXES; indexOfHex++) {
+				vectorOfPlanesOfBoard[board.getIndexOfCellOfHex(indexOfHex)] = 1.0f;
+			}
+			for (int indexOfVertex = 0; indexOfVertex < Game::NUMBER_OF_VERTICES; indexOfVertex++) {
+				vectorOfPlanesOfBoard[NUMBER_OF_CELLS_OF_GRID + board.getIndexOfCellOfVertex(indexOfVertex)] = 1.0f;
+			}
+			for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+				vectorOfPlanesOfBoard[2 * NUMBER_OF_CELLS_OF_GRID + board.getIndexOfCellOfEdge(indexOfEdge)] = 1.0f;
+			}
+			planesOfBoard = register_buffer(
+				"planesOfBoard",
+				torch::tensor(vectorOfPlanesOfBoard, torch::kFloat32).view({ NUMBER_OF_PLANES_OF_BOARD, DIMENSION_OF_GRID, DIMENSION_OF_GRID })
+			);
+
+			std::vector<int64_t> vectorOfIndices;
+			vectorOfIndices.reserve(NUMBER_OF_FEATURES_OF_STRUCTURES);
+			for (int64_t offset = 0; offset < ReplayRecord::NUMBER_OF_PLAYERS; offset++) {
+				for (int64_t kind = 0; kind < 3; kind++) {
+					int64_t indexOfPlane = offset * 4 + kind;
+					for (int indexOfVertex = 0; indexOfVertex < Game::NUMBER_OF_VERTICES; indexOfVertex++) {
+						vectorOfIndices.push_back(indexOfPlane * NUMBER_OF_CELLS_OF_GRID + board.getIndexOfCellOfVertex(indexOfVertex));
+					}
+				}
+				int64_t indexOfPlaneOfRoads = offset * 4 + 3;
+				for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+					vectorOfIndices.push_back(indexOfPlaneOfRoads * NUMBER_OF_CELLS_OF_GRID + board.getIndexOfCellOfEdge(indexOfEdge));
+				}
+			}
+			indicesOfCellsOfFeaturesOfStructures = register_buffer("indicesOfCellsOfFeaturesOfStructures", torch::tensor(vectorOfIndices, torch::kLong));
+
+			std::vector<int64_t> vectorOfIndicesOfLayout;
+			vectorOfIndicesOfLayout.reserve(NUMBER_OF_FEATURES_OF_BOARD_LAYOUT);
+			for (int indexOfHex = 0; indexOfHex < Game::NUMBER_OF_HEXES; indexOfHex++) {
+				for (int64_t indexOfPlane = 0; indexOfPlane < NUMBER_OF_PLANES_OF_BOARD_LAYOUT; indexOfPlane++) {
+					vectorOfIndicesOfLayout.push_back(indexOfPlane * NUMBER_OF_CELLS_OF_GRID + board.getIndexOfCellOfHex(indexOfHex));
+				}
+			}
+			indicesOfCellsOfFeaturesOfBoardLayout = register_buffer("indicesOfCellsOfFeaturesOfBoardLayout", torch::tensor(vectorOfIndicesOfLayout, torch::kLong));
+		}
+
+		// Method `createPlanes` turns a batch of input rows into planes with shape [B, C, 21, 21].
+		torch::Tensor createPlanes(const torch::Tensor& inputTensorForBatch) const {
+			const int64_t numberOfRows = inputTensorForBatch.size(0);
+			if (policyHead == PolicyHead::Scalar) {
+				torch::Tensor tensorOfCodes = inputTensorForBatch.to(torch::kLong).clamp(0, NUMBER_OF_CODES_OF_CELLS - 1);
+				return torch::one_hot(tensorOfCodes, NUMBER_OF_CODES_OF_CELLS)
+					.permute({ 0, 2, 1 })
+					.reshape({ numberOfRows, NUMBER_OF_CODES_OF_CELLS, DIMENSION_OF_GRID, DIMENSION_OF_GRID })
+					.to(inputTensorForBatch.dtype());
+			}
+			torch::Tensor planesOfStructures = torch::zeros({ numberOfRows, NUMBER_OF_PLANES_OF_STRUCTURES * NUMBER_OF_CELLS_OF_GRID }, inputTensorForBatch.options());
+			planesOfStructures.index_copy_(1, indicesOfCellsOfFeaturesOfStructures, inputTensorForBatch.slice(1, 0, NUMBER_OF_FEATURES_OF_STRUCTURES));
+			const int64_t indexOfFirstFeatureOfBoardLayout = NUMBER_OF_FEATURES_OF_STRUCTURES + NUMBER_OF_CONSTANT_PLANES;
+			torch::Tensor constantPlanes = inputTensorForBatch.slice(1, NUMBER_OF_FEATURES_OF_STRUCTURES, indexOfFirstFeatureOfBoardLayout)
+				.unsqueeze(2)
+				.unsqueeze(3)
+				.expand({ numberOfRows, NUMBER_OF_CONSTANT_PLANES, DIMENSION_OF_GRID, DIMENSION_OF_GRID });
+			torch::Tensor planesOfBoardLayout = torch::zeros({ numberOfRows, NUMBER_OF_PLANES_OF_BOARD_LAYOUT * NUMBER_OF_CELLS_OF_GRID }, inputTensorForBatch.options());
+			planesOfBoardLayout.index_copy_(1, indicesOfCellsOfFeaturesOfBoardLayout, inputTensorForBatch.slice(1, indexOfFirstFeatureOfBoardLayout));
+			return torch::cat({
+				planesOfStructures.view({ numberOfRows, NUMBER_OF_PLANES_OF_STRUCTURES, DIMENSION_OF_GRID, DIMENSION_OF_GRID }),
+				planesOfBoard.unsqueeze(0).expand({ numberOfRows, NUMBER_OF_PLANES_OF_BOARD, DIMENSION_OF_GRID, DIMENSION_OF_GRID }),
+				constantPlanes,
+				planesOfBoardLayout.view({ numberOfRows, NUMBER_OF_PLANES_OF_BOARD_LAYOUT, DIMENSION_OF_GRID, DIMENSION_OF_GRID })
+			}, 1);
+		}
+	};
+
+}
@@ -1,7 +1,14 @@
 #pragma once
 
 
+#include "action_space.hpp"
+#include "networks/architecture_registry.hpp"
+#include <atomic>
 #include "../game/board.hpp"
+#include <filesystem>
+#include <functional>
+#include "../metrics.hpp"
+#include "state_features.hpp"
 
 #include <torch/script.h>
 /* Add to Additional Include Directories `$(SolutionDir)\dependencies\<debug or release>_version_of_libtorch\include;`.
@@ -42,43 +49,21 @@ xcopy /Y /I "$(SolutionDir)\dependencies\<debug or release>_version_of_libtorch\
 
 namespace AI {
 
-    /* `struct` `NeuralNetworkImpl` is a concrete implementation of a neural network that defines the network.
-    * The name `NeuralNetworkImpl` is required by macro `TORCH_MODULE`.
+    /* Function `saveAtomically` calls `save` with the path of a temporary file next to `path` and then renames the temporary file to `path`.
+    * A reader of `path` sees either the previous file or the complete new file, never a partially written file.
     */
-    struct NeuralNetworkImpl : torch::nn::Module {
-        /* Create layers that are members of this structure
-        * so that each layer exists as part of the class's state and can be accessed by any member function.
-        * Mark submodules as mutable so they can be used in a const forward function.
-        */
-        mutable torch::nn::Linear layer1{ nullptr };
-        mutable torch::nn::Linear layer2{ nullptr };
-        mutable torch::nn::Linear layerToCalculateValue{ nullptr };
-        mutable torch::nn::Linear layerToCalculatePolicy{ nullptr };
-
-        NeuralNetworkImpl(int64_t numberOfFeatures, int64_t numberOfNeurons) {
-            /* Register each layer with libtorch to make libtorch aware of these layers
-            * and to allow automatically managing parameters and integrating layers.
-            */
-            constexpr int64_t numberOfOutputs = 1;
-            layer1 = register_module("layer1", torch::nn::Linear(numberOfFeatures, numberOfNeurons));
-            layer2 = register_module("layer2", torch::nn::Linear(numberOfNeurons, numberOfNeurons));
-            layerToCalculateValue = register_module("layerToCalculateValue", torch::nn::Linear(numberOfNeurons, numberOfOutputs));
-            layerToCalculatePolicy = register_module("layerToCalculatePolicy", torch::nn::Linear(numberOfNeurons, numberOfOutputs));
+    void saveAtomically(const std::string& path, const std::function<void(const std::string&)>& save) {
+        std::string pathToTemporaryFile = path + ".tmp";
+        try {
+            save(pathToTemporaryFile);
+            std::filesystem::rename(pathToTemporaryFile, path);
         }
-
-        std::vector<torch::Tensor> forward(torch::Tensor inputTensorForBatch) const {
-            torch::Tensor outputOfLayer1 = torch::relu(layer1->forward(inputTensorForBatch));
-            torch::Tensor outputOfLayer2 = torch::relu(layer2->forward(outputOfLayer1));
-            torch::Tensor tensorOfPredictedValues = torch::tanh(layerToCalculateValue->forward(outputOfLayer2));
-            torch::Tensor tensorOfPredictedPolicies = torch::sigmoid(layerToCalculatePolicy->forward(outputOfLayer2));
-            return { tensorOfPredictedValues, tensorOfPredictedPolicies };
+        catch (...) {
+            std::error_code errorCode;
+            std::filesystem::remove(pathToTemporaryFile, errorCode);
+            throw;
         }
-    };
-
-    /* Class `NeuralNetwork` is a template for a wrapper that holds a shared pointer to `NeuralNetworkImpl` and
-    * simplifies use of `NeuralNetworkImpl` with libtorch's module system.
-    */
-    TORCH_MODULE(NeuralNetwork);
+    }
 
     /* Class `WrapperOfNeuralNetwork` is a template for a wrapper of an instance of `NeuralNetwork` that
     * - handles network lifecycle by managing saving and loading model parameters from a file and handling device assignment, and
@@ -88,27 +73,40 @@ namespace AI {
     private:
         std::filesystem::file_time_type lastWriteTime;
         torch::Device device;
+        mutable std::atomic<long long> numberOfEvaluations{ 0 };
+        SpecificationOfNeuralNetwork specification;
+        Metrics::Histogram& histogramOfSizesOfBatches = Metrics::Registry::getInstance().getHistogram(
+            "catan_nn_batch_size",
+            "Number of rows in each batch evaluated by the network.",
+            Metrics::createExponentialBuckets(1.0, 2.0, 10)
+        );
+        Metrics::Histogram& histogramOfDurationsOfForwardPasses = Metrics::Registry::getInstance().getHistogram(
+            "catan_nn_forward_duration_seconds",
+            "Seconds of each evaluation by the network while holding its lock, from building input tensors to copying outputs to the CPU.",
+            Metrics::BUCKETS_OF_LATENCIES
+        );
     public:
         NeuralNetwork neuralNetwork = nullptr;
         std::string pathToFileOfParameters;
         Board board;
         mutable std::mutex mutex;
 
-        WrapperOfNeuralNetwork(const std::string& pathToFileOfParameters, const int numberOfNeurons) :
+        WrapperOfNeuralNetwork(const std::string& pathToFileOfParameters, const SpecificationOfNeuralNetwork& specification) :
             pathToFileOfParameters(pathToFileOfParameters),
             device(torch::kCPU),
+            specification(specification),
             board()
         {
-            const int64_t numberOfFeatures = 21 * 21;
-            // TODO: Get number of features based on feature vector.
-
-            neuralNetwork = NeuralNetwork(numberOfFeatures, numberOfNeurons);
+            neuralNetwork = ArchitectureRegistry::create(specification);
             neuralNetwork->eval();
+            Logger::info("A network of architecture " + specification.architecture + " was created.");
 
             if (!std::filesystem::exists(pathToFileOfParameters)) {
 				Logger::warn("WrapperOfNeuralNetwork", "Model parameters file does not exist.");
-                torch::autograd::variable_list variableListOfParameters = neuralNetwork->parameters();
-                torch::save(variableListOfParameters, pathToFileOfParameters);
+                std::vector<torch::Tensor> vectorOfTensorsOfState = getTensorsOfState(neuralNetwork);
+                saveAtomically(pathToFileOfParameters, [&](const std::string& pathToTemporaryFile) {
+                    torch::save(vectorOfTensorsOfState, pathToTemporaryFile);
+                });
 				Logger::info("Default model parameters were saved to " + pathToFileOfParameters + ".");
             }
             bool cudaIsAvailable = torch::cuda::is_available();
@@ -126,15 +124,7 @@ namespace AI {
 
             std::vector<torch::Tensor> vectorOfParameters;
             torch::load(vectorOfParameters, pathToFileOfParameters);
-            torch::autograd::variable_list variableListOfParameters = neuralNetwork->parameters();
-            if (variableListOfParameters.size() != vectorOfParameters.size()) {
-                throw std::runtime_error("Numbers of parameters are mismatched.");
-            }
-            // Disable gradient tracking during parameter copy.
-            torch::NoGradGuard noGrad;
-            for (size_t i = 0; i < vectorOfParameters.size(); i++) {
-                variableListOfParameters[i].data().copy_(vectorOfParameters[i].data());
-            }
+            copyTensorsOfState(vectorOfParameters, neuralNetwork);
             lastWriteTime = std::filesystem::last_write_time(pathToFileOfParameters);
 			message = "Model parameters were successfully loaded from " + pathToFileOfParameters + " on device ";
             if (device == torch::kCUDA) {
@@ -147,8 +137,47 @@ namespace AI {
             Logger::info(message);
         }
 
+        PolicyHead getPolicyHead() const {
+            return specification.policyHead;
+        }
+
+        const SpecificationOfNeuralNetwork& getSpecification() const {
+            return specification;
+        }
+
+        // Method `getNumberOfEvaluations` returns the number of input rows this wrapper has evaluated, which counts one row per state or structure.
+        long long getNumberOfEvaluations() const {
+            return numberOfEvaluations.load(std::memory_order_relaxed);
+        }
+
+        /* Method `evaluateState` evaluates a game state from the perspective of a player with a network with an actions head and
+        * returns the predicted value and the logits of all `NUMBER_OF_ACTIONS` actions.
+        */
+        std::pair<double, std::vector<float>> evaluateState(const GameState& gameState, int perspectivePlayer) const {
+            if (specification.policyHead != PolicyHead::Actions) {
+                throw std::logic_error("Only a network with an actions head can evaluate a state.");
+            }
+            std::vector<float> featureVector = getStateFeatures(gameState, perspectivePlayer);
+            std::lock_guard<std::mutex> lock(mutex);
+            numberOfEvaluations.fetch_add(1, std::memory_order_relaxed);
+            histogramOfSizesOfBatches.observe(1.0);
+            Metrics::ScopedTimer timerOfForwardPass(histogramOfDurationsOfForwardPasses);
+            torch::NoGradGuard noGrad;
+            c10::TensorOptions tensorOptions = torch::TensorOptions().device(device).dtype(torch::kFloat32);
+            int dimension = 0;
+            torch::Tensor inputTensor = torch::tensor(featureVector, tensorOptions).unsqueeze(dimension);
+            std::vector<torch::Tensor> vectorOfTensorsOfPredictedValueAndPolicy = neuralNetwork->forward(inputTensor);
+            double value = vectorOfTensorsOfPredictedValueAndPolicy[0].item<double>();
+            torch::Tensor tensorOfLogits = vectorOfTensorsOfPredictedValueAndPolicy[1].squeeze(dimension).to(torch::kCPU).contiguous();
+            std::vector<float> vectorOfLogits(tensorOfLogits.data_ptr<float>(), tensorOfLogits.data_ptr<float>() + tensorOfLogits.numel());
+            return { value, vectorOfLogits };
+        }
+
         std::pair<double, double> evaluateStructure(const std::vector<float>& featureVector) const {
 			std::lock_guard<std::mutex> lock(mutex);
+            numberOfEvaluations.fetch_add(1, std::memory_order_relaxed);
+            histogramOfSizesOfBatches.observe(1.0);
+            Metrics::ScopedTimer timerOfForwardPass(histogramOfDurationsOfForwardPasses);
             // Disable gradient calculation for inference.
             torch::NoGradGuard noGrad;
             c10::TensorOptions tensorOptions = torch::TensorOptions().device(device);
@@ -163,6 +192,9 @@ namespace AI {
 
         std::vector<std::pair<double, double>> evaluateStructures(const std::vector<std::vector<float>>& vectorOfFeatureVectors) const {
 			std::lock_guard<std::mutex> lock(mutex);
+            numberOfEvaluations.fetch_add(static_cast<long long>(vectorOfFeatureVectors.size()), std::memory_order_relaxed);
+            histogramOfSizesOfBatches.observe(static_cast<double>(vectorOfFeatureVectors.size()));
+            Metrics::ScopedTimer timerOfForwardPass(histogramOfDurationsOfForwardPasses);
             torch::NoGradGuard noGrad;
             std::vector<torch::Tensor> vectorOfTensorsOfFeatureVectors;
             c10::TensorOptions tensorOptions = torch::TensorOptions().device(device).dtype(torch::kFloat32);
@@ -188,6 +220,44 @@ namespace AI {
             return vectorOfPairsOfValuesAndPolicies;
         }
 
+        /* Method `createCopyOfNeuralNetwork` creates a network with the architecture and device of this network and
+        * a copy of its parameters, so that the copy can be trained while this network keeps serving inference.
+        */
+        NeuralNetwork createCopyOfNeuralNetwork() const {
+            NeuralNetwork copyOfNeuralNetwork = ArchitectureRegistry::create(specification);
+            copyOfNeuralNetwork->to(device);
+            std::lock_guard<std::mutex> lock(mutex);
+            copyTensorsOfState(getTensorsOfState(neuralNetwork), copyOfNeuralNetwork);
+            return copyOfNeuralNetwork;
+        }
+
+        /* Method `updateParameters` copies the parameters of a trained network into this network and
+        * saves them to the file of parameters, so that inference uses the trained parameters without a reload.
+        */
+        void updateParameters(const NeuralNetwork& trainedNeuralNetwork) {
+            std::lock_guard<std::mutex> lock(mutex);
+            copyTensorsOfState(getTensorsOfState(trainedNeuralNetwork), neuralNetwork);
+            std::vector<torch::Tensor> vectorOfTensorsOfState = getTensorsOfState(neuralNetwork);
+            saveAtomically(pathToFileOfParameters, [&](const std::string& pathToTemporaryFile) {
+                torch::save(vectorOfTensorsOfState, pathToTemporaryFile);
+            });
+            lastWriteTime = std::filesystem::last_write_time(pathToFileOfParameters);
+        }
+
+        /* Method `loadParameters` copies parameters saved in a file, such as a checkpoint, into this network.
+        * Parameters are read completely before any are copied, so a file that cannot be read leaves this network unchanged.
+        */
+        void loadParameters(const std::string& pathToParameters) {
+            std::vector<torch::Tensor> vectorOfParameters;
+            torch::load(vectorOfParameters, pathToParameters);
+            std::lock_guard<std::mutex> lock(mutex);
+            copyTensorsOfState(vectorOfParameters, neuralNetwork);
+        }
+
+        /* Method `reloadIfUpdated` reloads parameters when the file of parameters is newer than the last parameters loaded or saved.
+        * Files of parameters are replaced by renaming complete files, so a reload never reads a partial file;
+        * a file that still cannot be loaded is logged and the current parameters are kept.
+        */
         void reloadIfUpdated() {
 			std::lock_guard<std::mutex> lock(mutex);
 
@@ -199,20 +269,12 @@ namespace AI {
             try {
                 std::vector<torch::Tensor> vectorOfParameters;
                 torch::load(vectorOfParameters, pathToFileOfParameters);
-                torch::autograd::variable_list variableListOfParameters = neuralNetwork->parameters();
-                if (variableListOfParameters.size() != vectorOfParameters.size()) {
-                    throw std::runtime_error("Numbers of parameters were mismatched during reload.");
-                }
-                torch::NoGradGuard noGrad;
-                for (size_t i = 0; i < vectorOfParameters.size(); i++) {
-                    variableListOfParameters[i].data().copy_(vectorOfParameters[i].data());
-                }
+                copyTensorsOfState(vectorOfParameters, neuralNetwork);
                 lastWriteTime = currentWriteTime;
                 Logger::info("Model was reloaded after updated model parameters were detected.");
             }
             catch (const std::exception& e) {
                 Logger::error("reloadIfUpdated", e);
-                throw e;
             }
         }
     };
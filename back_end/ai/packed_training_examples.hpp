@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include "action_space.hpp"
+#include "../game/board.hpp"
+#include "../game/board_layout.hpp"
+#include <cstdint>
+#include "replay_buffer.hpp"
+#include "state_features.hpp"
+#include <vector>
+
+
+namespace AI {
+
+	/* Structure `PackedTrainingExamples` holds training examples in a columnar layout.
+	* Features are `numberOfFeatures` bytes per example, stored contiguously in row major order with shape [N, numberOfFeatures].
+	* For a scalar policy head, features are the 441 cells of the grid representation of the move of the example on the layout of its board, and
+	* the policy target is the fraction of visits of the move. For an actions head, features are the features of the state of the example, and
+	* the policy target is the distribution of visits over all `NUMBER_OF_ACTIONS` actions.
+	* Values are a contiguous column of N floats and policies are N rows of `numberOfPolicyTargets` floats.
+	* Each column can be wrapped as a tensor with `torch::from_blob` without copying.
+	*/
+	struct PackedTrainingExamples {
+		int64_t numberOfExamples{ 0 };
+		int64_t numberOfFeatures{ Board::NUMBER_OF_CELLS_OF_GRID };
+		int64_t numberOfPolicyTargets{ 1 };
+		std::vector<uint8_t> features;
+		std::vector<float> values;
+		std::vector<float> policies;
+	};
+
+	/* Function `packTrainingExamples` computes the features of replay records once and packs them with their targets for a policy head.
+	* Records of a game share a layout, so the grid of a layout is looked up in the cache of layouts only when the layout changes between records.
+	*/
+	PackedTrainingExamples packTrainingExamples(const std::vector<ReplayRecord>& vectorOfReplayRecords, PolicyHead policyHead = PolicyHead::Scalar) {
+		PackedTrainingExamples packedTrainingExamples;
+		packedTrainingExamples.numberOfExamples = static_cast<int64_t>(vectorOfReplayRecords.size());
+		if (policyHead == PolicyHead::Actions) {
+			packedTrainingExamples.numberOfFeatures = NUMBER_OF_FEATURES_OF_STATE;
+			packedTrainingExamples.numberOfPolicyTargets = NUMBER_OF_ACTIONS;
+		}
+		packedTrainingExamples.features.resize(vectorOfReplayRecords.size() * packedTrainingExamples.numberOfFeatures);
+		packedTrainingExamples.values.reserve(vectorOfReplayRecords.size());
+		packedTrainingExamples.policies.resize(vectorOfReplayRecords.size() * packedTrainingExamples.numberOfPolicyTargets);
+		uint8_t* features = packedTrainingExamples.features.data();
+		float* policies = packedTrainingExamples.policies.data();
+		Board board;
+		for (const ReplayRecord& replayRecord : vectorOfReplayRecords) {
+			if (policyHead == PolicyHead::Actions) {
+				writeStateFeatures(replayRecord, replayRecord.player, features);
+				replayRecord.writePolicy(policies);
+			}
+			else {
+				Game::BoardLayout boardLayout = replayRecord.getBoardLayout();
+				if (!(boardLayout == board.getBoardLayout())) {
+					board = Board(Game::getPrecomputedBoardLayout(boardLayout));
+				}
+				board.writeGridRepresentationForMove(replayRecord.getMove(), replayRecord.getMoveType(), features);
+				*policies = replayRecord.policy;
+			}
+			features += packedTrainingExamples.numberOfFeatures;
+			policies += packedTrainingExamples.numberOfPolicyTargets;
+			packedTrainingExamples.values.push_back(replayRecord.value);
+		}
+		return packedTrainingExamples;
+	}
+
+}
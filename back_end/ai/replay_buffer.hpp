@@ -0,0 +1,421 @@
+#pragma once
+
+
+#include <algorithm>
+#include "action_space.hpp"
+#include <bit>
+#include "../game/board_layout.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "../game/game_state.hpp"
+#include "../game/labels.hpp"
+#include "../logger.hpp"
+#include "../memory_mapped_file.hpp"
+#include <mutex>
+#include <random>
+#include "../random.hpp"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace AI {
+
+	static_assert(std::endian::native == std::endian::little, "Shards of the replay buffer are read and written in little endian order.");
+
+	/* Structure `ReplayRecord` is a fixed size binary record of a training example.
+	* The game state is encoded as masks of structures and counts of resources per player, like the binary format of `/board`,
+	* so that a record is 352 bytes instead of a copy of `GameState` with vectors of labels.
+	* The layout of the board is stored as one code per hex, so that records of games on different layouts can be mixed.
+	* The distribution of visits of a search is stored sparsely as up to `MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY` actions
+	* with fractions of visits quantized to 16 bits.
+	* Records are written to and read from shards as raw bytes.
+	*/
+	struct ReplayRecord {
+		static constexpr int NUMBER_OF_PLAYERS = 3;
+		static constexpr int MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY = 48;
+
+		uint64_t masksOfSettlements[NUMBER_OF_PLAYERS];
+		uint64_t masksOfCities[NUMBER_OF_PLAYERS];
+		uint64_t masksOfWalls[NUMBER_OF_PLAYERS];
+		// Bit i of the first mask represents edge i + 1 and bit i of the second mask represents edge i + 65.
+		uint64_t masksOfRoads[NUMBER_OF_PLAYERS][2];
+		// Counts of brick, grain, lumber, ore, wool, cloth, coin, and paper.
+		int16_t resources[NUMBER_OF_PLAYERS][8];
+		uint8_t phase;
+		uint8_t currentPlayer;
+		uint8_t player;
+		uint8_t indexOfAction;
+		uint8_t typeOfMove;
+		uint8_t numberOfActionsInPolicy;
+		uint8_t reserved[2];
+		float value;
+		float policy;
+		uint8_t actionsInPolicy[MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY];
+		// Fraction of visits of each action in `actionsInPolicy`, multiplied by 65535.
+		uint16_t quantizedProbabilitiesInPolicy[MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY];
+		// Resource + 8 * number of token of each hex, as packed by `Game::BoardLayout::getCodeOfHex`.
+		uint8_t codesOfHexes[Game::NUMBER_OF_HEXES];
+		uint8_t reservedAfterCodesOfHexes[5];
+
+		std::string getMove() const {
+			return getMoveOfAction(indexOfAction);
+		}
+
+		std::string getMoveType() const {
+			return toString(static_cast<TypeOfMove>(typeOfMove));
+		}
+
+		Game::BoardLayout getBoardLayout() const {
+			return Game::BoardLayout::fromCodesOfHexes(codesOfHexes);
+		}
+
+		// Method `writePolicy` writes the distribution of visits densely as `NUMBER_OF_ACTIONS` probabilities.
+		void writePolicy(float* probabilities) const {
+			std::fill(probabilities, probabilities + NUMBER_OF_ACTIONS, 0.0f);
+			for (int i = 0; i < numberOfActionsInPolicy; i++) {
+				probabilities[actionsInPolicy[i]] = quantizedProbabilitiesInPolicy[i] / 65535.0f;
+			}
+		}
+	};
+
+	static_assert(sizeof(ReplayRecord) == 352, "The size of a replay record is part of the format of shards.");
+	static_assert(std::is_trivially_copyable_v<ReplayRecord>, "Replay records are copied as raw bytes.");
+
+	// Function `encodeGameState` encodes the structures, resources, phase, current player, and layout of a game state into a replay record.
+	void encodeGameState(const GameState& gameState, ReplayRecord& record) {
+		for (int indexOfPlayer = 0; indexOfPlayer < ReplayRecord::NUMBER_OF_PLAYERS; indexOfPlayer++) {
+			int playerToEncode = indexOfPlayer + 1;
+			auto encodeVertices = [](const Game::ListOfVertices& listOfVertices) {
+				uint64_t mask = 0;
+				for (int indexOfVertex : listOfVertices) {
+					mask |= uint64_t{ 1 } << indexOfVertex;
+				}
+				return mask;
+			};
+			record.masksOfSettlements[indexOfPlayer] = encodeVertices(gameState.settlements[playerToEncode]);
+			record.masksOfCities[indexOfPlayer] = encodeVertices(gameState.cities[playerToEncode]);
+			record.masksOfWalls[indexOfPlayer] = encodeVertices(gameState.walls[playerToEncode]);
+			record.masksOfRoads[indexOfPlayer][0] = 0;
+			record.masksOfRoads[indexOfPlayer][1] = 0;
+			for (int indexOfEdge : gameState.roads[playerToEncode]) {
+				record.masksOfRoads[indexOfPlayer][indexOfEdge / 64] |= uint64_t{ 1 } << (indexOfEdge % 64);
+			}
+			const ResourceBag& bag = gameState.resources[playerToEncode];
+			int counts[8] = { bag.brick, bag.grain, bag.lumber, bag.ore, bag.wool, bag.cloth, bag.coin, bag.paper };
+			for (int i = 0; i < 8; i++) {
+				record.resources[indexOfPlayer][i] = static_cast<int16_t>(counts[i]);
+			}
+		}
+		record.phase = static_cast<uint8_t>(gameState.phase);
+		record.currentPlayer = static_cast<uint8_t>(gameState.currentPlayer);
+		for (int indexOfHex = 0; indexOfHex < Game::NUMBER_OF_HEXES; indexOfHex++) {
+			record.codesOfHexes[indexOfHex] = gameState.precomputedBoardLayout->boardLayout.getCodeOfHex(indexOfHex);
+		}
+	}
+
+	/* Function `encodeReplayRecord` encodes a move made by a player in a game state, which is the state in which the move was searched,
+	* with its target value, the fraction of visits of the move, and the distribution of visits of the search.
+	* If the distribution has more than `MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY` actions, the most visited actions are kept and renormalized.
+	*/
+	ReplayRecord encodeReplayRecord(
+		int player,
+		const GameState& gameState,
+		const std::string& move,
+		const std::string& moveType,
+		double value,
+		double policy,
+		const VisitDistribution& visitDistribution = {}
+	) {
+		ReplayRecord record{};
+		encodeGameState(gameState, record);
+		record.player = static_cast<uint8_t>(player);
+		record.indexOfAction = static_cast<uint8_t>(getIndexOfAction(move, moveType));
+		record.typeOfMove = static_cast<uint8_t>(typeOfMoveFromString(moveType));
+		record.value = static_cast<float>(value);
+		record.policy = static_cast<float>(policy);
+
+		VisitDistribution visitDistributionToStore = visitDistribution;
+		if (visitDistributionToStore.size() > ReplayRecord::MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY) {
+			std::partial_sort(
+				visitDistributionToStore.begin(),
+				visitDistributionToStore.begin() + ReplayRecord::MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY,
+				visitDistributionToStore.end(),
+				[](const std::pair<int, float>& first, const std::pair<int, float>& second) { return first.second > second.second; }
+			);
+			visitDistributionToStore.resize(ReplayRecord::MAXIMUM_NUMBER_OF_ACTIONS_IN_POLICY);
+		}
+		float sumOfProbabilities = 0.0f;
+		for (const auto& [indexOfAction, probability] : visitDistributionToStore) {
+			sumOfProbabilities += probability;
+		}
+		for (const auto& [indexOfAction, probability] : visitDistributionToStore) {
+			if (sumOfProbabilities <= 0.0f) {
+				break;
+			}
+			int i = record.numberOfActionsInPolicy++;
+			record.actionsInPolicy[i] = static_cast<uint8_t>(indexOfAction);
+			record.quantizedProbabilitiesInPolicy[i] = static_cast<uint16_t>(std::lround(probability / sumOfProbabilities * 65535.0f));
+		}
+		return record;
+	}
+
+	enum class SamplingOfReplayBuffer {
+		Uniform,
+		Recency
+	};
+
+	SamplingOfReplayBuffer samplingOfReplayBufferFromString(const std::string& string) {
+		if (string == "uniform") { return SamplingOfReplayBuffer::Uniform; }
+		if (string == "recency") { return SamplingOfReplayBuffer::Recency; }
+		throw std::runtime_error("Unknown sampling of replay buffer: " + string);
+	}
+
+	/* Class `ReplayBuffer` persists training examples as replay records in binary shards in a directory,
+	* so that examples survive restarts and training can draw from more examples than fit in memory.
+	*
+	* A shard is a file named like "shard_00000042.bin" with a header of 16 bytes followed by records:
+	* bytes 0 to 3: "CTNR"
+	* bytes 4 to 7: version of format
+	* bytes 8 to 11: size of record
+	* bytes 12 to 15: capacity of shard in records
+	*
+	* Shards of an unknown format, such as those written by an older version, are kept on disk but ignored,
+	* and new shards are numbered after every shard in the directory, so an existing file is never overwritten.
+	* Records are appended to the newest shard until it is full. Only the newest `sizeOfWindow` records are sampled,
+	* and shards whose records have all left the window are deleted.
+	* Shards are memory mapped for sampling, so sampling reads only the pages of the records that are drawn.
+	* Uniform sampling draws every record in the window with equal probability.
+	* Recency sampling draws the record at offset floor(n sqrt(u)) from the oldest record in a window of n records, where u is uniform on [0, 1),
+	* so the probability of a record grows linearly with its recency.
+	*/
+	class ReplayBuffer {
+	public:
+
+		static constexpr uint32_t VERSION_OF_FORMAT_OF_SHARD = 3;
+		static constexpr size_t SIZE_OF_HEADER_OF_SHARD = 16;
+
+		ReplayBuffer(const std::string& pathToDirectoryToUse, int numberOfRecordsPerShardToUse, int64_t sizeOfWindowToUse) :
+			pathToDirectory(pathToDirectoryToUse),
+			numberOfRecordsPerShard(numberOfRecordsPerShardToUse),
+			sizeOfWindow(sizeOfWindowToUse),
+			randomEngine(Random::createStream(Random::Purpose::ReplayBuffer, 0))
+		{
+			if (numberOfRecordsPerShard < 1 || sizeOfWindow < 1) {
+				throw std::invalid_argument("A replay buffer requires a positive number of records per shard and a positive size of window.");
+			}
+			std::filesystem::create_directories(pathToDirectory);
+			loadShards();
+			deleteShardsOutsideWindow();
+			Logger::info(
+				"[REPLAY BUFFER] " + std::to_string(getNumberOfRecordsInWindow()) + " records in " + std::to_string(vectorOfShards.size()) +
+				" shards were found in " + pathToDirectory + "."
+			);
+		}
+
+		void append(const std::vector<ReplayRecord>& vectorOfRecords) {
+			std::lock_guard<std::mutex> lock(mutex);
+			size_t indexOfNextRecordToWrite = 0;
+			while (indexOfNextRecordToWrite < vectorOfRecords.size()) {
+				if (vectorOfShards.empty() || vectorOfShards.back().numberOfRecords >= vectorOfShards.back().capacity) {
+					createShard();
+				}
+				Shard& shard = vectorOfShards.back();
+				size_t numberOfRecordsToWrite = std::min(
+					vectorOfRecords.size() - indexOfNextRecordToWrite,
+					static_cast<size_t>(shard.capacity - shard.numberOfRecords)
+				);
+				std::ofstream file(shard.path, std::ios::binary | std::ios::app);
+				if (!file) {
+					throw std::runtime_error("Shard " + shard.path + " could not be opened for appending.");
+				}
+				file.write(reinterpret_cast<const char*>(vectorOfRecords.data() + indexOfNextRecordToWrite), numberOfRecordsToWrite * sizeof(ReplayRecord));
+				if (!file) {
+					throw std::runtime_error("Records could not be appended to shard " + shard.path + ".");
+				}
+				shard.numberOfRecords += static_cast<int64_t>(numberOfRecordsToWrite);
+				indexOfNextRecordToWrite += numberOfRecordsToWrite;
+			}
+			deleteShardsOutsideWindow();
+		}
+
+		// Method `getNumberOfRecordsInWindow` returns the number of records that may be sampled.
+		int64_t getNumberOfRecordsInWindow() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return getIndexOfEndOfRecords() - getIndexOfStartOfWindow();
+		}
+
+		// Method `sample` draws records from the window with replacement. Fewer records are returned only if the window is empty.
+		std::vector<ReplayRecord> sample(int numberOfRecords, SamplingOfReplayBuffer sampling) {
+			std::lock_guard<std::mutex> lock(mutex);
+			std::vector<ReplayRecord> vectorOfRecords;
+			int64_t indexOfStartOfWindow = getIndexOfStartOfWindow();
+			int64_t numberOfRecordsInWindow = getIndexOfEndOfRecords() - indexOfStartOfWindow;
+			if (numberOfRecordsInWindow <= 0) {
+				return vectorOfRecords;
+			}
+			vectorOfRecords.resize(numberOfRecords);
+			std::uniform_real_distribution<double> uniformDistribution(0.0, 1.0);
+			for (ReplayRecord& record : vectorOfRecords) {
+				double u = uniformDistribution(randomEngine);
+				double fraction = (sampling == SamplingOfReplayBuffer::Recency) ? std::sqrt(u) : u;
+				int64_t offset = std::min(static_cast<int64_t>(fraction * numberOfRecordsInWindow), numberOfRecordsInWindow - 1);
+				readRecord(indexOfStartOfWindow + offset, record);
+			}
+			return vectorOfRecords;
+		}
+
+	private:
+
+		struct Shard {
+			int64_t number{ 0 };
+			std::string path;
+			int64_t indexOfFirstRecord{ 0 };
+			int64_t numberOfRecords{ 0 };
+			int64_t capacity{ 0 };
+			MemoryMappedFile memoryMappedFile;
+		};
+
+		std::string pathToDirectory;
+		int numberOfRecordsPerShard;
+		int64_t sizeOfWindow;
+		std::vector<Shard> vectorOfShards;
+		// Member `numberOfNextShard` is one more than the number of any shard in the directory, including ignored shards.
+		int64_t numberOfNextShard{ 0 };
+		Random::Xoshiro256PlusPlus randomEngine;
+		mutable std::mutex mutex;
+
+		std::string getPathOfShard(int64_t numberOfShard) const {
+			char nameOfFile[32];
+			std::snprintf(nameOfFile, sizeof(nameOfFile), "shard_%08lld.bin", static_cast<long long>(numberOfShard));
+			return (std::filesystem::path(pathToDirectory) / nameOfFile).string();
+		}
+
+		int64_t getIndexOfEndOfRecords() const {
+			if (vectorOfShards.empty()) {
+				return 0;
+			}
+			return vectorOfShards.back().indexOfFirstRecord + vectorOfShards.back().numberOfRecords;
+		}
+
+		int64_t getIndexOfStartOfWindow() const {
+			int64_t indexOfStartOfRecords = vectorOfShards.empty() ? 0 : vectorOfShards.front().indexOfFirstRecord;
+			return std::max(indexOfStartOfRecords, getIndexOfEndOfRecords() - sizeOfWindow);
+		}
+
+		/* Method `loadShards` reads the headers of existing shards in order of number.
+		* A record that was partially written when the process stopped is truncated.
+		*/
+		void loadShards() {
+			std::vector<std::pair<int64_t, std::string>> vectorOfNumbersAndPaths;
+			for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(pathToDirectory)) {
+				std::string nameOfFile = entry.path().filename().string();
+				long long numberOfShard = 0;
+				char suffix[8] = {};
+				if (std::sscanf(nameOfFile.c_str(), "shard_%lld.%4s", &numberOfShard, suffix) == 2 && std::string(suffix) == "bin") {
+					vectorOfNumbersAndPaths.emplace_back(numberOfShard, entry.path().string());
+				}
+			}
+			std::sort(vectorOfNumbersAndPaths.begin(), vectorOfNumbersAndPaths.end());
+			if (!vectorOfNumbersAndPaths.empty()) {
+				numberOfNextShard = vectorOfNumbersAndPaths.back().first + 1;
+			}
+
+			int64_t indexOfFirstRecord = 0;
+			for (const auto& [numberOfShard, path] : vectorOfNumbersAndPaths) {
+				std::ifstream file(path, std::ios::binary);
+				unsigned char header[SIZE_OF_HEADER_OF_SHARD] = {};
+				file.read(reinterpret_cast<char*>(header), SIZE_OF_HEADER_OF_SHARD);
+				uint32_t version = 0;
+				uint32_t sizeOfRecord = 0;
+				uint32_t capacity = 0;
+				std::memcpy(&version, header + 4, 4);
+				std::memcpy(&sizeOfRecord, header + 8, 4);
+				std::memcpy(&capacity, header + 12, 4);
+				if (!file || std::memcmp(header, "CTNR", 4) != 0 || version != VERSION_OF_FORMAT_OF_SHARD || sizeOfRecord != sizeof(ReplayRecord)) {
+					Logger::warn("ReplayBuffer", "Shard " + path + " has an unknown format and will be ignored.");
+					continue;
+				}
+				file.close();
+				uintmax_t sizeOfFile = std::filesystem::file_size(path);
+				int64_t numberOfRecords = static_cast<int64_t>((sizeOfFile - SIZE_OF_HEADER_OF_SHARD) / sizeof(ReplayRecord));
+				uintmax_t sizeOfCompleteRecords = SIZE_OF_HEADER_OF_SHARD + numberOfRecords * sizeof(ReplayRecord);
+				if (sizeOfFile != sizeOfCompleteRecords) {
+					Logger::warn("ReplayBuffer", "A partially written record in shard " + path + " will be truncated.");
+					std::filesystem::resize_file(path, sizeOfCompleteRecords);
+				}
+				Shard shard;
+				shard.number = numberOfShard;
+				shard.path = path;
+				shard.indexOfFirstRecord = indexOfFirstRecord;
+				shard.numberOfRecords = numberOfRecords;
+				shard.capacity = capacity;
+				vectorOfShards.push_back(std::move(shard));
+				indexOfFirstRecord += numberOfRecords;
+			}
+		}
+
+		// Method `createShard` creates a shard with the next unused number. A file that already exists is skipped rather than truncated.
+		void createShard() {
+			Shard shard;
+			shard.number = numberOfNextShard++;
+			shard.path = getPathOfShard(shard.number);
+			while (std::filesystem::exists(shard.path)) {
+				Logger::warn("ReplayBuffer", "Shard " + shard.path + " already exists and will not be overwritten.");
+				shard.number = numberOfNextShard++;
+				shard.path = getPathOfShard(shard.number);
+			}
+			shard.indexOfFirstRecord = getIndexOfEndOfRecords();
+			shard.capacity = numberOfRecordsPerShard;
+			unsigned char header[SIZE_OF_HEADER_OF_SHARD] = { 'C', 'T', 'N', 'R' };
+			uint32_t version = VERSION_OF_FORMAT_OF_SHARD;
+			uint32_t sizeOfRecord = sizeof(ReplayRecord);
+			uint32_t capacity = static_cast<uint32_t>(shard.capacity);
+			std::memcpy(header + 4, &version, 4);
+			std::memcpy(header + 8, &sizeOfRecord, 4);
+			std::memcpy(header + 12, &capacity, 4);
+			std::ofstream file(shard.path, std::ios::binary | std::ios::app);
+			file.write(reinterpret_cast<const char*>(header), SIZE_OF_HEADER_OF_SHARD);
+			if (!file) {
+				throw std::runtime_error("Shard " + shard.path + " could not be created.");
+			}
+			vectorOfShards.push_back(std::move(shard));
+		}
+
+		void deleteShardsOutsideWindow() {
+			int64_t indexOfStartOfWindow = getIndexOfEndOfRecords() - sizeOfWindow;
+			while (vectorOfShards.size() > 1 && vectorOfShards.front().indexOfFirstRecord + vectorOfShards.front().numberOfRecords <= indexOfStartOfWindow) {
+				Shard& shard = vectorOfShards.front();
+				shard.memoryMappedFile.close();
+				std::error_code errorCode;
+				std::filesystem::remove(shard.path, errorCode);
+				if (errorCode) {
+					Logger::warn("ReplayBuffer", "Shard " + shard.path + " could not be deleted: " + errorCode.message());
+				}
+				vectorOfShards.erase(vectorOfShards.begin());
+			}
+		}
+
+		// Method `readRecord` copies a record out of the mapping of its shard, mapping the shard again if it has grown.
+		void readRecord(int64_t indexOfRecord, ReplayRecord& record) {
+			auto iterator = std::upper_bound(
+				vectorOfShards.begin(),
+				vectorOfShards.end(),
+				indexOfRecord,
+				[](int64_t index, const Shard& shard) { return index < shard.indexOfFirstRecord; }
+			);
+			Shard& shard = *(iterator - 1);
+			size_t offset = SIZE_OF_HEADER_OF_SHARD + static_cast<size_t>(indexOfRecord - shard.indexOfFirstRecord) * sizeof(ReplayRecord);
+			if (offset + sizeof(ReplayRecord) > shard.memoryMappedFile.getSize()) {
+				shard.memoryMappedFile = MemoryMappedFile(shard.path);
+			}
+			std::memcpy(&record, shard.memoryMappedFile.getData() + offset, sizeof(ReplayRecord));
+		}
+	};
+
+}
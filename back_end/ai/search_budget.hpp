@@ -0,0 +1,58 @@
+#pragma once
+
+
+#include <atomic>
+#include <chrono>
+
+
+namespace AI {
+
+	/* Structure `SearchBudget` bounds a run of MCTS by a number of simulations, by wall clock time, by a number of nodes, or by any combination,
+	* whichever is exhausted first. A bound of 0 is no bound. At least one bound must be positive.
+	* A search also stops early when `cancellationFlag` points to a flag that becomes true.
+	* When `stopsEarlyWhenLeadIsUnassailable` is true and the number of simulations is bounded, a search stops as soon as
+	* the most visited child of the root leads the second most visited child by more than the number of remaining simulations,
+	* since the remaining simulations can no longer change the move that is returned.
+	*/
+	struct SearchBudget {
+		int numberOfSimulations{ 0 };
+		int timeLimitInMilliseconds{ 0 };
+		int maximumNumberOfNodes{ 0 };
+		const std::atomic<bool>* cancellationFlag{ nullptr };
+		bool stopsEarlyWhenLeadIsUnassailable{ false };
+
+		bool isBounded() const {
+			return numberOfSimulations > 0 || timeLimitInMilliseconds > 0 || maximumNumberOfNodes > 0;
+		}
+
+		bool isCancelled() const {
+			return cancellationFlag != nullptr && cancellationFlag->load(std::memory_order_relaxed);
+		}
+
+		bool isExhausted(int numberOfSimulationsRun, int numberOfNodesCreated, std::chrono::steady_clock::time_point timeOfStart) const {
+			if (isCancelled()) {
+				return true;
+			}
+			if (numberOfSimulations > 0 && numberOfSimulationsRun >= numberOfSimulations) {
+				return true;
+			}
+			if (maximumNumberOfNodes > 0 && numberOfNodesCreated >= maximumNumberOfNodes) {
+				return true;
+			}
+			if (timeLimitInMilliseconds > 0 && std::chrono::steady_clock::now() - timeOfStart >= std::chrono::milliseconds(timeLimitInMilliseconds)) {
+				return true;
+			}
+			return false;
+		}
+
+		// Method `leadIsUnassailable` returns whether the lead of the most visited child of the root can no longer be overtaken.
+		bool leadIsUnassailable(int numberOfSimulationsRun, int visitCountOfMostVisitedChild, int visitCountOfSecondMostVisitedChild) const {
+			if (!stopsEarlyWhenLeadIsUnassailable || numberOfSimulations <= 0) {
+				return false;
+			}
+			int numberOfRemainingSimulations = numberOfSimulations - numberOfSimulationsRun;
+			return visitCountOfMostVisitedChild - visitCountOfSecondMostVisitedChild > numberOfRemainingSimulations;
+		}
+	};
+
+}
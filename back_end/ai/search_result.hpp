@@ -0,0 +1,22 @@
+#pragma once
+
+
+#include "action_space.hpp"
+#include <string>
+
+
+namespace AI {
+
+	/* Structure `SearchResult` holds the move chosen by a search and the distribution of visits of the children of the root,
+	* which is the target policy of the position when the search is part of self play.
+	* `numberOfSimulations` is the number of simulations the search ran, which may be less than its budget when the search stopped early.
+	*/
+	struct SearchResult {
+		std::string move;
+		std::string moveType;
+		int visitCount{ 0 };
+		VisitDistribution visitDistribution;
+		int numberOfSimulations{ 0 };
+	};
+
+}
@@ -1,9 +1,12 @@
 #pragma once
 
 
-#include "../db/Database.hpp"
+#include "../game/board_layout.hpp"
 #include "../game/game_state.hpp"
+#include "../logger.hpp"
 #include "neural_network.hpp"
+#include "../random.hpp"
+#include "replay_buffer.hpp"
 #include "strategy.hpp"
 
 
@@ -14,48 +17,99 @@ namespace AI {
     // TODO: Consider recording additional data such as full game trajectory, move probabilities, and/or everything about the board and structures on the board.
     struct TrainingExample {
         int player; // player represents player who made move.
-        GameState gameState; // `gameState` represents snapshot of game state after move.
+        GameState gameState; // `gameState` represents snapshot of game state in which the move was searched, before the move.
         std::string move; // move represents label of vertex at which settlement or city is placed or edge at which road is placed.
 		std::string moveType; // moveType represents type of move (e.g., settlement, city, road).
         double value; // value represents target value (e.g., game outcome from perspective of current player).
         double policy; // policy represents target prior probability derived from numbers of visits to nodes that occur during Monte Carlo Tree Search.
+        VisitDistribution visitDistribution; // visitDistribution represents fractions of visits of all children of the root of the search.
     };
 
+    // Structure `StatisticsOfSelfPlayGame` counts the work of a game of self play, so that throughput can be measured.
+    struct StatisticsOfSelfPlayGame {
+        int numberOfMoves{ 0 };
+        long long numberOfSimulations{ 0 };
+    };
+
+    /* Function `applyMoveOfSearch` applies a move returned by `runMcts` for a player to a game state
+    * without touching the database, as self play and the arena do.
+    */
+    void applyMoveOfSearch(GameState& gameState, int player, const std::string& labelOfVertexOrEdge, const std::string& moveType) {
+        if (moveType == "pass") {
+            gameState.updatePhase();
+        }
+        else if (moveType == "settlement") {
+            gameState.placeSettlement(player, labelOfVertexOrEdge);
+        }
+        else if (moveType == "city") {
+            gameState.placeCity(player, labelOfVertexOrEdge);
+        }
+        else if (moveType == "road") {
+            gameState.placeRoad(player, labelOfVertexOrEdge);
+        }
+        else if (moveType == "wall") {
+            gameState.placeCityWall(player, labelOfVertexOrEdge);
+        }
+        else {
+            throw std::runtime_error("[SELF PLAY] " + moveType + " is not a valid move type.");
+        }
+    }
+
     /* Function `runSelfPlayGame` simulates a complete game trajectory
     * by repeatedly using Monte Carlo Tree Search to select a move and by updating the game state
     * until the game reaches the done phase when setup is complete.
+    * Dice and Dirichlet noise are drawn from the stream of self play with index `indexOfGame`, so a game is reproducible from the seed.
+    * The tree of each search is kept through the move made and the sum of the dice rolled, so the next search starts with its visits.
+    * If `randomizesBoardLayout` is true, the game is played on a random layout of resources and tokens drawn from the same stream,
+    * so that the network does not learn only the default board.
+    * If `statistics` is not null, it receives the numbers of moves made and simulations run.
     */
     std::vector<TrainingExample> runSelfPlayGame(
+        uint64_t indexOfGame,
         AI::WrapperOfNeuralNetwork& neuralNet,
         int numberOfSimulations,
         double cPuct,
         double tolerance,
 		double dirichletMixingWeight,
-		double dirichletShape
+		double dirichletShape,
+        bool randomizesBoardLayout,
+        StatisticsOfSelfPlayGame* statistics = nullptr
     ) {
         Logger::info("[SELF PLAY GAME] A self play game is running.");
+        Random::ScopedStream scopedStream(Random::createStream(Random::Purpose::SelfPlay, indexOfGame));
         std::vector<TrainingExample> vectorOfTrainingExamples;
         // Initialize game state using default settings, including initial phase `Phase::TO_PLACE_FIRST_SETTLEMENT`.
         GameState gameState;
+        if (randomizesBoardLayout) {
+            gameState.setBoardLayout(Game::createRandomBoardLayout(Random::getGeneratorOfThread()));
+        }
+        MCTS::SearchTree searchTree;
         // Simulate moves until phase becomes `Phase::DONE`, or up to a maximum number of moves to safeguard against infinite loops.
         int numberOfMovesSimulated = 0;
+        long long numberOfSimulationsRun = 0;
         while (gameState.phase != Game::Phase::Done && numberOfMovesSimulated < MAXIMUM_NUMBER_OF_MOVES) {
 
             if (gameState.phase == Game::Phase::RollDice) {
                 gameState.rollDice();
-                Logger::info(
-                    "    [SELF PLAY PHASE] Player " + std::to_string(gameState.currentPlayer) + " rolling the dice was simulated."
-                    /*"    Yellow and red production and white event dice had values " +
-					std::to_string(gameState.yellowProductionDie) + ", " +
-                    std::to_string(gameState.redProductionDie) + ", and " +
-                    gameState.whiteEventDie + "."*/
-                );
+                // The message is built only when debug records are written, since dice are rolled many times per game.
+                if (Logger::isEnabled(Logger::Level::Debug)) {
+                    Logger::debug(
+                        "    [SELF PLAY PHASE] Player " + std::to_string(gameState.currentPlayer) + " rolling the dice was simulated."
+                        /*"    Yellow and red production and white event dice had values " +
+					    std::to_string(gameState.yellowProductionDie) + ", " +
+                        std::to_string(gameState.redProductionDie) + ", and " +
+                        gameState.whiteEventDie + "."*/
+                    );
+                }
                 gameState.updatePhase();
+                searchTree.advanceThroughRoll(gameState);
                 continue;
             }
 
             int currentPlayer = gameState.currentPlayer;
-            auto [labelOfVertexOrEdgeKey, moveType, visitCount] = runMcts(
+            GameState gameStateBeforeMove = gameState;
+            auto [labelOfVertexOrEdgeKey, moveType, visitCount, visitDistribution, numberOfSimulationsOfSearch] = runMcts(
+                searchTree,
                 gameState,
                 neuralNet,
                 numberOfSimulations,
@@ -68,33 +122,27 @@ namespace AI {
                 throw std::runtime_error("[SELF PLAY] MCTS did not return a valid move.");
             }
 
-            if (moveType == "pass") {
-                gameState.updatePhase();
-            }
-            else if (moveType == "settlement") {
-                gameState.placeSettlement(currentPlayer, labelOfVertexOrEdgeKey);
-            }
-			else if (moveType == "city") {
-				gameState.placeCity(currentPlayer, labelOfVertexOrEdgeKey);
-			}
-			else if (moveType == "road") {
-				gameState.placeRoad(currentPlayer, labelOfVertexOrEdgeKey);
-			}
-            else if (moveType == "wall") {
-				gameState.placeCityWall(currentPlayer, labelOfVertexOrEdgeKey);
-            }
-			else {
-				throw std::runtime_error("[SELF PLAY] " + moveType + " is not a valid move type.");
+            applyMoveOfSearch(gameState, currentPlayer, labelOfVertexOrEdgeKey, moveType);
+            searchTree.advance(labelOfVertexOrEdgeKey);
+            // A kept tree has visits from earlier searches, so the target is the fraction of visits of the root rather than visits per simulation.
+            const int indexOfAction = getIndexOfAction(labelOfVertexOrEdgeKey, moveType);
+            double fractionOfVisits = 0.0;
+            for (const auto& [indexOfVisitedAction, probability] : visitDistribution) {
+                if (indexOfVisitedAction == indexOfAction) {
+                    fractionOfVisits = probability;
+                }
             }
             TrainingExample trainingExample;
             trainingExample.player = currentPlayer;
-            trainingExample.gameState = gameState;
+            trainingExample.gameState = std::move(gameStateBeforeMove);
             trainingExample.move = labelOfVertexOrEdgeKey;
             trainingExample.moveType = moveType;
             trainingExample.value = 0.0; // temporary dummy value that will be updated once game outcome is known
-            trainingExample.policy = static_cast<double>(visitCount) / static_cast<double>(numberOfSimulations); // prior probability of visit
+            trainingExample.policy = fractionOfVisits; // prior probability of visit
+            trainingExample.visitDistribution = std::move(visitDistribution);
             vectorOfTrainingExamples.push_back(trainingExample);
             numberOfMovesSimulated++;
+            numberOfSimulationsRun += numberOfSimulationsOfSearch;
         }
         for (TrainingExample& trainingExample : vectorOfTrainingExamples) {
             trainingExample.value = (trainingExample.player == gameState.winner) ? 1.0 : -1.0;
@@ -103,8 +151,31 @@ namespace AI {
             "[SELF PLAY] Game simulation completed in " + std::to_string(numberOfMovesSimulated) + " moves " +
             "with winner Player " + std::to_string(gameState.winner) + "."
         );
+        if (statistics != nullptr) {
+            statistics->numberOfMoves = numberOfMovesSimulated;
+            statistics->numberOfSimulations = numberOfSimulationsRun;
+        }
 
         return vectorOfTrainingExamples;
     }
 
+
+    // Function `encodeReplayRecords` encodes the training examples of a game of self play as records of the replay buffer.
+    std::vector<ReplayRecord> encodeReplayRecords(const std::vector<TrainingExample>& vectorOfTrainingExamples) {
+        std::vector<ReplayRecord> vectorOfReplayRecords;
+        vectorOfReplayRecords.reserve(vectorOfTrainingExamples.size());
+        for (const TrainingExample& trainingExample : vectorOfTrainingExamples) {
+            vectorOfReplayRecords.push_back(encodeReplayRecord(
+                trainingExample.player,
+                trainingExample.gameState,
+                trainingExample.move,
+                trainingExample.moveType,
+                trainingExample.value,
+                trainingExample.policy,
+                trainingExample.visitDistribution
+            ));
+        }
+        return vectorOfReplayRecords;
+    }
+
 }
\ No newline at end of file
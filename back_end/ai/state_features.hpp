@@ -0,0 +1,80 @@
+#pragma once
+
+
+#include <algorithm>
+#include "../game/board_layout.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include "../game/game_state.hpp"
+#include "../game/labels.hpp"
+#include "../game/phase.hpp"
+#include "replay_buffer.hpp"
+#include <vector>
+
+
+namespace AI {
+
+	constexpr int NUMBER_OF_PHASES = static_cast<int>(Game::Phase::Done) + 1;
+	constexpr int NUMBER_OF_FEATURES_OF_STRUCTURES_OF_PLAYER = 3 * Game::NUMBER_OF_VERTICES + Game::NUMBER_OF_EDGES;
+	// A hex is described by a one hot encoding of its resource, including nothing, and its number of pips.
+	constexpr int NUMBER_OF_FEATURES_OF_HEX = static_cast<int>(Game::Resource::Wool) + 2;
+	constexpr int NUMBER_OF_FEATURES_OF_BOARD_LAYOUT = Game::NUMBER_OF_HEXES * NUMBER_OF_FEATURES_OF_HEX;
+	constexpr int NUMBER_OF_FEATURES_OF_STATE =
+		ReplayRecord::NUMBER_OF_PLAYERS * (NUMBER_OF_FEATURES_OF_STRUCTURES_OF_PLAYER + 8) + NUMBER_OF_PHASES + NUMBER_OF_FEATURES_OF_BOARD_LAYOUT;
+
+	/* Function `writeFeaturesOfBoardLayout` writes `NUMBER_OF_FEATURES_OF_BOARD_LAYOUT` bytes describing the hexes of a layout in order of index.
+	* The number of pips of a token from 2 to 12 is the number of ways in 36 that two dice roll it, 6 - |7 - token|; other hexes have 0 pips.
+	*/
+	void writeFeaturesOfBoardLayout(const Game::BoardLayout& boardLayout, uint8_t* features) {
+		std::fill(features, features + NUMBER_OF_FEATURES_OF_BOARD_LAYOUT, uint8_t{ 0 });
+		for (int indexOfHex = 0; indexOfHex < Game::NUMBER_OF_HEXES; indexOfHex++) {
+			uint8_t* featuresOfHex = features + indexOfHex * NUMBER_OF_FEATURES_OF_HEX;
+			featuresOfHex[static_cast<int>(boardLayout.resourcesOfHexes[indexOfHex])] = 1;
+			const int numberOfToken = boardLayout.numbersOfTokensOfHexes[indexOfHex];
+			if (boardLayout.resourcesOfHexes[indexOfHex] != Game::Resource::Nothing && numberOfToken >= 2 && numberOfToken <= Game::MAXIMUM_SUM_OF_DICE) {
+				featuresOfHex[NUMBER_OF_FEATURES_OF_HEX - 1] = static_cast<uint8_t>(6 - std::abs(7 - numberOfToken));
+			}
+		}
+	}
+
+	/* Function `writeStateFeatures` writes `NUMBER_OF_FEATURES_OF_STATE` bytes describing the game state of a replay record
+	* from the perspective of a player, for networks that predict a policy over all actions from a state.
+	* Players are ordered starting with the perspective player, so the same position is described the same way for every seat.
+	* For each player in that order, there are 54 bytes of settlements, 54 of cities, 54 of walls, and 72 of roads, each 0 or 1.
+	* Then there are 8 counts of resources per player in the same order, clamped to [0, 255], a one hot encoding of the phase,
+	* and the features of the layout of the board.
+	*/
+	void writeStateFeatures(const ReplayRecord& record, int perspectivePlayer, uint8_t* features) {
+		std::fill(features, features + NUMBER_OF_FEATURES_OF_STATE, uint8_t{ 0 });
+		uint8_t* featuresOfResources = features + ReplayRecord::NUMBER_OF_PLAYERS * NUMBER_OF_FEATURES_OF_STRUCTURES_OF_PLAYER;
+		for (int offset = 0; offset < ReplayRecord::NUMBER_OF_PLAYERS; offset++) {
+			int indexOfPlayer = (perspectivePlayer - 1 + offset) % ReplayRecord::NUMBER_OF_PLAYERS;
+			uint8_t* featuresOfPlayer = features + offset * NUMBER_OF_FEATURES_OF_STRUCTURES_OF_PLAYER;
+			for (int indexOfVertex = 0; indexOfVertex < Game::NUMBER_OF_VERTICES; indexOfVertex++) {
+				featuresOfPlayer[indexOfVertex] = (record.masksOfSettlements[indexOfPlayer] >> indexOfVertex) & 1;
+				featuresOfPlayer[Game::NUMBER_OF_VERTICES + indexOfVertex] = (record.masksOfCities[indexOfPlayer] >> indexOfVertex) & 1;
+				featuresOfPlayer[2 * Game::NUMBER_OF_VERTICES + indexOfVertex] = (record.masksOfWalls[indexOfPlayer] >> indexOfVertex) & 1;
+			}
+			for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+				featuresOfPlayer[3 * Game::NUMBER_OF_VERTICES + indexOfEdge] = (record.masksOfRoads[indexOfPlayer][indexOfEdge / 64] >> (indexOfEdge % 64)) & 1;
+			}
+			for (int i = 0; i < 8; i++) {
+				featuresOfResources[offset * 8 + i] = static_cast<uint8_t>(std::clamp<int>(record.resources[indexOfPlayer][i], 0, 255));
+			}
+		}
+		if (record.phase < NUMBER_OF_PHASES) {
+			featuresOfResources[ReplayRecord::NUMBER_OF_PLAYERS * 8 + record.phase] = 1;
+		}
+		writeFeaturesOfBoardLayout(record.getBoardLayout(), featuresOfResources + ReplayRecord::NUMBER_OF_PLAYERS * 8 + NUMBER_OF_PHASES);
+	}
+
+	// Function `getStateFeatures` returns the features of a game state from the perspective of a player as floats for inference.
+	std::vector<float> getStateFeatures(const GameState& gameState, int perspectivePlayer) {
+		ReplayRecord record{};
+		encodeGameState(gameState, record);
+		uint8_t features[NUMBER_OF_FEATURES_OF_STATE];
+		writeStateFeatures(record, perspectivePlayer, features);
+		return std::vector<float>(features, features + NUMBER_OF_FEATURES_OF_STATE);
+	}
+
+}
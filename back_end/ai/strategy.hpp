@@ -1,30 +1,38 @@
 #pragma once
 
 
-#include "../db/database.hpp"
+#include <algorithm>
 #include "mcts/backpropagation.hpp"
+#include <chrono>
 #include "mcts/expansion.hpp"
+#include "../metrics.hpp"
 #include "neural_network.hpp"
+#include "../random.hpp"
+#include "search_budget.hpp"
+#include "search_result.hpp"
+#include "mcts/search_tracer.hpp"
+#include "mcts/search_tree.hpp"
 #include "mcts/selection.hpp"
 #include "mcts/simulation.hpp"
+#include <stdexcept>
 
 
 /* Function `injectDirichletNoise` injects Dirichlet noise at the root to encourage exploration
 * by changing the prior probabilities of the children of the root.
+* Noise is drawn from the generator of the calling thread, so a game of self play with a seeded stream is reproducible.
 */
 void injectDirichletNoise(AI::MCTS::MCTSNode* root, double mixingWeight, double shape) {
 	if (root->unorderedMapOfMovesToChildren.empty()) {
 		return;
 	}
 	std::vector<double> vectorOfNoise;
-	std::random_device::result_type randomDevice = std::random_device{}();
-	std::default_random_engine defaultRandomEngine(randomDevice);
+	Random::Xoshiro256PlusPlus& generator = Random::getGeneratorOfThread();
 	double scale = 1.0;
 	std::gamma_distribution<double> gammaDistribution(shape, scale);
 
 	double sumOfNoise = 0.0;
 	for (const auto& pair : root->unorderedMapOfMovesToChildren) {
-		double noise = gammaDistribution(defaultRandomEngine);
+		double noise = gammaDistribution(generator);
 		vectorOfNoise.push_back(noise);
 		sumOfNoise += noise;
 	}
@@ -58,19 +66,33 @@ bool comparePairsOfMovesAndChildren(
 }
 
 
-/* Function `runMcts` runs MCTS by creating a root node from the current game state,
-* running a number of simulations, and returning the best move.
+/* Function `runMcts` runs MCTS from the root of `searchTree` for the current game state,
+* running simulations until `searchBudget` is exhausted, and returning the best move with the distribution of visits of the children of the root.
+* The root is the subtree kept from earlier searches of the same game when `searchTree` was advanced through the moves and rolls since, or a new node.
+* Simulations pass through chance nodes for rolls of the dice, so a search plans for every sum the next player may roll.
+* The search is anytime: when a deadline or a budget of nodes is reached, the best move found so far is returned.
+* If the search is cancelled, the best move found so far is returned and callers should check the flag of cancellation.
+* If `searchTracer` is not null, sampled simulations are recorded with their paths and the durations of their phases.
 */
-std::tuple<std::string, std::string, int> runMcts(
+AI::SearchResult runMcts(
+	AI::MCTS::SearchTree& searchTree,
 	const GameState& currentState,
 	AI::WrapperOfNeuralNetwork& neuralNet,
-	int numberOfSimulations,
+	const AI::SearchBudget& searchBudget,
 	double cPuct,
 	double tolerance,
 	double dirichletMixingWeight,
-	double dirichletShape
+	double dirichletShape,
+	AI::MCTS::SearchTracer* searchTracer = nullptr
 ) {
-	//Logger::info("        [MCTS] MCTS is being started.");
+	if (!searchBudget.isBounded()) {
+		throw std::invalid_argument("A search budget must have a positive number of simulations or a positive time limit.");
+	}
+	if (currentState.phase == Game::Phase::RollDice) {
+		throw std::invalid_argument("The dice must be rolled before a search for a move.");
+	}
+	std::chrono::steady_clock::time_point timeOfStart = std::chrono::steady_clock::now();
+	// Nodes are numbered from 0 in each search, so the next index is the number of nodes created so far.
 	AI::MCTS::MCTSNode::nextIndex = 0;
 
 	// Create root node for current phase.
@@ -87,42 +109,69 @@ std::tuple<std::string, std::string, int> runMcts(
 	else if (currentState.phase == Game::Phase::Turn) {
 		moveType = "turn";
 	}
-	std::unique_ptr<AI::MCTS::MCTSNode> root = std::make_unique<AI::MCTS::MCTSNode>(currentState, "", nullptr, moveType);
+	AI::MCTS::MCTSNode* root = searchTree.getRoot(currentState, moveType);
 
-	//Logger::info("            [EXPAND ROOT] The root is being expanded.");
-	//Logger::info("            [EXPAND ROOT] The following root is being expanded.\n            " + root->toJson().dump());
-	expandNode(root.get(), neuralNet);
-	//Logger::info("            [EXPAND ROOT] The root was expanded into the following.\n            " + root->toJson().dump());
+	if (root->isLeaf()) {
+		expandNode(root, neuralNet);
+	}
 
-	injectDirichletNoise(root.get(), dirichletMixingWeight, dirichletShape);
+	injectDirichletNoise(root, dirichletMixingWeight, dirichletShape);
 
-	for (int i = 0; i < numberOfSimulations; i++) {
-		//Logger::info("            [MCTS SIMULATION] MCTS simulation " + std::to_string(i + 1) + " of " + std::to_string(numberOfSimulations) + " is running.");
-		//Logger::info("                [MCTS SIMULATION] Node node is being set to root.");
-		AI::MCTS::MCTSNode* node = root.get();
-		//if (node->isLeaf()) {
-		//    Logger::info("                [SELECT NO NODE] Node node is leaf and will not be reset to a child.");
-		//}
+	if (searchTracer != nullptr) {
+		searchTracer->beginSearch(moveType, timeOfStart);
+	}
+	int numberOfSimulationsRun = 0;
+	for (int i = 0; !searchBudget.isExhausted(i, AI::MCTS::MCTSNode::nextIndex, timeOfStart); i++) {
+		if (i > 0 && searchBudget.stopsEarlyWhenLeadIsUnassailable) {
+			int visitCountOfMostVisitedChild = 0;
+			int visitCountOfSecondMostVisitedChild = 0;
+			for (const auto& [move, child] : root->unorderedMapOfMovesToChildren) {
+				if (child->visitCount > visitCountOfMostVisitedChild) {
+					visitCountOfSecondMostVisitedChild = visitCountOfMostVisitedChild;
+					visitCountOfMostVisitedChild = child->visitCount;
+				}
+				else if (child->visitCount > visitCountOfSecondMostVisitedChild) {
+					visitCountOfSecondMostVisitedChild = child->visitCount;
+				}
+			}
+			if (searchBudget.leadIsUnassailable(i, visitCountOfMostVisitedChild, visitCountOfSecondMostVisitedChild)) {
+				break;
+			}
+		}
+		const bool simulationIsTraced = searchTracer != nullptr && searchTracer->isSampled(i);
+		AI::MCTS::SearchTracer::TimesOfSimulation timesOfSimulation;
+		if (simulationIsTraced) {
+			timesOfSimulation[0] = std::chrono::steady_clock::now();
+		}
+		AI::MCTS::MCTSNode* node = root;
 		while (!node->isLeaf()) {
-			node = AI::MCTS::selectChild(node, cPuct, tolerance);
-			//Logger::info("                [SELECT NODE] Node node was not leaf and was reset to a child.");
-			//Logger::info("                [SELECT NODE] Node node was not leaf and was reset to the following child.\n                " + node->toJson().dump());
+			node = AI::MCTS::isChanceNode(node) ? AI::MCTS::selectOutcome(node) : AI::MCTS::selectChild(node, cPuct, tolerance);
+		}
+		if (simulationIsTraced) {
+			timesOfSimulation[1] = std::chrono::steady_clock::now();
 		}
-		//if (node->N > 0) {
-		//    Logger::info("                [EXPAND NO NODE] Node node was visited before and was not expanded.");
-		//}
-		//else {
+		size_t widthOfExpansion = 0;
 		if (node->visitCount == 0) {
 			expandNode(node, neuralNet);
-			//Logger::info("                [EXPAND NODE] Node node was not visited before and was expanded.");
-			//Logger::info("                [EXPAND NODE] Node node was not visited before and was expanded into the following.\n                " + node->toJson().dump());
+			widthOfExpansion = node->unorderedMapOfMovesToChildren.size();
+		}
+		if (simulationIsTraced) {
+			timesOfSimulation[2] = std::chrono::steady_clock::now();
 		}
 		double value = rollout(node, neuralNet);
-		//Logger::info("                [ROLLOUT] The value of node node is " + std::to_string(value) + ".");
+		if (simulationIsTraced) {
+			timesOfSimulation[3] = std::chrono::steady_clock::now();
+		}
 		backpropagate(node, value);
-		//Logger::info("                [BACKPROPAGATION] Statistics of node node and all parents were updated.");
+		if (simulationIsTraced) {
+			timesOfSimulation[4] = std::chrono::steady_clock::now();
+			searchTracer->recordSimulation(i, node, widthOfExpansion, value, timesOfSimulation);
+		}
+		numberOfSimulationsRun++;
+	}
+	if (searchTracer != nullptr) {
+		searchTracer->endSearch(numberOfSimulationsRun);
 	}
-
 
 	auto iterator = std::max_element(
 		root->unorderedMapOfMovesToChildren.begin(),
@@ -134,9 +183,84 @@ std::tuple<std::string, std::string, int> runMcts(
 	}
 	AI::MCTS::MCTSNode* bestChild = iterator->second.get();
 
+	AI::SearchResult searchResult;
+	searchResult.move = bestChild->move;
+	searchResult.moveType = bestChild->moveType;
+	searchResult.visitCount = bestChild->visitCount;
+	searchResult.numberOfSimulations = numberOfSimulationsRun;
+	static Metrics::Counter& counterOfSimulations = Metrics::Registry::getInstance().getCounter(
+		"catan_mcts_simulations_total",
+		"Number of simulations run by MCTS."
+	);
+	static Metrics::Histogram& histogramOfDurationsOfSearches = Metrics::Registry::getInstance().getHistogram(
+		"catan_mcts_search_duration_seconds",
+		"Seconds of each search of MCTS for a move.",
+		Metrics::BUCKETS_OF_LATENCIES
+	);
+	counterOfSimulations.increment(static_cast<uint64_t>(numberOfSimulationsRun));
+	histogramOfDurationsOfSearches.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - timeOfStart).count());
+	int totalVisitCount = 0;
+	for (const auto& [move, child] : root->unorderedMapOfMovesToChildren) {
+		totalVisitCount += child->visitCount;
+	}
+	if (totalVisitCount > 0) {
+		for (const auto& [move, child] : root->unorderedMapOfMovesToChildren) {
+			if (child->visitCount > 0) {
+				searchResult.visitDistribution.emplace_back(
+					AI::getIndexOfAction(child->move, child->moveType),
+					static_cast<float>(child->visitCount) / static_cast<float>(totalVisitCount)
+				);
+			}
+		}
+		std::sort(searchResult.visitDistribution.begin(), searchResult.visitDistribution.end());
+	}
+	return searchResult;
+}
+
 
-	//Logger::info("            [SELECT BEST CHILD] The best child has move " + bestChild->move + ".");
-	//Logger::info("            [SELECT BEST CHILD] The best child has move type " + bestChild->moveType + ".");
-	//Logger::info("            [SELECT BEST CHILD] The child of the root with the highest visit count is the following.\n" + bestChild->toJson().dump());
-	return std::make_tuple(bestChild->move, bestChild->moveType, bestChild->visitCount);
+// Function `runMcts` runs MCTS from a new root for the current game state.
+AI::SearchResult runMcts(
+	const GameState& currentState,
+	AI::WrapperOfNeuralNetwork& neuralNet,
+	const AI::SearchBudget& searchBudget,
+	double cPuct,
+	double tolerance,
+	double dirichletMixingWeight,
+	double dirichletShape,
+	AI::MCTS::SearchTracer* searchTracer = nullptr
+) {
+	AI::MCTS::SearchTree searchTree;
+	return runMcts(searchTree, currentState, neuralNet, searchBudget, cPuct, tolerance, dirichletMixingWeight, dirichletShape, searchTracer);
+}
+
+
+// Function `runMcts` runs MCTS from the root of `searchTree` with a budget of a fixed number of simulations.
+AI::SearchResult runMcts(
+	AI::MCTS::SearchTree& searchTree,
+	const GameState& currentState,
+	AI::WrapperOfNeuralNetwork& neuralNet,
+	int numberOfSimulations,
+	double cPuct,
+	double tolerance,
+	double dirichletMixingWeight,
+	double dirichletShape
+) {
+	AI::SearchBudget searchBudget;
+	searchBudget.numberOfSimulations = numberOfSimulations;
+	return runMcts(searchTree, currentState, neuralNet, searchBudget, cPuct, tolerance, dirichletMixingWeight, dirichletShape);
+}
+
+
+// Function `runMcts` runs MCTS from a new root with a budget of a fixed number of simulations.
+AI::SearchResult runMcts(
+	const GameState& currentState,
+	AI::WrapperOfNeuralNetwork& neuralNet,
+	int numberOfSimulations,
+	double cPuct,
+	double tolerance,
+	double dirichletMixingWeight,
+	double dirichletShape
+) {
+	AI::MCTS::SearchTree searchTree;
+	return runMcts(searchTree, currentState, neuralNet, numberOfSimulations, cPuct, tolerance, dirichletMixingWeight, dirichletShape);
 }
\ No newline at end of file
@@ -1,8 +1,18 @@
 #pragma once
 
 
-#include "../db/database.hpp"
+#include "arena.hpp"
+#include "batch_loader.hpp"
+#include <algorithm>
+#include "checkpoint_manager.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include "../metrics.hpp"
 #include "neural_network.hpp"
+#include "packed_training_examples.hpp"
+#include "../random.hpp"
+#include "replay_buffer.hpp"
 #include "self_play.hpp"
 
 
@@ -12,6 +22,9 @@ namespace AI {
     public:
         Trainer(
             AI::WrapperOfNeuralNetwork* neuralNetToUse,
+            AI::ReplayBuffer* replayBufferToUse,
+            AI::CheckpointManager* checkpointManagerToUse,
+            const AI::Arena* arenaToUse,
             int modelWatcherIntervalToUse,
             int trainingThresholdToUse,
             int numberOfSimulationsToUse,
@@ -21,8 +34,14 @@ namespace AI {
 			int numberOfEpochsToUse,
             int batchSizeToUse,
 			double dirichletMixingWeightToUse,
-			double dirichletShapeToUse
+			double dirichletShapeToUse,
+            int numberOfSamplesPerTrainingToUse,
+            SamplingOfReplayBuffer samplingOfReplayBufferToUse,
+            bool randomizesBoardLayoutsToUse
         ) : neuralNet(neuralNetToUse),
+            replayBuffer(replayBufferToUse),
+            checkpointManager(checkpointManagerToUse),
+            arena(arenaToUse),
             modelWatcherInterval(modelWatcherIntervalToUse),
             trainingThreshold(trainingThresholdToUse),
             numberOfSimulations(numberOfSimulationsToUse),
@@ -32,7 +51,10 @@ namespace AI {
 			numberOfEpochs(numberOfEpochsToUse),
 			batchSize(batchSizeToUse),
 			dirichletMixingWeight(dirichletMixingWeightToUse),
-			dirichletShape(dirichletShapeToUse)
+			dirichletShape(dirichletShapeToUse),
+            numberOfSamplesPerTraining(numberOfSamplesPerTrainingToUse),
+            samplingOfReplayBuffer(samplingOfReplayBufferToUse),
+            randomizesBoardLayouts(randomizesBoardLayoutsToUse)
         {
             // Do nothing.
         }
@@ -48,36 +70,72 @@ namespace AI {
             });
         }
 
-        // Function `runTrainingLoop` starts a training loop thread.
+        /* Function `runTrainingLoop` starts a self play thread, which plays games and appends their examples to the replay buffer, and
+        * a training thread, which trains on a sample of the replay buffer whenever enough new examples have been collected.
+        */
         void runTrainingLoop() {
+            prepareTraining();
+            selfPlayThread = std::jthread([this](std::stop_token stopToken) {
+                selfPlayLoop(stopToken);
+            });
             trainingThread = std::jthread([this](std::stop_token stopToken) {
 				trainingLoop(stopToken);
             });
         }
 
-        // Function `stop` stops the model watcher and training threads and joins them to the main thread.
+        // Function `stop` stops the model watcher, self play, and training threads and joins them to the main thread.
         void stop() {
             if (modelWatcherThread.joinable()) {
                 modelWatcherThread.request_stop();
             }
+            if (selfPlayThread.joinable()) {
+                selfPlayThread.request_stop();
+            }
             if (trainingThread.joinable()) {
                 trainingThread.request_stop();
             }
         }
 
     private:
+        std::unique_ptr<torch::optim::Adam> adam;
+        const Arena* arena;
         int batchSize;
-		std::condition_variable trainingConditionVariable;
+        CheckpointManager* checkpointManager;
+        Metrics::Counter& counterOfExamplesOfSelfPlay = Metrics::Registry::getInstance().getCounter(
+            "catan_self_play_examples_total",
+            "Number of training examples appended to the replay buffer by self play."
+        );
+        Metrics::Counter& counterOfGamesOfSelfPlay = Metrics::Registry::getInstance().getCounter(
+            "catan_self_play_games_total",
+            "Number of games of self play completed."
+        );
+        Metrics::Counter& counterOfSamplesTrained = Metrics::Registry::getInstance().getCounter(
+            "catan_training_samples_total",
+            "Number of samples on which the network was trained."
+        );
         double cPuct;
-        std::deque<TrainingExample> trainingQueue;
+        Metrics::Gauge& gaugeOfLoss = Metrics::Registry::getInstance().getGauge(
+            "catan_training_loss",
+            "Average loss of the latest epoch of training."
+        );
         double learningRate;
         int modelWatcherInterval;
         std::jthread modelWatcherThread;
         WrapperOfNeuralNetwork* neuralNet;
         int numberOfEpochs;
+        int numberOfExamplesSinceTraining = 0;
+        int numberOfSamplesPerTraining;
+        uint64_t numberOfSelfPlayGames = 0;
         int numberOfSimulations;
+        uint64_t numberOfTrainings = 0;
+        bool randomizesBoardLayouts;
+        ReplayBuffer* replayBuffer;
+        SamplingOfReplayBuffer samplingOfReplayBuffer;
+        std::jthread selfPlayThread;
         double tolerance;
+        std::condition_variable_any trainingConditionVariable;
         std::mutex trainingMutex;
+        NeuralNetwork trainingNeuralNetwork = nullptr;
         std::jthread trainingThread;
         int trainingThreshold;
 		double dirichletMixingWeight;
@@ -93,158 +151,240 @@ namespace AI {
             }
         }
 
-        /* Function `trainingLoop` runs on a background thread and
-        * continuously runs full self play games to collect training examples and
-        * triggers training when enough examples have been collected.
+        /* Function `prepareTraining` resumes from checkpoints, if any, by loading the parameters of the best checkpoint into the live network,
+        * creating the copy of the network that is trained from the latest checkpoint, and restoring the state of the optimizer.
+        * Without a best checkpoint, as in directories of checkpoints written before the arena, the latest checkpoint is served.
+        * The copy and the optimizer persist across trainings, so the moment estimates of AdaM are kept between trainings and restarts.
         */
-        void trainingLoop(std::stop_token stopToken) {
+        void prepareTraining() {
+            std::optional<Checkpoint> latestCheckpoint = checkpointManager->getLatestCheckpoint();
+            std::optional<Checkpoint> bestCheckpoint = checkpointManager->getBestCheckpoint();
+            std::optional<Checkpoint> checkpointToServe = bestCheckpoint.has_value() ? bestCheckpoint : latestCheckpoint;
+            if (checkpointToServe.has_value()) {
+                neuralNet->loadParameters(checkpointToServe->pathToParameters);
+            }
+            trainingNeuralNetwork = neuralNet->createCopyOfNeuralNetwork();
+            if (latestCheckpoint.has_value() && latestCheckpoint->number != checkpointToServe->number) {
+                std::vector<torch::Tensor> vectorOfTensorsOfState;
+                torch::load(vectorOfTensorsOfState, latestCheckpoint->pathToParameters);
+                copyTensorsOfState(vectorOfTensorsOfState, trainingNeuralNetwork);
+            }
+            adam = std::make_unique<torch::optim::Adam>(trainingNeuralNetwork->parameters(), torch::optim::AdamOptions(learningRate));
+            if (!latestCheckpoint.has_value()) {
+                return;
+            }
+            try {
+                CheckpointManager::loadStateOfOptimizer(*latestCheckpoint, *adam);
+                Logger::info("[TRAINING] Training was resumed from checkpoint " + std::to_string(latestCheckpoint->number) + ".");
+            }
+            catch (const std::exception& e) {
+                Logger::warn("prepareTraining", "State of optimizer could not be restored and will start fresh: " + std::string(e.what()));
+                adam = std::make_unique<torch::optim::Adam>(trainingNeuralNetwork->parameters(), torch::optim::AdamOptions(learningRate));
+            }
+        }
+
+        /* Function `selfPlayLoop` runs on a background thread and
+        * continuously runs full self play games, appends their training examples to the replay buffer, and
+        * wakes the training thread when enough new examples have been collected.
+        */
+        void selfPlayLoop(std::stop_token stopToken) {
             while (!stopToken.stop_requested()) {
                 std::vector<AI::TrainingExample> vectorOfTrainingExamplesFromSelfPlayGame = runSelfPlayGame(
+                    numberOfSelfPlayGames++,
                     *neuralNet,
                     numberOfSimulations,
                     cPuct,
                     tolerance,
                     dirichletMixingWeight,
-                    dirichletShape
+                    dirichletShape,
+                    randomizesBoardLayouts
                 );
+                std::vector<ReplayRecord> vectorOfReplayRecords = encodeReplayRecords(vectorOfTrainingExamplesFromSelfPlayGame);
+                replayBuffer->append(vectorOfReplayRecords);
+                counterOfGamesOfSelfPlay.increment();
+                counterOfExamplesOfSelfPlay.increment(vectorOfReplayRecords.size());
+                bool enoughExamplesHaveBeenCollected = false;
                 {
                     std::lock_guard<std::mutex> lock(trainingMutex);
-                    for (const auto& trainingExample : vectorOfTrainingExamplesFromSelfPlayGame) {
-                        trainingQueue.push_back(trainingExample);
-                    }
+                    numberOfExamplesSinceTraining += static_cast<int>(vectorOfReplayRecords.size());
+                    enoughExamplesHaveBeenCollected = numberOfExamplesSinceTraining >= trainingThreshold;
                 }
-                trainingConditionVariable.notify_one();
+                if (enoughExamplesHaveBeenCollected) {
+                    trainingConditionVariable.notify_one();
+                }
+            }
+        }
+
+        /* Function `trainingLoop` runs on a background thread and
+        * waits until enough new examples have been collected, then trains on a sample of the replay buffer.
+        * Self play continues with the current parameters while the network trains.
+        * A training that throws, for example when a checkpoint cannot be written, is logged and retried on a new sample
+        * after a backoff that doubles with each consecutive failure, since an exception escaping the thread would terminate the server.
+        */
+        void trainingLoop(std::stop_token stopToken) {
+            const std::chrono::seconds durationOfFirstBackoff(1);
+            const std::chrono::seconds durationOfLongestBackoff(60);
+            std::chrono::seconds durationOfBackoff = durationOfFirstBackoff;
+            bool previousTrainingFailed = false;
+            while (!stopToken.stop_requested()) {
                 {
                     std::unique_lock<std::mutex> lock(trainingMutex);
-                    if (trainingQueue.size() < static_cast<size_t>(trainingThreshold)) {
-                        lock.unlock();
-                        continue;
+                    if (previousTrainingFailed) {
+                        trainingConditionVariable.wait_for(lock, stopToken, durationOfBackoff, [] { return false; });
+                        if (stopToken.stop_requested()) {
+                            return;
+                        }
+                    }
+                    else {
+                        bool enoughExamplesHaveBeenCollected = trainingConditionVariable.wait(lock, stopToken, [this] {
+                            return numberOfExamplesSinceTraining >= trainingThreshold;
+                        });
+                        if (!enoughExamplesHaveBeenCollected) {
+                            return;
+                        }
                     }
-                    std::vector<TrainingExample> batch(trainingQueue.begin(), trainingQueue.end());
-                    trainingQueue.clear();
-                    lock.unlock();
-                    trainNeuralNetwork(batch, neuralNet);
+                    numberOfExamplesSinceTraining = 0;
+                }
+                try {
+                    std::vector<ReplayRecord> batch = replayBuffer->sample(numberOfSamplesPerTraining, samplingOfReplayBuffer);
+                    trainNeuralNetwork(batch, neuralNet, stopToken);
+                    previousTrainingFailed = false;
+                    durationOfBackoff = durationOfFirstBackoff;
+                }
+                catch (const std::exception& e) {
+                    Logger::error("trainingLoop", e);
+                    if (previousTrainingFailed) {
+                        durationOfBackoff = std::min(durationOfBackoff * 2, durationOfLongestBackoff);
+                    }
+                    previousTrainingFailed = true;
+                    Logger::warn("trainingLoop", "Training will be retried in " + std::to_string(durationOfBackoff.count()) + " seconds.");
                 }
-                std::this_thread::yield();
-
             }
         }
 
+        /* Function `trainNeuralNetwork` trains the copy of the neural network on replay records with the persistent optimizer and
+        * saves a checkpoint of parameters and state of the optimizer. When the arena is enabled, the checkpoint is a candidate that
+        * plays a match against the live network and is promoted only if it wins enough; otherwise every checkpoint is promoted.
+        * A promoted checkpoint is marked as best and its parameters are copied into the wrapper, which saves them.
+        * A rejected checkpoint is kept as the starting point of the next training, while self play continues with the best parameters.
+        * Mini batches are gathered by a `BatchLoader` on another thread while the previous mini batch trains.
+        */
         void trainNeuralNetwork(
-            const std::vector<AI::TrainingExample>& vectorOfTrainingExamples,
-            AI::WrapperOfNeuralNetwork* wrapperOfNeuralNetwork
+            const std::vector<AI::ReplayRecord>& vectorOfReplayRecords,
+            AI::WrapperOfNeuralNetwork* wrapperOfNeuralNetwork,
+            std::stop_token stopToken
         ) {
-            int numberOfTrainingExamples = vectorOfTrainingExamples.size();
+            int numberOfTrainingExamples = vectorOfReplayRecords.size();
             Logger::info("[TRAINING] Neural network will be trained on " + std::to_string(numberOfTrainingExamples) + " examples.");
 
-			AI::NeuralNetwork neuralNetwork = wrapperOfNeuralNetwork->neuralNetwork;
+			AI::NeuralNetwork neuralNetwork = trainingNeuralNetwork;
 			c10::Device device = neuralNetwork->parameters()[0].device();
 			c10::TensorOptions tensorOptions = torch::TensorOptions().dtype(torch::kFloat32).device(device);
 
-            std::vector<torch::Tensor> vectorOfInputTensors;
-            std::vector<torch::Tensor> vectorOfTensorsOfTargetValues;
-            std::vector<torch::Tensor> vectorOfTensorsOfTargetPolicies;
-
-            Board board;
-            for (const AI::TrainingExample& trainingExample : vectorOfTrainingExamples) {
-				std::string move = trainingExample.move;
-                std::string moveType = trainingExample.moveType;
-                std::vector<float> featureVector = board.getGridRepresentationForMove(move, moveType);
-                torch::Tensor inputTensor = torch::tensor(featureVector, tensorOptions);
-                vectorOfInputTensors.push_back(inputTensor);
-
-                std::vector<double> vectorOfTargetValue = { trainingExample.value };
-                torch::Tensor tensorOfTargetValue = torch::tensor(vectorOfTargetValue, tensorOptions);
-                vectorOfTensorsOfTargetValues.push_back(tensorOfTargetValue);
-
-                std::vector<double> vectorOfTargetPolicy = { trainingExample.policy };
-                torch::Tensor tensorOfTargetPolicy = torch::tensor(vectorOfTargetPolicy, tensorOptions);
-                vectorOfTensorsOfTargetPolicies.push_back(tensorOfTargetPolicy);
-            }
-
-            if (vectorOfInputTensors.empty()) {
+            std::chrono::steady_clock::time_point timeOfStartOfPreprocessing = std::chrono::steady_clock::now();
+            PolicyHead policyHead = wrapperOfNeuralNetwork->getPolicyHead();
+            PackedTrainingExamples packedTrainingExamples = packTrainingExamples(vectorOfReplayRecords, policyHead);
+            if (packedTrainingExamples.numberOfExamples == 0) {
                 throw std::runtime_error("[TRAINING] No training examples are available.");
             }
+            int64_t numberOfExamples = packedTrainingExamples.numberOfExamples;
+            std::chrono::duration<double, std::milli> durationOfPreprocessing = std::chrono::steady_clock::now() - timeOfStartOfPreprocessing;
+            Logger::info("[TRAINING] Preprocessing " + std::to_string(numberOfExamples) + " examples took " + std::to_string(durationOfPreprocessing.count()) + " ms.");
 
-            /* Tensor `inputTensor` has shape[N, 5].
-            * Tensor `tensorOfTargetValues` has shape [N, 1].
-            * Tensor `tensorOfTargetPolicies` has shape [N, 1].
-            */
-            torch::Tensor inputTensor = torch::stack(vectorOfInputTensors).to(device);
-            torch::Tensor tensorOfTargetValues = torch::stack(vectorOfTensorsOfTargetValues).view({ -1, 1 }).to(device);
-            torch::Tensor tensorOfTargetPolicies = torch::stack(vectorOfTensorsOfTargetPolicies).view({ -1, 1 }).to(device);
-
-            {
-				std::lock_guard<std::mutex> netLock(wrapperOfNeuralNetwork->mutex);
-                neuralNetwork->train();
-            }
-
-            // Configure AdaM optimizer.
-            torch::autograd::variable_list variableListOfParameters = neuralNetwork->parameters();
-            torch::optim::AdamOptions adamOptions(learningRate);
-            torch::optim::Adam adam(variableListOfParameters, adamOptions);
-
-            // Define training parameters.
-            int64_t dimension = 0;
-            const int numberOfSamples = inputTensor.size(dimension);
+            neuralNetwork->train();
 
             // Train.
-            for (int indexOfEpoch = 0; indexOfEpoch < numberOfEpochs; indexOfEpoch++) {
-                double runningLoss = 0.0;
-
-                // Create a vector of shuffled indices.
-                std::vector<int64_t> vectorOfIndicesOfSamples(numberOfSamples);
-                int startingValue = 0;
-                std::iota(vectorOfIndicesOfSamples.begin(), vectorOfIndicesOfSamples.end(), startingValue);
-                std::default_random_engine defaultRandomEngine;
-                std::shuffle(vectorOfIndicesOfSamples.begin(), vectorOfIndicesOfSamples.end(), defaultRandomEngine);
-
-                // Process mini batches.
-                for (int indexOfFirstSample = 0; indexOfFirstSample < numberOfSamples; indexOfFirstSample += batchSize) {
-                    int indexOfLastSample = std::min(indexOfFirstSample + batchSize, numberOfSamples);
-                    std::vector<int64_t> vectorOfIndicesOfSamplesInBatch(
-                        vectorOfIndicesOfSamples.begin() + indexOfFirstSample,
-                        vectorOfIndicesOfSamples.begin() + indexOfLastSample
-                    );
-                    torch::TensorOptions optionsForTensorOfIndicesOfSamplesInBatch = torch::TensorOptions().dtype(torch::kInt64).device(device);
-                    torch::Tensor tensorOfIndicesOfSamplesInBatch = torch::tensor(vectorOfIndicesOfSamplesInBatch, optionsForTensorOfIndicesOfSamplesInBatch);
-
-                    torch::Tensor inputTensorForBatch = inputTensor.index_select(dimension, tensorOfIndicesOfSamplesInBatch);
-                    torch::Tensor tensorOfTargetValuesForBatch = tensorOfTargetValues.index_select(dimension, tensorOfIndicesOfSamplesInBatch);
-                    torch::Tensor tensorOfTargetPoliciesForBatch = tensorOfTargetPolicies.index_select(dimension, tensorOfIndicesOfSamplesInBatch);
-
-                    adam.zero_grad();
-                    std::vector<torch::Tensor> vectorOfValueAndPolicy = neuralNetwork->forward(inputTensorForBatch);
-                    torch::Tensor tensorOfPredictedValues = vectorOfValueAndPolicy[0];
-                    torch::Tensor tensorOfPredictedPolicies = vectorOfValueAndPolicy[1];
-
-                    torch::Tensor tensorOfValueLoss = torch::mse_loss(tensorOfPredictedValues, tensorOfTargetValuesForBatch);
-                    torch::Tensor tensorOfPolicyLoss = torch::binary_cross_entropy(tensorOfPredictedPolicies, tensorOfTargetPoliciesForBatch);
-                    torch::Tensor tensorOfLoss = tensorOfValueLoss + tensorOfPolicyLoss;
-
-                    tensorOfLoss.backward();
-                    adam.step();
-
-                    double loss = tensorOfLoss.item<double>();
-                    int numberOfSamplesInBatch = indexOfLastSample - indexOfFirstSample + 1;
-                    double lossForBatch = loss * numberOfSamplesInBatch;
-                    runningLoss += lossForBatch;
-                }
-
-                double averageLoss = runningLoss / numberOfSamples;
-
+            BatchLoader batchLoader(
+                packedTrainingExamples,
+                batchSize,
+                numberOfEpochs,
+                Random::deriveSeed(Random::getSeed(), Random::Purpose::Training, numberOfTrainings++)
+            );
+            std::chrono::steady_clock::time_point timeOfStartOfTraining = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point timeOfStartOfEpoch = timeOfStartOfTraining;
+            int indexOfEpoch = 0;
+            double runningLoss = 0.0;
+            int64_t numberOfSamplesInEpoch = 0;
+            int64_t numberOfSamplesTrained = 0;
+            auto logEpoch = [&]() {
+                std::chrono::duration<double> durationOfEpoch = std::chrono::steady_clock::now() - timeOfStartOfEpoch;
+                double averageLoss = runningLoss / numberOfSamplesInEpoch;
+                gaugeOfLoss.set(averageLoss);
                 Logger::info(
                     "[TRAINING] Epoch " + std::to_string(indexOfEpoch + 1) + " of " + std::to_string(numberOfEpochs) +
-                    " completed with average loss " + std::to_string(averageLoss) + "."
+                    " completed with average loss " + std::to_string(averageLoss) +
+                    " at " + std::to_string(numberOfSamplesInEpoch / durationOfEpoch.count()) + " samples per second."
                 );
-            }
+            };
+            while (std::optional<MiniBatch> miniBatch = batchLoader.next()) {
+                if (stopToken.stop_requested()) {
+                    neuralNetwork->eval();
+                    Logger::info("[TRAINING] Training was stopped before completion; parameters were not saved.");
+                    return;
+                }
+                if (miniBatch->indexOfEpoch != indexOfEpoch) {
+                    logEpoch();
+                    indexOfEpoch = miniBatch->indexOfEpoch;
+                    runningLoss = 0.0;
+                    numberOfSamplesInEpoch = 0;
+                    timeOfStartOfEpoch = std::chrono::steady_clock::now();
+                }
 
-            variableListOfParameters = neuralNetwork->parameters();
-            std::lock_guard<std::mutex> lock(wrapperOfNeuralNetwork->mutex);
-            torch::save(variableListOfParameters, wrapperOfNeuralNetwork->pathToFileOfParameters);
-            Logger::info("[TRAINING] Model parameters were saved after training.");
+                /* Tensor `inputTensorForBatch` has shape [B, F], where F is 441 for a scalar policy head or the number of features of a state for an actions head.
+                * Tensor `tensorOfTargetValuesForBatch` has shape [B, 1].
+                * Tensor `tensorOfTargetPoliciesForBatch` has shape [B, 1] for a scalar policy head or [B, 127] for an actions head.
+                * The gathered rows are wrapped without copying; features are converted from bytes to floats on the device.
+                */
+                int64_t numberOfSamplesInBatch = miniBatch->numberOfExamples;
+                torch::Tensor inputTensorForBatch = torch::from_blob(
+                    miniBatch->features.data(),
+                    { numberOfSamplesInBatch, miniBatch->numberOfFeatures },
+                    torch::kUInt8
+                ).to(tensorOptions);
+                torch::Tensor tensorOfTargetValuesForBatch = torch::from_blob(miniBatch->values.data(), { numberOfSamplesInBatch, 1 }, torch::kFloat32).to(device);
+                torch::Tensor tensorOfTargetPoliciesForBatch = torch::from_blob(miniBatch->policies.data(), { numberOfSamplesInBatch, miniBatch->numberOfPolicyTargets }, torch::kFloat32).to(device);
+
+                adam->zero_grad();
+                std::vector<torch::Tensor> vectorOfValueAndPolicy = neuralNetwork->forward(inputTensorForBatch);
+                torch::Tensor tensorOfPredictedValues = vectorOfValueAndPolicy[0];
+                torch::Tensor tensorOfPredictedPolicies = vectorOfValueAndPolicy[1];
+
+                torch::Tensor tensorOfValueLoss = torch::mse_loss(tensorOfPredictedValues, tensorOfTargetValuesForBatch);
+                // A scalar policy head is trained with binary cross entropy, and an actions head with cross entropy against the distribution of visits.
+                torch::Tensor tensorOfPolicyLoss = (policyHead == PolicyHead::Actions) ?
+                    -(tensorOfTargetPoliciesForBatch * torch::log_softmax(tensorOfPredictedPolicies, 1)).sum(1).mean() :
+                    torch::binary_cross_entropy(tensorOfPredictedPolicies, tensorOfTargetPoliciesForBatch);
+                torch::Tensor tensorOfLoss = tensorOfValueLoss + tensorOfPolicyLoss;
+
+                tensorOfLoss.backward();
+                adam->step();
+
+                double loss = tensorOfLoss.item<double>();
+                runningLoss += loss * numberOfSamplesInBatch;
+                numberOfSamplesInEpoch += numberOfSamplesInBatch;
+                numberOfSamplesTrained += numberOfSamplesInBatch;
+                counterOfSamplesTrained.increment(static_cast<uint64_t>(numberOfSamplesInBatch));
+            }
+            logEpoch();
+            std::chrono::duration<double> durationOfTraining = std::chrono::steady_clock::now() - timeOfStartOfTraining;
+            Logger::info(
+                "[TRAINING] Trained on " + std::to_string(numberOfSamplesTrained) + " samples in " + std::to_string(durationOfTraining.count()) +
+                " s at " + std::to_string(numberOfSamplesTrained / durationOfTraining.count()) + " samples per second."
+            );
 
             neuralNetwork->eval();
+            Checkpoint checkpoint = checkpointManager->saveCheckpoint(neuralNetwork, *adam);
+            if (arena->isEnabled()) {
+                WrapperOfNeuralNetwork candidate(checkpoint.pathToParameters, wrapperOfNeuralNetwork->getSpecification());
+                ResultOfMatch resultOfMatch = arena->playMatch(candidate, *wrapperOfNeuralNetwork, stopToken);
+                if (!resultOfMatch.candidateIsPromoted) {
+                    Logger::info("[TRAINING] Checkpoint " + std::to_string(checkpoint.number) + " was not promoted; the live model was kept.");
+                    return;
+                }
+            }
+            checkpointManager->markCheckpointAsBest(checkpoint);
+            wrapperOfNeuralNetwork->updateParameters(neuralNetwork);
+            Logger::info("[TRAINING] Model parameters were promoted and saved after training.");
         }
     };
 
@@ -2,9 +2,11 @@
 
 // Change C++ Language Standard to ISO C++20 Standard (/std:c++20).
 
+#include "server/app.hpp"
 #include "config.hpp"
-#include "server/cors_middleware.hpp"
+#include "game/board_topology.hpp"
 #include "logger.hpp"
+#include "random.hpp"
 #include "server/server.hpp"
 #include "ai/trainer.hpp"
 
@@ -17,14 +19,24 @@ int main() {
 	Config::Config config;
 	try {
 		config = config.load("config.json");
+		Logger::setMinimumLevel(Logger::levelFromString(config.minimumLevelOfLogs));
+		Logger::setFormat(Logger::formatFromString(config.formatOfLogs));
+		if (!config.pathToIsometricCoordinates.empty()) {
+			Game::setBoardTopology(Game::loadBoardTopology(config.pathToIsometricCoordinates));
+		}
 	}
 	catch (const std::exception& e) {
 		Logger::error("main during configuration", e);
 		return EXIT_FAILURE;
 	}
 
+	// A seed of 0 draws a seed from the random device; the seed is logged so that the run can be reproduced.
+	uint64_t seed = (config.seed != 0) ? static_cast<uint64_t>(config.seed) : Random::createSeedFromDevice();
+	Random::setSeed(seed);
+	Logger::info("Random streams were seeded with " + std::to_string(seed) + ".");
 
-    crow::App<Server::CorsMiddleware> app;
+
+    Server::App app;
 	app.loglevel(crow::LogLevel::Info);
 
 
@@ -38,10 +50,33 @@ int main() {
 		return EXIT_FAILURE;
 	}
 
-	AI::WrapperOfNeuralNetwork neuralNet(config.modelPath, config.numberOfNeurons);
+	AI::SpecificationOfNeuralNetwork specificationOfNeuralNetwork;
+	specificationOfNeuralNetwork.architecture = config.architecture;
+	specificationOfNeuralNetwork.policyHead = AI::policyHeadFromString(config.policyHead);
+	specificationOfNeuralNetwork.numberOfNeurons = config.numberOfNeurons;
+	specificationOfNeuralNetwork.numberOfChannels = config.numberOfChannels;
+	specificationOfNeuralNetwork.numberOfResidualBlocks = config.numberOfResidualBlocks;
+	AI::WrapperOfNeuralNetwork neuralNet(config.modelPath, specificationOfNeuralNetwork);
+
+	AI::ReplayBuffer replayBuffer(config.pathToReplayBuffer, config.numberOfRecordsPerShard, config.sizeOfReplayWindow);
+
+	AI::CheckpointManager checkpointManager(config.pathToCheckpoints, config.numberOfCheckpointsToKeep);
+
+	AI::Arena arena(
+		config.numberOfGamesOfArena,
+		config.numberOfSimulationsOfArena,
+		config.cPuct,
+		config.tolerance,
+		config.winRateThresholdOfArena,
+		static_cast<uint64_t>(config.seedOfArena),
+		config.numberOfThreadsOfArena
+	);
 
 	AI::Trainer trainer(
 		&neuralNet,
+		&replayBuffer,
+		&checkpointManager,
+		&arena,
 		config.modelWatcherInterval,
 		config.trainingThreshold,
 		config.numberOfSimulations,
@@ -51,12 +86,18 @@ int main() {
 		config.numberOfEpochs,
 		config.batchSize,
 		config.dirichletMixingWeight,
-		config.dirichletShape
+		config.dirichletShape,
+		config.numberOfSamplesPerTraining,
+		AI::samplingOfReplayBufferFromString(config.samplingOfReplayBuffer),
+		config.randomizesBoardLayouts
 	);
 	trainer.startModelWatcher();
 	trainer.runTrainingLoop();
 
-	Server::setUpRoutes(app, liveDb, neuralNet, config);
+	Server::StateCache stateCache;
+	Server::PushChannel pushChannel;
+	Server::JobPool jobPool(config.numberOfComputeThreads, pushChannel);
+	Server::setUpRoutes(app, liveDb, neuralNet, config, stateCache, pushChannel, jobPool);
 
 	Logger::info("The back end will be started on port " + config.backEndPort);
 	app.port(config.backEndPort).multithreaded().run();
@@ -0,0 +1,13 @@
+// Project `benchmarks` measures hot paths of the back end with Google Benchmark.
+// Run `benchmarks.exe --benchmark_format=json` to produce results that can be compared across changes.
+
+#include "benchmark/benchmark.h"
+#include "board_snapshot_benchmarks.hpp"
+#include "game_benchmarks.hpp"
+#include "inference_benchmarks.hpp"
+#include "json_serialization_benchmarks.hpp"
+#include "mcts_benchmarks.hpp"
+#include "random_benchmarks.hpp"
+#include "training_preprocessing_benchmarks.hpp"
+
+BENCHMARK_MAIN();
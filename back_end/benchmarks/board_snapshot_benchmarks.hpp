@@ -0,0 +1,82 @@
+#pragma once
+
+
+#include "benchmark/benchmark.h"
+#include "../server/board_snapshot_encoder.hpp"
+#include "../game/labels.hpp"
+#include "../db/query_builder.hpp"
+#include <string>
+
+
+namespace Benchmarks {
+
+	using Game::formatLabel;
+
+	/* Function `createBoardSnapshotOfMidgame` creates a board snapshot resembling a game in progress,
+	* where each player has 3 settlements, 2 cities, 2 walls, 12 roads, and some resources.
+	*/
+	BoardSnapshot createBoardSnapshotOfMidgame() {
+		BoardSnapshot boardSnapshot;
+		int id = 1;
+		for (int player = 1; player <= 3; ++player) {
+			int offset = (player - 1) * 18;
+			for (int i = 1; i <= 3; ++i) {
+				boardSnapshot.settlements.push_back(Settlement{ id++, player, formatLabel('V', offset + i) });
+			}
+			for (int i = 4; i <= 5; ++i) {
+				boardSnapshot.cities.push_back(City{ id++, player, formatLabel('V', offset + i) });
+			}
+			for (int i = 4; i <= 5; ++i) {
+				boardSnapshot.walls.push_back(Wall{ id++, player, formatLabel('V', offset + i) });
+			}
+			for (int i = 1; i <= 12; ++i) {
+				boardSnapshot.roads.push_back(Road{ id++, player, formatLabel('E', (player - 1) * 24 + i) });
+			}
+			boardSnapshot.resources[player] = ResourceBag{ 2, 3, 1, 4, 0, 1, 2, 0 };
+		}
+		boardSnapshot.currentPlayer = 2;
+		boardSnapshot.phase = Game::Phase::Turn;
+		return boardSnapshot;
+	}
+
+	/* Function `benchmarkSerializingBoardAsFourJsonResponses` measures serializing the bodies of
+	* `/cities`, `/roads`, `/settlements`, and `/walls`, which a client previously requested separately.
+	*/
+	void benchmarkSerializingBoardAsFourJsonResponses(benchmark::State& state) {
+		BoardSnapshot boardSnapshot = createBoardSnapshotOfMidgame();
+		size_t numberOfBytes = 0;
+		for (auto _ : state) {
+			numberOfBytes = 0;
+			numberOfBytes += QueryJsonBuilder::convertVectorOfCitiesToJsonObject(boardSnapshot.cities).dump().size();
+			numberOfBytes += QueryJsonBuilder::convertVectorOfRoadsToJsonObject(boardSnapshot.roads).dump().size();
+			numberOfBytes += QueryJsonBuilder::convertVectorOfSettlementsToJsonObject(boardSnapshot.settlements).dump().size();
+			numberOfBytes += QueryJsonBuilder::convertVectorOfWallsToJsonObject(boardSnapshot.walls).dump().size();
+			benchmark::DoNotOptimize(numberOfBytes);
+		}
+		state.counters["bytesOfPayload"] = static_cast<double>(numberOfBytes);
+	}
+	BENCHMARK(benchmarkSerializingBoardAsFourJsonResponses);
+
+	void benchmarkSerializingBoardAsJson(benchmark::State& state) {
+		BoardSnapshot boardSnapshot = createBoardSnapshotOfMidgame();
+		std::string body;
+		for (auto _ : state) {
+			body = Server::encodeBoardSnapshotAsJson(boardSnapshot);
+			benchmark::DoNotOptimize(body.data());
+		}
+		state.counters["bytesOfPayload"] = static_cast<double>(body.size());
+	}
+	BENCHMARK(benchmarkSerializingBoardAsJson);
+
+	void benchmarkSerializingBoardAsBinary(benchmark::State& state) {
+		BoardSnapshot boardSnapshot = createBoardSnapshotOfMidgame();
+		std::string body;
+		for (auto _ : state) {
+			body = Server::encodeBoardSnapshotAsBinary(boardSnapshot);
+			benchmark::DoNotOptimize(body.data());
+		}
+		state.counters["bytesOfPayload"] = static_cast<double>(body.size());
+	}
+	BENCHMARK(benchmarkSerializingBoardAsBinary);
+
+}
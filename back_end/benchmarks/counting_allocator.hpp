@@ -0,0 +1,47 @@
+#pragma once
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+/* The replaceable global `operator new` and `operator delete` of project `benchmarks` count allocations,
+* so that a benchmark can report how many times a hot path allocates, such as copying a game state or running a search.
+* Array and nothrow forms call these by default. Allocations inside libraries with their own allocators, such as the tensors of libtorch, are not counted.
+* A program may replace these functions once, which holds since project `benchmarks` compiles the single translation unit `benchmarks.cpp`.
+*/
+
+
+namespace Benchmarks {
+
+	namespace Detail {
+		inline std::atomic<int64_t> numberOfAllocations{ 0 };
+	}
+
+	// Function `getNumberOfAllocations` returns the number of calls of `operator new` by all threads since the program started.
+	int64_t getNumberOfAllocations() {
+		return Detail::numberOfAllocations.load(std::memory_order_relaxed);
+	}
+
+}
+
+
+void* operator new(std::size_t numberOfBytes) {
+	Benchmarks::Detail::numberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(numberOfBytes == 0 ? 1 : numberOfBytes)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
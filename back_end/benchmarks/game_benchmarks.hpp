@@ -0,0 +1,284 @@
+#pragma once
+
+
+#include <array>
+#include "benchmark/benchmark.h"
+#include "../game/board.hpp"
+#include "../game/board_layout.hpp"
+#include "../game/board_topology.hpp"
+#include "counting_allocator.hpp"
+#include <cstdint>
+#include "../game/game_state.hpp"
+#include <memory>
+#include "../random.hpp"
+#include "../game/road_graph.hpp"
+#include <string>
+#include <vector>
+
+
+namespace Benchmarks {
+
+	/* Function `createGameStateAfterSetup` places the settlements, cities, and roads of setup at the first available vertices and edges and
+	* rolls a sum of 6, so that the state is in phase Turn with 2 buildings and 2 roads per player, as after setup of a game.
+	*/
+	GameState createGameStateAfterSetup() {
+		Board board;
+		GameState gameState;
+		while (gameState.phase != Game::Phase::RollDice) {
+			const int player = gameState.currentPlayer;
+			if (gameState.phase == Game::Phase::FirstSettlement || gameState.phase == Game::Phase::FirstCity) {
+				std::vector<std::string> vectorOfLabelsOfAvailableVertices = board.getVectorOfLabelsOfAvailableVertices(board.getVectorOfLabelsOfOccupiedVertices(gameState));
+				if (gameState.phase == Game::Phase::FirstSettlement) {
+					gameState.placeSettlement(player, vectorOfLabelsOfAvailableVertices.front());
+				}
+				else {
+					gameState.placeCity(player, vectorOfLabelsOfAvailableVertices.front());
+				}
+			}
+			else {
+				std::vector<std::string> vectorOfLabelsOfAvailableEdges = board.getVectorOfLabelsOfAvailableEdgesExtendingFromLastBuilding(
+					gameState.lastBuilding,
+					board.getVectorOfLabelsOfOccupiedEdges(gameState)
+				);
+				gameState.placeRoad(player, vectorOfLabelsOfAvailableEdges.front());
+			}
+		}
+		gameState.applyRollOfDice(3, 3, "");
+		gameState.updatePhase();
+		return gameState;
+	}
+
+	// Function `createGameStateOfArgument` returns a new game state for argument 0 and a game state after setup for argument 1.
+	GameState createGameStateOfArgument(int64_t argument) {
+		return (argument == 0) ? GameState() : createGameStateAfterSetup();
+	}
+
+	// Function `benchmarkGettingAvailableVertices` measures `Board::getVectorOfLabelsOfAvailableVertices`, which every expansion of a settlement or city calls.
+	void benchmarkGettingAvailableVertices(benchmark::State& state) {
+		Board board;
+		GameState gameState = createGameStateOfArgument(state.range(0));
+		std::vector<std::string> vectorOfLabelsOfOccupiedVertices = board.getVectorOfLabelsOfOccupiedVertices(gameState);
+		size_t numberOfAvailableVertices = 0;
+		for (auto _ : state) {
+			std::vector<std::string> vectorOfLabelsOfAvailableVertices = board.getVectorOfLabelsOfAvailableVertices(vectorOfLabelsOfOccupiedVertices);
+			numberOfAvailableVertices = vectorOfLabelsOfAvailableVertices.size();
+			benchmark::DoNotOptimize(vectorOfLabelsOfAvailableVertices.data());
+		}
+		state.counters["numberOfAvailableVertices"] = static_cast<double>(numberOfAvailableVertices);
+	}
+	BENCHMARK(benchmarkGettingAvailableVertices)->ArgName("afterSetup")->Arg(0)->Arg(1);
+
+	// Function `benchmarkGeneratingLegalMoves` measures `GameState::getVectorOfLegalMoves`, which every expansion of a decision node and `Server::buildNextMoves` call.
+	void benchmarkGeneratingLegalMoves(benchmark::State& state) {
+		GameState gameState = createGameStateOfArgument(state.range(0));
+		size_t numberOfLegalMoves = 0;
+		for (auto _ : state) {
+			std::vector<Game::Move> vectorOfLegalMoves = gameState.getVectorOfLegalMoves();
+			numberOfLegalMoves = vectorOfLegalMoves.size();
+			benchmark::DoNotOptimize(vectorOfLegalMoves.data());
+		}
+		state.counters["numberOfLegalMoves"] = static_cast<double>(numberOfLegalMoves);
+	}
+	BENCHMARK(benchmarkGeneratingLegalMoves)->ArgName("afterSetup")->Arg(0)->Arg(1);
+
+	// Function `benchmarkGettingGridRepresentationForMove` measures `Board::getGridRepresentationForMove`, which a scalar policy head calls once per child.
+	void benchmarkGettingGridRepresentationForMove(benchmark::State& state, const std::string& move, const std::string& moveType) {
+		Board board;
+		for (auto _ : state) {
+			std::vector<float> featureVector = board.getGridRepresentationForMove(move, moveType);
+			benchmark::DoNotOptimize(featureVector.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_CAPTURE(benchmarkGettingGridRepresentationForMove, settlement, std::string("V01"), std::string("settlement"));
+	BENCHMARK_CAPTURE(benchmarkGettingGridRepresentationForMove, road, std::string("E01"), std::string("road"));
+
+	/* Function `benchmarkCollectingResources` measures collecting resources with `GameState::applyRollOfDice` for each sum of the dice from 2 to 12 after setup,
+	* as every expansion of a chance node does.
+	*/
+	void benchmarkCollectingResources(benchmark::State& state) {
+		GameState gameState = createGameStateAfterSetup();
+		const std::array<ResourceBag, 4> resourcesAfterSetup = gameState.resources;
+		for (auto _ : state) {
+			for (int sum = 2; sum <= 12; sum++) {
+				gameState.resources = resourcesAfterSetup;
+				gameState.applyRollOfDice(sum / 2, sum - sum / 2, "");
+				benchmark::DoNotOptimize(gameState.resources.data());
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * 11);
+	}
+	BENCHMARK(benchmarkCollectingResources);
+
+	/* Function `benchmarkCopyingGameState` measures copying a game state, which every node of MCTS does.
+	* Counter `allocationsPerCopy` is 0, since structures are stored inline.
+	*/
+	void benchmarkCopyingGameState(benchmark::State& state) {
+		GameState gameState = createGameStateOfArgument(state.range(0));
+		const int64_t numberOfAllocationsBefore = getNumberOfAllocations();
+		for (auto _ : state) {
+			GameState copyOfGameState = gameState;
+			benchmark::DoNotOptimize(&copyOfGameState);
+		}
+		const int64_t numberOfAllocations = getNumberOfAllocations() - numberOfAllocationsBefore;
+		state.SetItemsProcessed(state.iterations());
+		state.counters["allocationsPerCopy"] = static_cast<double>(numberOfAllocations) / static_cast<double>(state.iterations());
+		state.counters["bytesOfGameState"] = static_cast<double>(sizeof(GameState));
+	}
+	BENCHMARK(benchmarkCopyingGameState)->ArgName("afterSetup")->Arg(0)->Arg(1);
+
+	/* Function `benchmarkGettingPrecomputedBoardLayout` measures building the production table and grid of a random layout for argument 0 and
+	* looking them up in the cache of layouts for argument 1, as a game on a random layout and packing its records do.
+	*/
+	void benchmarkGettingPrecomputedBoardLayout(benchmark::State& state) {
+		Random::Xoshiro256PlusPlus generator = Random::createStream(Random::Purpose::SelfPlay, 0);
+		const Game::BoardLayout boardLayout = Game::createRandomBoardLayout(generator);
+		for (auto _ : state) {
+			if (state.range(0) == 0) {
+				Game::PrecomputedBoardLayout precomputedBoardLayout = Game::createPrecomputedBoardLayout(boardLayout);
+				benchmark::DoNotOptimize(&precomputedBoardLayout);
+			}
+			else {
+				std::shared_ptr<const Game::PrecomputedBoardLayout> precomputedBoardLayout = Game::getPrecomputedBoardLayout(boardLayout);
+				benchmark::DoNotOptimize(precomputedBoardLayout.get());
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(benchmarkGettingPrecomputedBoardLayout)->ArgName("cached")->Arg(0)->Arg(1);
+
+
+	// Structure `MoveOfStructure` is a road or building placed by a player at a zero based index of an edge or vertex.
+	struct MoveOfStructure {
+		int player;
+		bool isRoad;
+		int index;
+	};
+
+	/* Function `createMovesOfLongGame` plays from setup with unlimited resources, where on every third of its turns a player builds a settlement if one is legal
+	* and otherwise builds the road of highest index on its frontier, until 120 structures have been placed or every player can only pass.
+	* Roads grow into long networks that settlements of other players split, as in a long game.
+	*/
+	std::vector<MoveOfStructure> createMovesOfLongGame() {
+		GameState gameState = createGameStateAfterSetup();
+		std::vector<MoveOfStructure> vectorOfMoves;
+		for (int player = 1; player <= 3; player++) {
+			for (int indexOfVertex : gameState.settlements[player]) {
+				vectorOfMoves.push_back(MoveOfStructure{ player, false, indexOfVertex });
+			}
+			for (int indexOfVertex : gameState.cities[player]) {
+				vectorOfMoves.push_back(MoveOfStructure{ player, false, indexOfVertex });
+			}
+			for (int indexOfEdge : gameState.roads[player]) {
+				vectorOfMoves.push_back(MoveOfStructure{ player, true, indexOfEdge });
+			}
+		}
+		for (int turn = 0, numberOfConsecutivePasses = 0; vectorOfMoves.size() < 120 && numberOfConsecutivePasses < 3; turn++) {
+			const int player = turn % 3 + 1;
+			const ResourceBag unlimitedResources{ 100, 100, 100, 100, 100, 100, 100, 100 };
+			std::vector<Game::Move> vectorOfLegalMoves;
+			gameState.moveGenerator.generateMoves(Game::Phase::Turn, player, "", unlimitedResources, vectorOfLegalMoves);
+			const Game::Move* moveToMake = nullptr;
+			for (const Game::Move& legalMove : vectorOfLegalMoves) {
+				if ((legalMove.type == "settlement" && turn % 9 < 3) || (legalMove.type == "road" && (moveToMake == nullptr || moveToMake->type == "road"))) {
+					moveToMake = &legalMove;
+				}
+			}
+			if (moveToMake == nullptr) {
+				numberOfConsecutivePasses++;
+				continue;
+			}
+			numberOfConsecutivePasses = 0;
+			// The move generator alone is updated, since a game state would end the game at 5 buildings.
+			if (moveToMake->type == "settlement") {
+				const int indexOfVertex = Game::getIndexOfLabel(moveToMake->label, Game::NUMBER_OF_VERTICES);
+				gameState.moveGenerator.placeSettlement(player, indexOfVertex);
+				vectorOfMoves.push_back(MoveOfStructure{ player, false, indexOfVertex });
+			}
+			else {
+				const int indexOfEdge = Game::getIndexOfLabel(moveToMake->label, Game::NUMBER_OF_EDGES);
+				gameState.moveGenerator.placeRoad(player, indexOfEdge);
+				vectorOfMoves.push_back(MoveOfStructure{ player, true, indexOfEdge });
+			}
+		}
+		return vectorOfMoves;
+	}
+
+	// Function `extendRoadNaively` returns the number of edges of the longest trail of unused roads from a vertex that passes no blocked vertex.
+	int extendRoadNaively(int indexOfVertex, std::array<bool, Game::NUMBER_OF_EDGES>& edgeIsUnusedRoad, const std::array<bool, Game::NUMBER_OF_VERTICES>& vertexIsBlocked, bool isStartOfRoad) {
+		if (!isStartOfRoad && vertexIsBlocked[indexOfVertex]) {
+			return 0;
+		}
+		const Game::BoardTopology& boardTopology = Game::getBoardTopology();
+		int lengthOfLongestRoad = 0;
+		for (int indexOfEdge : boardTopology.indicesOfEdgesOfVertices[indexOfVertex]) {
+			if (indexOfEdge < 0 || !edgeIsUnusedRoad[indexOfEdge]) {
+				continue;
+			}
+			const std::array<int, 2>& indicesOfVertices = boardTopology.indicesOfVerticesOfEdges[indexOfEdge];
+			edgeIsUnusedRoad[indexOfEdge] = false;
+			lengthOfLongestRoad = std::max(lengthOfLongestRoad, 1 + extendRoadNaively(indicesOfVertices[0] == indexOfVertex ? indicesOfVertices[1] : indicesOfVertices[0], edgeIsUnusedRoad, vertexIsBlocked, false));
+			edgeIsUnusedRoad[indexOfEdge] = true;
+		}
+		return lengthOfLongestRoad;
+	}
+
+	/* Function `computeLengthOfLongestRoadNaively` searches trails from both vertices of every road of a player over all roads of the player,
+	* as recomputing the longest road from scratch after every move would. It is the baseline of `benchmarkMaintainingLongestRoad`.
+	*/
+	int computeLengthOfLongestRoadNaively(int player, const std::vector<MoveOfStructure>& vectorOfMoves, size_t numberOfMovesMade) {
+		std::array<bool, Game::NUMBER_OF_EDGES> edgeIsRoad{};
+		std::array<bool, Game::NUMBER_OF_VERTICES> vertexIsBlocked{};
+		for (size_t i = 0; i < numberOfMovesMade; i++) {
+			const MoveOfStructure& move = vectorOfMoves[i];
+			if (move.isRoad && move.player == player) {
+				edgeIsRoad[move.index] = true;
+			}
+			else if (!move.isRoad && move.player != player) {
+				vertexIsBlocked[move.index] = true;
+			}
+		}
+		const Game::BoardTopology& boardTopology = Game::getBoardTopology();
+		int lengthOfLongestRoad = 0;
+		for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+			if (!edgeIsRoad[indexOfEdge]) {
+				continue;
+			}
+			for (int indexOfVertex : boardTopology.indicesOfVerticesOfEdges[indexOfEdge]) {
+				lengthOfLongestRoad = std::max(lengthOfLongestRoad, extendRoadNaively(indexOfVertex, edgeIsRoad, vertexIsBlocked, true));
+			}
+		}
+		return lengthOfLongestRoad;
+	}
+
+	/* Function `benchmarkMaintainingLongestRoad` places the structures of a long game and queries the longest road of the player who moved after each,
+	* as a search that scores longest roads would. Argument 0 recomputes the longest road from scratch; argument 1 maintains a `Game::RoadGraph`.
+	*/
+	void benchmarkMaintainingLongestRoad(benchmark::State& state) {
+		const std::vector<MoveOfStructure> vectorOfMoves = createMovesOfLongGame();
+		int sumOfLengthsOfLongestRoads = 0;
+		for (auto _ : state) {
+			sumOfLengthsOfLongestRoads = 0;
+			Game::RoadGraph roadGraph;
+			for (size_t i = 0; i < vectorOfMoves.size(); i++) {
+				const MoveOfStructure& move = vectorOfMoves[i];
+				if (state.range(0) == 0) {
+					sumOfLengthsOfLongestRoads += computeLengthOfLongestRoadNaively(move.player, vectorOfMoves, i + 1);
+					continue;
+				}
+				if (move.isRoad) {
+					roadGraph.placeRoad(move.player, move.index);
+				}
+				else {
+					roadGraph.placeBuilding(move.player, move.index);
+				}
+				sumOfLengthsOfLongestRoads += roadGraph.getLengthOfLongestRoad(move.player);
+			}
+			benchmark::DoNotOptimize(sumOfLengthsOfLongestRoads);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(vectorOfMoves.size()));
+		state.counters["sumOfLengthsOfLongestRoads"] = static_cast<double>(sumOfLengthsOfLongestRoads);
+	}
+	BENCHMARK(benchmarkMaintainingLongestRoad)->ArgName("incremental")->Arg(0)->Arg(1);
+
+}
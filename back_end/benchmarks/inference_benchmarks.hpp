@@ -0,0 +1,39 @@
+#pragma once
+
+
+#include "../ai/networks/architecture_registry.hpp"
+#include "benchmark/benchmark.h"
+#include <string>
+#include <torch/torch.h>
+
+
+namespace Benchmarks {
+
+	/* Function `benchmarkInferenceOfArchitecture` measures a forward pass on the CPU of a network of an architecture
+	* for a batch of `state.range(0)` input rows, so that architectures can be compared by strength per millisecond.
+	* Input rows hold valid codes of cells for a scalar policy head and valid counts for an actions head.
+	*/
+	void benchmarkInferenceOfArchitecture(benchmark::State& state, const std::string& architecture, AI::PolicyHead policyHead) {
+		torch::set_num_threads(1);
+		AI::SpecificationOfNeuralNetwork specification;
+		specification.architecture = architecture;
+		specification.policyHead = policyHead;
+		AI::NeuralNetwork neuralNetwork = AI::ArchitectureRegistry::create(specification);
+		neuralNetwork->eval();
+		const int64_t numberOfRows = state.range(0);
+		const int64_t upperBoundOfInputs = (policyHead == AI::PolicyHead::Actions) ? 4 : 13;
+		torch::Tensor inputTensor = torch::randint(upperBoundOfInputs, { numberOfRows, specification.getNumberOfFeatures() }, torch::kFloat32);
+		torch::NoGradGuard noGrad;
+		for (auto _ : state) {
+			std::vector<torch::Tensor> vectorOfTensorsOfPredictedValuesAndPolicies = neuralNetwork->forward(inputTensor);
+			benchmark::DoNotOptimize(vectorOfTensorsOfPredictedValuesAndPolicies[1].data_ptr<float>());
+		}
+		state.SetItemsProcessed(state.iterations() * numberOfRows);
+	}
+
+	BENCHMARK_CAPTURE(benchmarkInferenceOfArchitecture, mlpWithScalarPolicy, std::string("mlp"), AI::PolicyHead::Scalar)->Arg(1)->Arg(32)->Unit(benchmark::kMicrosecond);
+	BENCHMARK_CAPTURE(benchmarkInferenceOfArchitecture, mlpWithActionsPolicy, std::string("mlp"), AI::PolicyHead::Actions)->Arg(1)->Arg(32)->Unit(benchmark::kMicrosecond);
+	BENCHMARK_CAPTURE(benchmarkInferenceOfArchitecture, residualCnnWithScalarPolicy, std::string("residualCnn"), AI::PolicyHead::Scalar)->Arg(1)->Arg(32)->Unit(benchmark::kMicrosecond);
+	BENCHMARK_CAPTURE(benchmarkInferenceOfArchitecture, residualCnnWithActionsPolicy, std::string("residualCnn"), AI::PolicyHead::Actions)->Arg(1)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+
+#include "benchmark/benchmark.h"
+#include "board_snapshot_benchmarks.hpp"
+#include "crow/json.h"
+#include "../game/game_state.hpp"
+#include "../json_writer.hpp"
+#include "../game/move_result.hpp"
+#include <limits>
+#include <string>
+
+
+namespace Benchmarks {
+
+	/* Function `createGameStateOfMidgame` creates a game state resembling a game in progress,
+	* where each player has 3 settlements, 2 cities, 1 wall, 12 roads, and some resources.
+	*/
+	GameState createGameStateOfMidgame() {
+		GameState gameState;
+		for (int player = 1; player <= 3; ++player) {
+			int offset = (player - 1) * 18;
+			for (int i = 0; i < 3; ++i) {
+				gameState.settlements[player].add(offset + i);
+			}
+			for (int i = 3; i < 5; ++i) {
+				gameState.cities[player].add(offset + i);
+			}
+			gameState.walls[player].add(offset + 3);
+			for (int i = 0; i < 12; ++i) {
+				gameState.roads[player].add((player - 1) * 24 + i);
+			}
+			gameState.resources[player] = ResourceBag{ 2, 3, 1, 4, 0, 1, 2, 0 };
+		}
+		gameState.phase = Game::Phase::Turn;
+		gameState.redProductionDie = 4;
+		gameState.yellowProductionDie = 2;
+		gameState.whiteEventDie = "blue";
+		return gameState;
+	}
+
+	crow::json::wvalue convertResourceBagToJsonObject(const ResourceBag& bag) {
+		crow::json::wvalue bagJson(crow::json::type::Object);
+		bagJson["brick"] = bag.brick;
+		bagJson["grain"] = bag.grain;
+		bagJson["lumber"] = bag.lumber;
+		bagJson["ore"] = bag.ore;
+		bagJson["wool"] = bag.wool;
+		bagJson["cloth"] = bag.cloth;
+		bagJson["coin"] = bag.coin;
+		bagJson["paper"] = bag.paper;
+		return bagJson;
+	}
+
+	/* Function `convertGameStateToJsonObject` builds the tree of `crow::json::wvalue` that `GameState::toJson` built
+	* before game states were serialized with `Json::JsonWriter`. It is kept as a baseline for comparison.
+	*/
+	crow::json::wvalue convertGameStateToJsonObject(const GameState& gameState) {
+		crow::json::wvalue json;
+		json["currentPlayer"] = gameState.currentPlayer;
+		json["phase"] = Game::toString(gameState.phase);
+		json["lastBuilding"] = gameState.lastBuilding;
+		crow::json::wvalue resourcesJson(crow::json::type::Object);
+		for (int player = 1; player <= 3; ++player) {
+			resourcesJson["Player " + std::to_string(player)] = convertResourceBagToJsonObject(gameState.resources[player]);
+		}
+		json["resources"] = std::move(resourcesJson);
+		auto convertLabelsOfPlayers = [](const auto& listsOfLocationsOfPlayers, char prefix) {
+			crow::json::wvalue jsonObject(crow::json::type::Object);
+			for (int player = 1; player <= 3; ++player) {
+				crow::json::wvalue arr(crow::json::type::List);
+				int i = 0;
+				for (int indexOfLocation : listsOfLocationsOfPlayers[player]) {
+					arr[i++] = Game::formatLabel(prefix, indexOfLocation + 1);
+				}
+				jsonObject["Player " + std::to_string(player)] = std::move(arr);
+			}
+			return jsonObject;
+		};
+		json["settlements"] = convertLabelsOfPlayers(gameState.settlements, 'V');
+		json["cities"] = convertLabelsOfPlayers(gameState.cities, 'V');
+		json["roads"] = convertLabelsOfPlayers(gameState.roads, 'E');
+		json["walls"] = convertLabelsOfPlayers(gameState.walls, 'V');
+		crow::json::wvalue jsonObjectOfDescriptionOfDiceAndRolls(crow::json::type::Object);
+		jsonObjectOfDescriptionOfDiceAndRolls["yellowProductionDie"] = gameState.yellowProductionDie;
+		jsonObjectOfDescriptionOfDiceAndRolls["redProductionDie"] = gameState.redProductionDie;
+		jsonObjectOfDescriptionOfDiceAndRolls["whiteEventDie"] = gameState.whiteEventDie;
+		json["dice"] = std::move(jsonObjectOfDescriptionOfDiceAndRolls);
+		return json;
+	}
+
+	void benchmarkSerializingGameStateWithTreeOfValues(benchmark::State& state) {
+		GameState gameState = createGameStateOfMidgame();
+		size_t numberOfBytes = 0;
+		for (auto _ : state) {
+			std::string json = convertGameStateToJsonObject(gameState).dump();
+			numberOfBytes += json.size();
+			benchmark::DoNotOptimize(json.data());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(numberOfBytes));
+	}
+	BENCHMARK(benchmarkSerializingGameStateWithTreeOfValues);
+
+	void benchmarkSerializingGameStateWithJsonWriter(benchmark::State& state) {
+		GameState gameState = createGameStateOfMidgame();
+		size_t numberOfBytes = 0;
+		for (auto _ : state) {
+			Json::JsonWriter writer;
+			gameState.writeJson(writer);
+			numberOfBytes += writer.getBuffer().size();
+			benchmark::DoNotOptimize(writer.getBuffer().data());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(numberOfBytes));
+	}
+	BENCHMARK(benchmarkSerializingGameStateWithJsonWriter);
+
+	// Function `benchmarkSerializingResourcesOfMoveWithTreeOfValues` measures serializing gained and total resources as `Game::Game` did before.
+	void benchmarkSerializingResourcesOfMoveWithTreeOfValues(benchmark::State& state) {
+		GameState gameState = createGameStateOfMidgame();
+		std::array<ResourceBag, 4> resourcesBeforeMove = gameState.resources;
+		resourcesBeforeMove[2].ore -= 1;
+		size_t numberOfBytes = 0;
+		for (auto _ : state) {
+			crow::json::wvalue response;
+			response["message"] = "Player 2 rolled the dice.";
+			crow::json::wvalue gainedAll(crow::json::type::Object);
+			crow::json::wvalue totalAll(crow::json::type::Object);
+			for (int player = 1; player <= 3; ++player) {
+				const ResourceBag& oldBag = resourcesBeforeMove[player];
+				const ResourceBag& newBag = gameState.resources[player];
+				gainedAll["Player " + std::to_string(player)] = convertResourceBagToJsonObject(ResourceBag{
+					newBag.brick - oldBag.brick, newBag.grain - oldBag.grain, newBag.lumber - oldBag.lumber, newBag.ore - oldBag.ore,
+					newBag.wool - oldBag.wool, newBag.cloth - oldBag.cloth, newBag.coin - oldBag.coin, newBag.paper - oldBag.paper
+				});
+				totalAll["Player " + std::to_string(player)] = convertResourceBagToJsonObject(newBag);
+			}
+			response["gainedResources"] = std::move(gainedAll);
+			response["totalResources"] = std::move(totalAll);
+			std::string json = response.dump();
+			numberOfBytes += json.size();
+			benchmark::DoNotOptimize(json.data());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(numberOfBytes));
+	}
+	BENCHMARK(benchmarkSerializingResourcesOfMoveWithTreeOfValues);
+
+	void benchmarkSerializingResourcesOfMoveWithJsonWriter(benchmark::State& state) {
+		GameState gameState = createGameStateOfMidgame();
+		Game::MoveResult moveResult;
+		moveResult.message = "Player 2 rolled the dice.";
+		std::array<ResourceBag, 4> resourcesBeforeMove = gameState.resources;
+		resourcesBeforeMove[2].ore -= 1;
+		moveResult.recordResources(resourcesBeforeMove, gameState.resources);
+		size_t numberOfBytes = 0;
+		for (auto _ : state) {
+			std::string gainedResources = moveResult.serializeGainedResources();
+			std::string totalResources = moveResult.serializeTotalResources();
+			Json::JsonWriter writer;
+			writer.beginObject();
+			writer.key("message").value(moveResult.message);
+			writer.key("gainedResources").raw(gainedResources);
+			writer.key("totalResources").raw(totalResources);
+			writer.endObject();
+			numberOfBytes += writer.getBuffer().size();
+			benchmark::DoNotOptimize(writer.getBuffer().data());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(numberOfBytes));
+	}
+	BENCHMARK(benchmarkSerializingResourcesOfMoveWithJsonWriter);
+
+	/* Function `benchmarkWritingNonFiniteNumbersWithJsonWriter` measures writing numbers that JSON cannot represent and
+	* fails, as this project has no unit tests, if the writer does not write them as `null`.
+	*/
+	void benchmarkWritingNonFiniteNumbersWithJsonWriter(benchmark::State& state) {
+		const std::string expectedJson = "[null,null,null,1.5]";
+		for (auto _ : state) {
+			Json::JsonWriter writer;
+			writer.beginArray();
+			writer.value(std::numeric_limits<double>::quiet_NaN());
+			writer.value(std::numeric_limits<double>::infinity());
+			writer.value(-std::numeric_limits<double>::infinity());
+			writer.value(1.5);
+			writer.endArray();
+			if (writer.getBuffer() != expectedJson) {
+				state.SkipWithError(("JsonWriter wrote " + writer.getBuffer() + " instead of " + expectedJson + ".").c_str());
+				break;
+			}
+			benchmark::DoNotOptimize(writer.getBuffer().data());
+		}
+	}
+	BENCHMARK(benchmarkWritingNonFiniteNumbersWithJsonWriter);
+
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+
+#include "benchmark/benchmark.h"
+#include "../game/board.hpp"
+#include "counting_allocator.hpp"
+#include <cstdint>
+#include <filesystem>
+#include "game_benchmarks.hpp"
+#include <memory>
+#include "../ai/neural_network.hpp"
+#include "../ai/mcts/node.hpp"
+#include <random>
+#include "../ai/strategy.hpp"
+#include <string>
+#include <torch/torch.h>
+#include <vector>
+
+
+namespace Benchmarks {
+
+	constexpr double C_PUCT_OF_BENCHMARKS = 1.0;
+	constexpr double TOLERANCE_OF_BENCHMARKS = 0.000001;
+
+	/* Function `createWrapperOfNeuralNetwork` creates a wrapper of a network of architecture "mlp" with a policy head whose parameters are
+	* saved in the temporary directory, so that benchmarks of search do not read or overwrite the parameters of the back end.
+	*/
+	std::unique_ptr<AI::WrapperOfNeuralNetwork> createWrapperOfNeuralNetwork(AI::PolicyHead policyHead) {
+		torch::set_num_threads(1);
+		AI::SpecificationOfNeuralNetwork specification;
+		specification.policyHead = policyHead;
+		std::string nameOfFile = (policyHead == AI::PolicyHead::Actions) ? "benchmarks_mlp_with_actions_policy.pt" : "benchmarks_mlp_with_scalar_policy.pt";
+		std::string pathToParameters = (std::filesystem::temp_directory_path() / nameOfFile).string();
+		return std::make_unique<AI::WrapperOfNeuralNetwork>(pathToParameters, specification);
+	}
+
+	/* Function `benchmarkSelectingChild` measures `AI::MCTS::selectChild` at a node with `state.range(0)` children
+	* whose priors and numbers of visits are drawn with a fixed seed.
+	*/
+	void benchmarkSelectingChild(benchmark::State& state) {
+		const int numberOfChildren = static_cast<int>(state.range(0));
+		GameState gameState;
+		AI::MCTS::MCTSNode node(gameState);
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<double> distributionOfPriors(0.0, 1.0);
+		std::uniform_int_distribution<int> distributionOfVisits(0, 20);
+		for (int i = 0; i < numberOfChildren; i++) {
+			std::string move = Game::formatLabel('V', i + 1);
+			auto child = std::make_unique<AI::MCTS::MCTSNode>(gameState, move, &node, "settlement");
+			child->priorProbability = distributionOfPriors(randomEngine);
+			child->visitCount = distributionOfVisits(randomEngine);
+			child->averageValue = distributionOfPriors(randomEngine) * 2.0 - 1.0;
+			node.visitCount += child->visitCount;
+			node.unorderedMapOfMovesToChildren[move] = std::move(child);
+		}
+		for (auto _ : state) {
+			AI::MCTS::MCTSNode* child = AI::MCTS::selectChild(&node, C_PUCT_OF_BENCHMARKS, TOLERANCE_OF_BENCHMARKS);
+			benchmark::DoNotOptimize(child);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(benchmarkSelectingChild)->Arg(8)->Arg(64);
+
+	/* Function `benchmarkExpandingNode` measures `AI::MCTS::expandNode` including evaluating priors with a network with a policy head,
+	* for a root in phase FirstSettlement of a new game (argument 0) and a root in phase Turn after setup (argument 1).
+	*/
+	void benchmarkExpandingNode(benchmark::State& state, AI::PolicyHead policyHead) {
+		std::unique_ptr<AI::WrapperOfNeuralNetwork> neuralNet = createWrapperOfNeuralNetwork(policyHead);
+		GameState gameState = createGameStateOfArgument(state.range(0));
+		std::string moveType = (gameState.phase == Game::Phase::Turn) ? "turn" : "settlement";
+		size_t numberOfChildren = 0;
+		for (auto _ : state) {
+			AI::MCTS::MCTSNode root(gameState, "", nullptr, moveType);
+			AI::MCTS::expandNode(&root, *neuralNet);
+			numberOfChildren = root.unorderedMapOfMovesToChildren.size();
+			benchmark::DoNotOptimize(root.unorderedMapOfMovesToChildren.size());
+		}
+		state.counters["numberOfChildren"] = static_cast<double>(numberOfChildren);
+	}
+	BENCHMARK_CAPTURE(benchmarkExpandingNode, scalarPolicy, AI::PolicyHead::Scalar)->ArgName("afterSetup")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+	BENCHMARK_CAPTURE(benchmarkExpandingNode, actionsPolicy, AI::PolicyHead::Actions)->ArgName("afterSetup")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+	/* Function `benchmarkRunningMcts` measures `runMcts` from a new game with `state.range(0)` simulations and no Dirichlet noise.
+	* Items per second are simulations per second. Counters `allocationsPerSearch` and `allocationsPerSimulation` count calls of `operator new`,
+	* which come from nodes, maps of children, legal moves, and inputs of the network, since copies of game states do not allocate.
+	*/
+	void benchmarkRunningMcts(benchmark::State& state, AI::PolicyHead policyHead) {
+		std::unique_ptr<AI::WrapperOfNeuralNetwork> neuralNet = createWrapperOfNeuralNetwork(policyHead);
+		const int numberOfSimulations = static_cast<int>(state.range(0));
+		GameState gameState;
+		int64_t numberOfSimulationsRun = 0;
+		const int64_t numberOfAllocationsBefore = getNumberOfAllocations();
+		for (auto _ : state) {
+			AI::SearchResult searchResult = runMcts(gameState, *neuralNet, numberOfSimulations, C_PUCT_OF_BENCHMARKS, TOLERANCE_OF_BENCHMARKS, 0.0, 1.0);
+			numberOfSimulationsRun += searchResult.numberOfSimulations;
+			benchmark::DoNotOptimize(searchResult.move.data());
+		}
+		const int64_t numberOfAllocations = getNumberOfAllocations() - numberOfAllocationsBefore;
+		state.SetItemsProcessed(numberOfSimulationsRun);
+		state.counters["allocationsPerSearch"] = static_cast<double>(numberOfAllocations) / static_cast<double>(state.iterations());
+		state.counters["allocationsPerSimulation"] = static_cast<double>(numberOfAllocations) / static_cast<double>(numberOfSimulationsRun);
+	}
+	BENCHMARK_CAPTURE(benchmarkRunningMcts, scalarPolicy, AI::PolicyHead::Scalar)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+	BENCHMARK_CAPTURE(benchmarkRunningMcts, actionsPolicy, AI::PolicyHead::Actions)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+	/* Function `benchmarkEvaluatingStructures` measures `WrapperOfNeuralNetwork::evaluateStructures` for a batch of `state.range(0)` grid representations,
+	* which includes building tensors from vectors of features. Items per second are structures evaluated per second.
+	*/
+	void benchmarkEvaluatingStructures(benchmark::State& state) {
+		std::unique_ptr<AI::WrapperOfNeuralNetwork> neuralNet = createWrapperOfNeuralNetwork(AI::PolicyHead::Scalar);
+		const int numberOfStructures = static_cast<int>(state.range(0));
+		Board board;
+		std::vector<std::vector<float>> vectorOfFeatureVectors;
+		vectorOfFeatureVectors.reserve(numberOfStructures);
+		for (int i = 0; i < numberOfStructures; i++) {
+			vectorOfFeatureVectors.push_back(board.getGridRepresentationForMove(Game::formatLabel('V', i % Game::NUMBER_OF_VERTICES + 1), "settlement"));
+		}
+		for (auto _ : state) {
+			std::vector<std::pair<double, double>> vectorOfPairsOfValuesAndPolicies = neuralNet->evaluateStructures(vectorOfFeatureVectors);
+			benchmark::DoNotOptimize(vectorOfPairsOfValuesAndPolicies.data());
+		}
+		state.SetItemsProcessed(state.iterations() * numberOfStructures);
+	}
+	BENCHMARK(benchmarkEvaluatingStructures)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+
+#include "benchmark/benchmark.h"
+#include <random>
+#include "../random.hpp"
+
+
+namespace Benchmarks {
+
+	/* Function `benchmarkRollingDiceWithRandomDevice` rolls 3 dice with a `std::random_device` and a `std::mt19937` created for every roll,
+	* as `GameState::rollDice` did before streams of random numbers were seeded once. It is kept as a baseline for comparison.
+	*/
+	void benchmarkRollingDiceWithRandomDevice(benchmark::State& state) {
+		std::uniform_int_distribution<int> distribution(1, 6);
+		for (auto _ : state) {
+			std::random_device randomDevice;
+			std::mt19937 generator(randomDevice());
+			int sum = distribution(generator) + distribution(generator) + distribution(generator);
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Function `benchmarkRollingDiceWithGeneratorOfThread` rolls 3 dice with the seeded generator of the thread.
+	void benchmarkRollingDiceWithGeneratorOfThread(benchmark::State& state) {
+		Random::setSeed(42);
+		Random::ScopedStream scopedStream(Random::createStream(Random::Purpose::SelfPlay, 0));
+		Random::Xoshiro256PlusPlus& generator = Random::getGeneratorOfThread();
+		std::uniform_int_distribution<int> distribution(1, 6);
+		for (auto _ : state) {
+			int sum = distribution(generator) + distribution(generator) + distribution(generator);
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	BENCHMARK(benchmarkRollingDiceWithRandomDevice);
+	BENCHMARK(benchmarkRollingDiceWithGeneratorOfThread);
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+
+#include "benchmark/benchmark.h"
+#include "../game/board.hpp"
+#include "crow/json.h"
+#include <fstream>
+#include "../ai/packed_training_examples.hpp"
+#include <random>
+#include "../ai/replay_buffer.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace Benchmarks {
+
+	constexpr int NUMBER_OF_EXAMPLES_TO_PREPROCESS = 100000;
+
+	/* Function `createReplayRecords` creates replay records of settlements, cities, walls, roads, and passes
+	* at random locations with a fixed seed.
+	*/
+	std::vector<AI::ReplayRecord> createReplayRecords(int numberOfRecords) {
+		std::mt19937 randomEngine(42);
+		std::uniform_int_distribution<int> distributionOfTypes(0, 4);
+		std::uniform_int_distribution<int> distributionOfVertices(1, Game::NUMBER_OF_VERTICES);
+		std::uniform_int_distribution<int> distributionOfEdges(1, Game::NUMBER_OF_EDGES);
+		const char* typesOfMoves[] = { "settlement", "city", "wall", "road", "pass" };
+		GameState gameState;
+		std::vector<AI::ReplayRecord> vectorOfReplayRecords;
+		vectorOfReplayRecords.reserve(numberOfRecords);
+		for (int i = 0; i < numberOfRecords; i++) {
+			std::string moveType = typesOfMoves[distributionOfTypes(randomEngine)];
+			std::string move =
+				(moveType == "pass") ? "pass" :
+				(moveType == "road") ? Game::formatLabel('E', distributionOfEdges(randomEngine)) :
+				Game::formatLabel('V', distributionOfVertices(randomEngine));
+			vectorOfReplayRecords.push_back(AI::encodeReplayRecord(1, gameState, move, moveType, (i % 2 == 0) ? 1.0 : -1.0, 0.25));
+		}
+		return vectorOfReplayRecords;
+	}
+
+	/* Function `getIsometricCoordinatesAsBefore` parses the file of isometric coordinates once, as `Board` did
+	* before the topology of the board was compiled in, for the baseline below.
+	*/
+	const crow::json::rvalue& getIsometricCoordinatesAsBefore() {
+		static const crow::json::rvalue isometricCoordinates = [] {
+			std::ifstream file("../generate_board_geometry/isometric_coordinates.json");
+			if (!file.is_open()) {
+				throw std::runtime_error("Isometric coordinates file could not be opened.");
+			}
+			std::stringstream buffer;
+			buffer << file.rdbuf();
+			return crow::json::load(buffer.str());
+		}();
+		return isometricCoordinates;
+	}
+
+	/* Function `getGridRepresentationForMoveAsBefore` builds the grid representation of a move
+	* from the isometric coordinates of every hex, vertex, and edge, as `Board::getGridRepresentationForMove` did
+	* before the grid of the board was computed once. It is kept as a baseline for comparison.
+	*/
+	std::vector<float> getGridRepresentationForMoveAsBefore(const std::string& move, const std::string& typeOfMove) {
+		const crow::json::rvalue& isometricCoordinates = getIsometricCoordinatesAsBefore();
+		std::vector<std::vector<int>> grid(Board::DIMENSION_OF_GRID, std::vector<int>(Board::DIMENSION_OF_GRID, 0));
+		const crow::json::rvalue& jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices = isometricCoordinates["objectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices"];
+		const crow::json::rvalue& jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges = isometricCoordinates["objectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges"];
+		const crow::json::rvalue& jsonObjectOfIdsOfHexesAndNamesOfResources = isometricCoordinates["objectOfIdsOfHexesAndNamesOfResources"];
+		const char* namesOfResources[] = { "nothing", "brick", "grain", "lumber", "ore", "wool" };
+		for (const crow::json::rvalue& pairOfCoordinates : isometricCoordinates["objectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes"]) {
+			std::string nameOfResource = jsonObjectOfIdsOfHexesAndNamesOfResources[pairOfCoordinates.key()].s();
+			int code = 0;
+			for (int i = 0; i < 6; i++) {
+				if (nameOfResource == namesOfResources[i]) {
+					code = i + 1;
+				}
+			}
+			grid[static_cast<int>(pairOfCoordinates[1].d())][static_cast<int>(pairOfCoordinates[0].d())] = code;
+		}
+		for (const crow::json::rvalue& pairOfCoordinates : jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices) {
+			grid[static_cast<int>(pairOfCoordinates[1].d())][static_cast<int>(pairOfCoordinates[0].d())] = 7;
+		}
+		for (const crow::json::rvalue& pairOfCoordinates : jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges) {
+			grid[static_cast<int>(pairOfCoordinates[1].d())][static_cast<int>(pairOfCoordinates[0].d())] = 8;
+		}
+		if (typeOfMove == "settlement" || typeOfMove == "city" || typeOfMove == "wall") {
+			if (jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices.has(move)) {
+				const auto& pairOfCoordinates = jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices[move];
+				grid[static_cast<int>(pairOfCoordinates[1].d())][static_cast<int>(pairOfCoordinates[0].d())] =
+					(typeOfMove == "settlement") ? 9 : (typeOfMove == "city") ? 10 : 12;
+			}
+		}
+		else if (typeOfMove == "road") {
+			if (jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges.has(move)) {
+				const auto& pairOfCoordinates = jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges[move];
+				grid[static_cast<int>(pairOfCoordinates[1].d())][static_cast<int>(pairOfCoordinates[0].d())] = 11;
+			}
+		}
+		std::vector<float> vectorRepresentingGrid;
+		vectorRepresentingGrid.reserve(Board::NUMBER_OF_CELLS_OF_GRID);
+		for (const std::vector<int> row : grid) {
+			for (int cell : row) {
+				vectorRepresentingGrid.push_back(static_cast<float>(cell));
+			}
+		}
+		return vectorRepresentingGrid;
+	}
+
+	/* Function `benchmarkPreprocessingTrainingExamplesAsBefore` measures building features of 100,000 examples
+	* one vector per example and gathering them into one buffer of floats, as `Trainer::trainNeuralNetwork` did
+	* before examples were packed. Creating a tensor per example and stacking the tensors, which added to this cost, is not measured,
+	* since this project does not link libtorch.
+	*/
+	void benchmarkPreprocessingTrainingExamplesAsBefore(benchmark::State& state) {
+		Board board;
+		std::vector<AI::ReplayRecord> vectorOfReplayRecords = createReplayRecords(NUMBER_OF_EXAMPLES_TO_PREPROCESS);
+		for (auto _ : state) {
+			std::vector<std::vector<float>> vectorOfFeatureVectors;
+			std::vector<double> vectorOfValues;
+			std::vector<double> vectorOfPolicies;
+			for (const AI::ReplayRecord& replayRecord : vectorOfReplayRecords) {
+				vectorOfFeatureVectors.push_back(getGridRepresentationForMoveAsBefore(replayRecord.getMove(), replayRecord.getMoveType()));
+				vectorOfValues.push_back(replayRecord.value);
+				vectorOfPolicies.push_back(replayRecord.policy);
+			}
+			std::vector<float> features;
+			features.reserve(vectorOfFeatureVectors.size() * Board::NUMBER_OF_CELLS_OF_GRID);
+			for (const std::vector<float>& featureVector : vectorOfFeatureVectors) {
+				features.insert(features.end(), featureVector.begin(), featureVector.end());
+			}
+			benchmark::DoNotOptimize(features.data());
+		}
+		state.SetItemsProcessed(state.iterations() * NUMBER_OF_EXAMPLES_TO_PREPROCESS);
+		state.counters["bytesOfFeatures"] = static_cast<double>(NUMBER_OF_EXAMPLES_TO_PREPROCESS) * Board::NUMBER_OF_CELLS_OF_GRID * sizeof(float);
+	}
+	BENCHMARK(benchmarkPreprocessingTrainingExamplesAsBefore)->Unit(benchmark::kMillisecond);
+
+	// Function `benchmarkPackingTrainingExamples` measures packing 100,000 examples into columns that are wrapped as tensors without copying.
+	void benchmarkPackingTrainingExamples(benchmark::State& state) {
+		std::vector<AI::ReplayRecord> vectorOfReplayRecords = createReplayRecords(NUMBER_OF_EXAMPLES_TO_PREPROCESS);
+		for (auto _ : state) {
+			AI::PackedTrainingExamples packedTrainingExamples = AI::packTrainingExamples(vectorOfReplayRecords);
+			benchmark::DoNotOptimize(packedTrainingExamples.features.data());
+		}
+		state.SetItemsProcessed(state.iterations() * NUMBER_OF_EXAMPLES_TO_PREPROCESS);
+		state.counters["bytesOfFeatures"] = static_cast<double>(NUMBER_OF_EXAMPLES_TO_PREPROCESS) * Board::NUMBER_OF_CELLS_OF_GRID;
+	}
+	BENCHMARK(benchmarkPackingTrainingExamples)->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,250 @@
+// Project `catan_selfplay` plays games of self play without the database or the server and writes their training examples to shards of a replay buffer.
+// It measures search and self play in isolation and generates training data on machines without MySQL.
+// Run `catan_selfplay.exe --config config.json --games 64 --threads 8 --seed 1` from directory `back_end`.
+// Run `catan_selfplay.exe --exportTrace traces/search_1.trace` to convert a trace of a search into a Chrome trace and a tree of text.
+
+// Change C++ Language Standard to ISO C++20 Standard (/std:c++20).
+
+#include <algorithm>
+#include <atomic>
+#include "../game/board_topology.hpp"
+#include <chrono>
+#include "../config.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include "../logger.hpp"
+#include <mutex>
+#include <optional>
+#include "../random.hpp"
+#include "../ai/replay_buffer.hpp"
+#include "../ai/self_play.hpp"
+#include "../ai/mcts/search_tracer.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+const std::string USAGE_OF_CATAN_SELFPLAY =
+	"Usage: catan_selfplay [--config <path>] [--games <number>] [--threads <number>] [--seed <number>] [--indexOfFirstGame <number>] [--pathToReplayBuffer <path>]\n"
+	"       catan_selfplay --exportTrace <path>\n"
+	"    --config              configuration file; default config.json\n"
+	"    --games               number of games to play; default 16\n"
+	"    --threads             number of games played in parallel; default the number of hardware threads\n"
+	"    --seed                seed of all random streams; default key \"seed\" of the configuration, where 0 draws a seed from the random device\n"
+	"    --indexOfFirstGame    index of the stream of the first game, so that machines with the same seed can play disjoint games; default 0\n"
+	"    --pathToReplayBuffer  directory of shards; default key \"pathToReplayBuffer\" of the configuration\n"
+	"    --exportTrace         trace of a search saved by /recommendMove to write as <path>.json for chrome://tracing and <path>.tree instead of playing\n";
+
+
+// Structure `ArgumentsOfSelfPlay` holds the options of the command line of `catan_selfplay`.
+struct ArgumentsOfSelfPlay {
+	std::string pathToConfig = "config.json";
+	int numberOfGames = 16;
+	int numberOfThreads = 0;
+	std::optional<uint64_t> seed;
+	uint64_t indexOfFirstGame = 0;
+	std::optional<std::string> pathToReplayBuffer;
+	std::optional<std::string> pathToTraceToExport;
+};
+
+
+// Function `parseArguments` parses pairs of options and values and throws `std::invalid_argument` for an unknown option or a missing or invalid value.
+ArgumentsOfSelfPlay parseArguments(int argc, char* argv[]) {
+	ArgumentsOfSelfPlay arguments;
+	for (int i = 1; i < argc; i += 2) {
+		std::string option = argv[i];
+		if (i + 1 >= argc) {
+			throw std::invalid_argument("Option " + option + " requires a value.");
+		}
+		std::string value = argv[i + 1];
+		if (option == "--config") {
+			arguments.pathToConfig = value;
+		}
+		else if (option == "--games") {
+			arguments.numberOfGames = std::stoi(value);
+		}
+		else if (option == "--threads") {
+			arguments.numberOfThreads = std::stoi(value);
+		}
+		else if (option == "--seed") {
+			arguments.seed = std::stoull(value);
+		}
+		else if (option == "--indexOfFirstGame") {
+			arguments.indexOfFirstGame = std::stoull(value);
+		}
+		else if (option == "--pathToReplayBuffer") {
+			arguments.pathToReplayBuffer = value;
+		}
+		else if (option == "--exportTrace") {
+			arguments.pathToTraceToExport = value;
+		}
+		else {
+			throw std::invalid_argument("Option " + option + " is not known.");
+		}
+	}
+	if (arguments.numberOfGames < 1) {
+		throw std::invalid_argument("The number of games must be positive.");
+	}
+	return arguments;
+}
+
+
+// Function `exportTrace` writes a trace of a search as a Chrome trace to `<path>.json` and as a tree of text to `<path>.tree`.
+void exportTrace(const std::string& pathToTrace) {
+	AI::MCTS::SearchTrace searchTrace = AI::MCTS::loadSearchTrace(pathToTrace);
+	auto writeFile = [](const std::string& path, const std::string& text) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << text;
+		if (!file) {
+			throw std::runtime_error("File " + path + " could not be written.");
+		}
+	};
+	writeFile(pathToTrace + ".json", AI::MCTS::exportChromeTrace(searchTrace));
+	writeFile(pathToTrace + ".tree", AI::MCTS::exportTree(searchTrace));
+	std::cout
+		<< "Exported " << searchTrace.vectorOfSimulations.size() << " of " << searchTrace.numberOfSimulations << " simulations to "
+		<< pathToTrace << ".json and " << pathToTrace << ".tree." << std::endl;
+}
+
+
+int main(int argc, char* argv[]) {
+
+	ArgumentsOfSelfPlay arguments;
+	try {
+		arguments = parseArguments(argc, argv);
+	}
+	catch (const std::exception& e) {
+		Logger::error("catan_selfplay during parsing arguments", e);
+		std::cerr << USAGE_OF_CATAN_SELFPLAY;
+		return EXIT_FAILURE;
+	}
+
+	if (arguments.pathToTraceToExport) {
+		try {
+			exportTrace(*arguments.pathToTraceToExport);
+		}
+		catch (const std::exception& e) {
+			Logger::error("catan_selfplay during exporting trace", e);
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	Config::Config config;
+	try {
+		config = config.load(arguments.pathToConfig);
+		Logger::setMinimumLevel(Logger::levelFromString(config.minimumLevelOfLogs));
+		Logger::setFormat(Logger::formatFromString(config.formatOfLogs));
+		if (!config.pathToIsometricCoordinates.empty()) {
+			Game::setBoardTopology(Game::loadBoardTopology(config.pathToIsometricCoordinates));
+		}
+	}
+	catch (const std::exception& e) {
+		Logger::error("catan_selfplay during configuration", e);
+		return EXIT_FAILURE;
+	}
+
+	// As in the back end, a seed of 0 draws a seed from the random device; the seed is logged so that the run can be reproduced.
+	uint64_t seed = arguments.seed.value_or(static_cast<uint64_t>(config.seed));
+	if (seed == 0) {
+		seed = Random::createSeedFromDevice();
+	}
+	Random::setSeed(seed);
+	Logger::info("Random streams were seeded with " + std::to_string(seed) + ".");
+
+	const int numberOfThreads = std::min(
+		arguments.numberOfGames,
+		arguments.numberOfThreads > 0 ? arguments.numberOfThreads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))
+	);
+
+	try {
+		AI::SpecificationOfNeuralNetwork specificationOfNeuralNetwork;
+		specificationOfNeuralNetwork.architecture = config.architecture;
+		specificationOfNeuralNetwork.policyHead = AI::policyHeadFromString(config.policyHead);
+		specificationOfNeuralNetwork.numberOfNeurons = config.numberOfNeurons;
+		specificationOfNeuralNetwork.numberOfChannels = config.numberOfChannels;
+		specificationOfNeuralNetwork.numberOfResidualBlocks = config.numberOfResidualBlocks;
+		AI::WrapperOfNeuralNetwork neuralNet(config.modelPath, specificationOfNeuralNetwork);
+
+		AI::ReplayBuffer replayBuffer(
+			arguments.pathToReplayBuffer.value_or(config.pathToReplayBuffer),
+			config.numberOfRecordsPerShard,
+			config.sizeOfReplayWindow
+		);
+
+		Logger::info(
+			"[SELF PLAY] " + std::to_string(arguments.numberOfGames) + " games from index " + std::to_string(arguments.indexOfFirstGame) +
+			" will be played on " + std::to_string(numberOfThreads) + " threads with " + std::to_string(config.numberOfSimulations) + " simulations per move."
+		);
+
+		std::atomic<int> indexOfNextGame{ 0 };
+		std::atomic<long long> numberOfMoves{ 0 };
+		std::atomic<long long> numberOfSimulations{ 0 };
+		std::atomic<long long> numberOfRecords{ 0 };
+		std::mutex mutexOfException;
+		std::exception_ptr exception;
+		const long long numberOfEvaluationsAtStart = neuralNet.getNumberOfEvaluations();
+		std::chrono::steady_clock::time_point timeOfStart = std::chrono::steady_clock::now();
+		{
+			std::vector<std::jthread> vectorOfThreads;
+			for (int i = 0; i < numberOfThreads; i++) {
+				vectorOfThreads.emplace_back([&]() {
+					for (int indexOfGame = indexOfNextGame++; indexOfGame < arguments.numberOfGames; indexOfGame = indexOfNextGame++) {
+						try {
+							AI::StatisticsOfSelfPlayGame statistics;
+							std::vector<AI::TrainingExample> vectorOfTrainingExamples = AI::runSelfPlayGame(
+								arguments.indexOfFirstGame + static_cast<uint64_t>(indexOfGame),
+								neuralNet,
+								config.numberOfSimulations,
+								config.cPuct,
+								config.tolerance,
+								config.dirichletMixingWeight,
+								config.dirichletShape,
+								config.randomizesBoardLayouts,
+								&statistics
+							);
+							std::vector<AI::ReplayRecord> vectorOfReplayRecords = AI::encodeReplayRecords(vectorOfTrainingExamples);
+							replayBuffer.append(vectorOfReplayRecords);
+							numberOfMoves += statistics.numberOfMoves;
+							numberOfSimulations += statistics.numberOfSimulations;
+							numberOfRecords += static_cast<long long>(vectorOfReplayRecords.size());
+						}
+						catch (...) {
+							std::lock_guard<std::mutex> lock(mutexOfException);
+							if (!exception) {
+								exception = std::current_exception();
+							}
+							indexOfNextGame = arguments.numberOfGames;
+						}
+					}
+				});
+			}
+		}
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+		std::chrono::duration<double> durationOfSelfPlay = std::chrono::steady_clock::now() - timeOfStart;
+		const double seconds = durationOfSelfPlay.count();
+		const long long numberOfEvaluations = neuralNet.getNumberOfEvaluations() - numberOfEvaluationsAtStart;
+		const long long numberOfMovesMade = numberOfMoves.load();
+		const long long numberOfSimulationsRun = numberOfSimulations.load();
+
+		std::cout
+			<< "Played " << arguments.numberOfGames << " games on " << numberOfThreads << " threads in " << seconds << " s with seed " << seed << ".\n"
+			<< "games/s:          " << arguments.numberOfGames / seconds << "\n"
+			<< "moves/s:          " << numberOfMovesMade / seconds << " (" << numberOfMovesMade << " moves)\n"
+			<< "simulations/s:    " << numberOfSimulationsRun / seconds << " (" << numberOfSimulationsRun << " simulations)\n"
+			<< "NN evaluations/s: " << numberOfEvaluations / seconds << " (" << numberOfEvaluations << " evaluations)\n"
+			<< "Wrote " << numberOfRecords.load() << " records to " << arguments.pathToReplayBuffer.value_or(config.pathToReplayBuffer) << "." << std::endl;
+	}
+	catch (const std::exception& e) {
+		Logger::error("catan_selfplay during self play", e);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -9,24 +9,50 @@
 namespace Config {
 	class Config {
 	public:
+		std::string architecture;
 		int backEndPort;
 		int batchSize;
 		double cPuct;
 		double dirichletMixingWeight;
 		double dirichletShape;
+		std::string formatOfLogs;
 		std::string dbName;
 		std::string dbHost;
 		std::string dbPassword;
 		unsigned int dbPort;
 		std::string dbUsername;
 		double learningRate;
+		int maximumNumberOfNodes;
+		std::string minimumLevelOfLogs;
 		std::string modelPath;
 		int modelWatcherInterval;
+		int numberOfChannels;
+		int numberOfCheckpointsToKeep;
+		int numberOfComputeThreads;
 		int numberOfEpochs;
+		int numberOfGamesOfArena;
 		int numberOfNeurons;
+		int numberOfRecordsPerShard;
+		int numberOfResidualBlocks;
+		int numberOfSamplesPerTraining;
 		int numberOfSimulations;
+		int numberOfSimulationsOfArena;
+		int numberOfThreadsOfArena;
+		std::string pathToCheckpoints;
+		std::string pathToIsometricCoordinates;
+		std::string pathToReplayBuffer;
+		std::string pathToTraces;
+		std::string policyHead;
+		bool randomizesBoardLayouts;
+		std::string samplingOfReplayBuffer;
+		long long seed;
+		long long seedOfArena;
+		long long sizeOfReplayWindow;
+		bool stopsSearchEarlyWhenLeadIsUnassailable;
+		int timeLimitInMilliseconds;
 		double tolerance;
 		int trainingThreshold;
+		double winRateThresholdOfArena;
 		// TODO: Consider configuring simulation depth.
 
 		static Config load(const std::string& path) {
@@ -41,6 +67,7 @@ namespace Config {
 			if (!configJson) {
 				throw std::runtime_error("Parsing configuration file failed.");
 			}
+			config.architecture = configJson.has("architecture") ? std::string(configJson["architecture"].s()) : "mlp";
 			config.backEndPort = configJson["backEndPort"].i();
 			config.batchSize = configJson["batchSize"].i();
 			config.cPuct = configJson["cPuct"].d();
@@ -51,14 +78,39 @@ namespace Config {
 			config.dbPassword = configJson["dbPassword"].s();
 			config.dbPort = configJson["dbPort"].i();
 			config.dbUsername = configJson["dbUsername"].s();
+			config.formatOfLogs = configJson.has("formatOfLogs") ? std::string(configJson["formatOfLogs"].s()) : "text";
 			config.learningRate = configJson["learningRate"].d();
+			config.maximumNumberOfNodes = configJson.has("maximumNumberOfNodes") ? static_cast<int>(configJson["maximumNumberOfNodes"].i()) : 0;
+			config.minimumLevelOfLogs = configJson.has("minimumLevelOfLogs") ? std::string(configJson["minimumLevelOfLogs"].s()) : "info";
 			config.modelPath = configJson["modelPath"].s();
 			config.modelWatcherInterval = configJson["modelWatcherInterval"].i();
+			config.numberOfChannels = configJson.has("numberOfChannels") ? static_cast<int>(configJson["numberOfChannels"].i()) : 32;
+			config.numberOfCheckpointsToKeep = configJson.has("numberOfCheckpointsToKeep") ? static_cast<int>(configJson["numberOfCheckpointsToKeep"].i()) : 5;
+			config.numberOfComputeThreads = configJson.has("numberOfComputeThreads") ? static_cast<int>(configJson["numberOfComputeThreads"].i()) : 2;
 			config.numberOfEpochs = configJson["numberOfEpochs"].i();
+			config.numberOfGamesOfArena = configJson.has("numberOfGamesOfArena") ? static_cast<int>(configJson["numberOfGamesOfArena"].i()) : 30;
 			config.numberOfNeurons = configJson["numberOfNeurons"].i();
+			config.numberOfRecordsPerShard = configJson.has("numberOfRecordsPerShard") ? static_cast<int>(configJson["numberOfRecordsPerShard"].i()) : 65536;
+			config.numberOfResidualBlocks = configJson.has("numberOfResidualBlocks") ? static_cast<int>(configJson["numberOfResidualBlocks"].i()) : 4;
+			config.numberOfSamplesPerTraining = configJson.has("numberOfSamplesPerTraining") ? static_cast<int>(configJson["numberOfSamplesPerTraining"].i()) : static_cast<int>(configJson["trainingThreshold"].i());
 			config.numberOfSimulations = configJson["numberOfSimulations"].i();
+			config.numberOfSimulationsOfArena = configJson.has("numberOfSimulationsOfArena") ? static_cast<int>(configJson["numberOfSimulationsOfArena"].i()) : config.numberOfSimulations;
+			config.numberOfThreadsOfArena = configJson.has("numberOfThreadsOfArena") ? static_cast<int>(configJson["numberOfThreadsOfArena"].i()) : 0;
+			config.pathToCheckpoints = configJson.has("pathToCheckpoints") ? std::string(configJson["pathToCheckpoints"].s()) : "checkpoints";
+			config.pathToIsometricCoordinates = configJson.has("pathToIsometricCoordinates") ? std::string(configJson["pathToIsometricCoordinates"].s()) : "";
+			config.pathToReplayBuffer = configJson.has("pathToReplayBuffer") ? std::string(configJson["pathToReplayBuffer"].s()) : "replay_buffer";
+			config.pathToTraces = configJson.has("pathToTraces") ? std::string(configJson["pathToTraces"].s()) : "traces";
+			config.policyHead = configJson.has("policyHead") ? std::string(configJson["policyHead"].s()) : "scalar";
+			config.randomizesBoardLayouts = configJson.has("randomizesBoardLayouts") ? configJson["randomizesBoardLayouts"].b() : false;
+			config.samplingOfReplayBuffer = configJson.has("samplingOfReplayBuffer") ? std::string(configJson["samplingOfReplayBuffer"].s()) : "recency";
+			config.seed = configJson.has("seed") ? static_cast<long long>(configJson["seed"].i()) : 0;
+			config.seedOfArena = configJson.has("seedOfArena") ? static_cast<long long>(configJson["seedOfArena"].i()) : 1;
+			config.sizeOfReplayWindow = configJson.has("sizeOfReplayWindow") ? static_cast<long long>(configJson["sizeOfReplayWindow"].i()) : 1000000;
+			config.stopsSearchEarlyWhenLeadIsUnassailable = configJson.has("stopsSearchEarlyWhenLeadIsUnassailable") ? configJson["stopsSearchEarlyWhenLeadIsUnassailable"].b() : true;
+			config.timeLimitInMilliseconds = configJson.has("timeLimitInMilliseconds") ? static_cast<int>(configJson["timeLimitInMilliseconds"].i()) : 0;
 			config.tolerance = configJson["tolerance"].d();
 			config.trainingThreshold = configJson["trainingThreshold"].i();
+			config.winRateThresholdOfArena = configJson.has("winRateThresholdOfArena") ? configJson["winRateThresholdOfArena"].d() : 0.55;
 			return config;
 		}
 	};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../game/game_state.hpp"
+#include "../metrics.hpp"
 #include "models.hpp"
 #include "query_builder.hpp"
 #include <mysqlx/xdevapi.h>
@@ -16,6 +17,9 @@ xcopy /Y /I "$(SolutionDir)\dependencies\<debug or release>_version_of_MySQL_Con
 
 namespace DB {
 
+    // Variable `numberOfSessionsOpenedOnThread` counts the sessions opened on the calling thread, so that middleware can count sessions per request.
+    inline thread_local uint64_t numberOfSessionsOpenedOnThread = 0;
+
     class WrapperOfSession {
     public:
         WrapperOfSession(
@@ -26,6 +30,12 @@ namespace DB {
             const std::string& username
         ) : session(host, port, username, password, dbName) {
             // TODO: Consider performing additional configuration on the session.
+            static Metrics::Counter& counterOfSessions = Metrics::Registry::getInstance().getCounter(
+                "catan_db_sessions_total",
+                "Number of database sessions opened. Each method of `Database` opens one session for its statements."
+            );
+            counterOfSessions.increment();
+            numberOfSessionsOpenedOnThread++;
         }
 
 		mysqlx::Session& getSession() {
@@ -231,29 +241,30 @@ namespace DB {
             for (mysqlx::Row sRow : settlementsResult) {
                 int player = sRow[0];
                 std::string vertex = sRow[1].get<std::string>();
-                gameState.settlements[player].push_back(vertex);
+                gameState.settlements[player].add(Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES));
             }
             mysqlx::Table citiesTable = schema.getTable(tablePrefix + "cities");
             mysqlx::RowResult citiesResult = citiesTable.select("player", "vertex").execute();
             for (mysqlx::Row cRow : citiesResult) {
                 int player = cRow[0];
                 std::string vertex = cRow[1].get<std::string>();
-                gameState.cities[player].push_back(vertex);
+                gameState.cities[player].add(Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES));
             }
             mysqlx::Table roadsTable = schema.getTable(tablePrefix + "roads");
             mysqlx::RowResult roadsResult = roadsTable.select("player", "edge").execute();
             for (mysqlx::Row rRow : roadsResult) {
                 int player = rRow[0];
                 std::string edge = rRow[1].get<std::string>();
-                gameState.roads[player].push_back(edge);
+                gameState.roads[player].add(Game::getIndexOfLabel(edge, Game::NUMBER_OF_EDGES));
             }
 			mysqlx::Table wallsTable = schema.getTable(tablePrefix + "walls");
 			mysqlx::RowResult wallsResult = wallsTable.select("player", "vertex").execute();
 			for (mysqlx::Row wRow : wallsResult) {
 				int player = wRow[0];
 				std::string vertex = wRow[1].get<std::string>();
-				gameState.walls[player].push_back(vertex);
+				gameState.walls[player].add(Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES));
 			}
+			gameState.synchronizeMoveGenerator();
 			mysqlx::Table resourcesTable = schema.getTable(tablePrefix + "resources");
 			mysqlx::RowResult resourcesResult = resourcesTable
                 .select("player", "brick", "grain", "lumber", "ore", "wool", "cloth", "coin", "paper")
@@ -280,6 +291,53 @@ namespace DB {
             return gameState;
         }
 
+        /* Method `getBoardSnapshot` reads all structures, resources, the current player, and the phase
+        * using one session instead of one session per table.
+        */
+        BoardSnapshot getBoardSnapshot() const {
+            BoardSnapshot boardSnapshot;
+            WrapperOfSession wrapperOfSession(dbName, host, password, port, username);
+            mysqlx::Session& session = wrapperOfSession.getSession();
+            mysqlx::Schema schema = session.getSchema(dbName);
+
+            for (mysqlx::Row row : schema.getTable(tablePrefix + "cities").select("id", "player", "vertex").execute()) {
+                boardSnapshot.cities.push_back(City{ row[0], row[1], row[2].get<std::string>() });
+            }
+            for (mysqlx::Row row : schema.getTable(tablePrefix + "settlements").select("id", "player", "vertex").execute()) {
+                boardSnapshot.settlements.push_back(Settlement{ row[0], row[1], row[2].get<std::string>() });
+            }
+            for (mysqlx::Row row : schema.getTable(tablePrefix + "roads").select("id", "player", "edge").execute()) {
+                boardSnapshot.roads.push_back(Road{ row[0], row[1], row[2].get<std::string>() });
+            }
+            for (mysqlx::Row row : schema.getTable(tablePrefix + "walls").select("id", "player", "vertex").execute()) {
+                boardSnapshot.walls.push_back(Wall{ row[0], row[1], row[2].get<std::string>() });
+            }
+            mysqlx::RowResult resourcesResult = schema
+                .getTable(tablePrefix + "resources")
+                .select("player", "brick", "grain", "lumber", "ore", "wool", "cloth", "coin", "paper")
+                .execute();
+            for (mysqlx::Row row : resourcesResult) {
+                int player = row[0];
+                auto& bag = boardSnapshot.resources[player];
+                bag.brick = row[1];
+                bag.grain = row[2];
+                bag.lumber = row[3];
+                bag.ore = row[4];
+                bag.wool = row[5];
+                bag.cloth = row[6];
+                bag.coin = row[7];
+                bag.paper = row[8];
+            }
+            mysqlx::Row rowOfState = schema.getTable(tablePrefix + "state").select("current_player", "phase").where("id = 1").execute().fetchOne();
+            if (rowOfState) {
+                boardSnapshot.currentPlayer = rowOfState[0];
+                if (!rowOfState[1].isNull()) {
+                    boardSnapshot.phase = Game::fromString(rowOfState[1].get<std::string>());
+                }
+            }
+            return boardSnapshot;
+        }
+
         std::vector<Road> getRoads() const {
             std::vector<Road> roads;
             WrapperOfSession wrapperOfSession(dbName, host, password, port, username);
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include "../game/game_state.hpp"
 #include <string>
+#include <vector>
 
 
 struct City {
@@ -28,4 +31,18 @@ struct Wall {
 	int id;
 	int player;
 	std::string vertex;
+};
+
+
+/* Structure `BoardSnapshot` holds all structures, resources, the current player, and the phase of a game
+* as read in a single database session.
+*/
+struct BoardSnapshot {
+	std::vector<City> cities;
+	std::vector<Settlement> settlements;
+	std::vector<Road> roads;
+	std::vector<Wall> walls;
+	std::array<ResourceBag, 4> resources;
+	int currentPlayer{ 1 };
+	Game::Phase phase{ Game::Phase::FirstSettlement };
 };
\ No newline at end of file
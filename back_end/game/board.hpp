@@ -1,10 +1,18 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include "board_layout.hpp"
+#include "board_topology.hpp"
 #include <corecrt_math_defines.h>
-#include "../db/database.hpp"
+#include <cstdint>
+#include "game_state.hpp"
+#include "labels.hpp"
+#include "../logger.hpp"
+#include <memory>
 #include <regex>
-#include <unordered_set>
+#include <utility>
 
 /*#define STB_IMAGE_WRITE_IMPLEMENTATION // This line is required to resolve linker error.
 #include "stb_image_write.h"*/
@@ -17,106 +25,36 @@ class Board {
 
 
 public:
-	
 
-	static crow::json::rvalue isometricCoordinatesCache;
 
-
-	Board() {
-		loadIsometricCoordinates();
-	}
+	static constexpr int DIMENSION_OF_GRID = Game::DIMENSION_OF_GRID;
+	static constexpr int NUMBER_OF_CELLS_OF_GRID = Game::NUMBER_OF_CELLS_OF_GRID;
 
 
-	std::vector<float> getGridRepresentationForMove(const std::string& move, const std::string& typeOfMove) const {
-
-		// Create a 21 x 21 grid of integers initialized to 0.
-		// Index as grid[index_of_row][index_of_column].
-		constexpr int DIMENSION_OF_GRID = 21;
-		std::vector<std::vector<int>> grid(DIMENSION_OF_GRID, std::vector<int>(DIMENSION_OF_GRID, 0));
+	Board() :
+		precomputedBoardLayout(Game::getDefaultPrecomputedBoardLayout())
+	{
+		// Do nothing.
+	}
 
-		const crow::json::rvalue& jsonObjectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes = isometricCoordinatesCache["objectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes"];
-		const crow::json::rvalue& jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices = isometricCoordinatesCache["objectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices"];
-		const crow::json::rvalue& jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges = isometricCoordinatesCache["objectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges"];
 
-		const crow::json::rvalue& jsonObjectOfIdsOfHexesAndNamesOfResources = isometricCoordinatesCache["objectOfIdsOfHexesAndNamesOfResources"];
+	// Constructor `Board` represents a board with a layout of resources and tokens, such as the layout of a game state.
+	explicit Board(std::shared_ptr<const Game::PrecomputedBoardLayout> precomputedBoardLayoutToUse) :
+		precomputedBoardLayout(std::move(precomputedBoardLayoutToUse))
+	{
+		// Do nothing.
+	}
 
-		for (const crow::json::rvalue& pairOfCoordinates : jsonObjectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes) {
-			double x = pairOfCoordinates[0].d();
-			double y = pairOfCoordinates[1].d();
-			std::string idOfHex = pairOfCoordinates.key();
-			std::string nameOfResource = jsonObjectOfIdsOfHexesAndNamesOfResources[idOfHex].s();
-			if (nameOfResource == "nothing") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 1;
-			}
-			else if (nameOfResource == "brick") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 2;
-			}
-			else if (nameOfResource == "grain") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 3;
-			}
-			else if (nameOfResource == "lumber") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 4;
-			}
-			else if (nameOfResource == "ore") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 5;
-			}
-			else if (nameOfResource == "wool") {
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 6;
-			}
-			else {
-				throw std::runtime_error(nameOfResource + " is an unknown resource type.");
-			}
-		}
 
-		for (const crow::json::rvalue& pairOfCoordinates : jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices) {
-			double x = pairOfCoordinates[0].d();
-			double y = pairOfCoordinates[1].d();
-			grid[static_cast<int>(y)][static_cast<int>(x)] = 7;
-		}
+	const Game::BoardLayout& getBoardLayout() const {
+		return precomputedBoardLayout->boardLayout;
+	}
 
-		for (const crow::json::rvalue& pairOfCoordinates : jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges) {
-			double x = pairOfCoordinates[0].d();
-			double y = pairOfCoordinates[1].d();
-			grid[static_cast<int>(y)][static_cast<int>(x)] = 8;
-		}
 
-		if (typeOfMove == "settlement" || typeOfMove == "city") {
-			if (jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices.has(move)) {
-				const auto& pairOfCoordinatesOfVertex = jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices[move];
-				int x = pairOfCoordinatesOfVertex[0].d();
-				int y = pairOfCoordinatesOfVertex[1].d();
-				grid[static_cast<int>(y)][static_cast<int>(x)] = (typeOfMove == "settlement") ? 9 : 10;
-			}
-		}
-		else if (typeOfMove == "road") {
-			if (jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges.has(move)) {
-				const auto& pairOfCoordinates = jsonObjectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges[move];
-				int x = pairOfCoordinates[0].d();
-				int y = pairOfCoordinates[1].d();
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 11;
-			}
-		}
-		else if (typeOfMove == "wall") {
-			if (jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices.has(move)) {
-				int x = jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices[move][0].d();
-				int y = jsonObjectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices[move][1].d();
-				grid[static_cast<int>(y)][static_cast<int>(x)] = 12;
-			}
-		}
-		else if (typeOfMove == "pass") {
-			// Do nothing.
-		}
-		else {
-			throw std::runtime_error(typeOfMove + " is an unknown type of move.");
-		}
-
-		std::vector<float> vectorRepresentingGrid;
-		vectorRepresentingGrid.reserve(DIMENSION_OF_GRID * DIMENSION_OF_GRID);
-		for (const std::vector<int> row : grid) {
-			for (int cell : row) {
-				vectorRepresentingGrid.push_back(static_cast<float>(cell));
-			}
-		}
+	std::vector<float> getGridRepresentationForMove(const std::string& move, const std::string& typeOfMove) const {
+		std::array<uint8_t, NUMBER_OF_CELLS_OF_GRID> cells;
+		writeGridRepresentationForMove(move, typeOfMove, cells.data());
+		std::vector<float> vectorRepresentingGrid(cells.begin(), cells.end());
 
 		/*const int dimensionOfCell = 10;
 		const int widthOfImage = dimensionOfCell * DIMENSION_OF_GRID;
@@ -126,7 +64,7 @@ public:
 
 		for (int row = 0; row < DIMENSION_OF_GRID; row++) {
 			for (int col = 0; col < DIMENSION_OF_GRID; col++) {
-				int value = grid[row][col];
+				int value = cells[row * DIMENSION_OF_GRID + col];
 				int r = 0;
 				int g = 0;
 				int b = 0;
@@ -198,19 +136,65 @@ public:
 	}
 
 
+	// Method `getIndexOfCellOfHex` returns the index of the cell of the grid, in row major order, that represents a hex with a zero based index.
+	int getIndexOfCellOfHex(int indexOfHex) const {
+		return getGridOfBoard().indicesOfCellsOfHexes[indexOfHex];
+	}
+
+
+	// Method `getIndexOfCellOfVertex` returns the index of the cell of the grid, in row major order, that represents a vertex with a zero based index.
+	int getIndexOfCellOfVertex(int indexOfVertex) const {
+		return getGridOfBoard().indicesOfCellsOfVertices[indexOfVertex];
+	}
+
+
+	// Method `getIndexOfCellOfEdge` returns the index of the cell of the grid, in row major order, that represents an edge with a zero based index.
+	int getIndexOfCellOfEdge(int indexOfEdge) const {
+		return getGridOfBoard().indicesOfCellsOfEdges[indexOfEdge];
+	}
+
+
+	/* Method `writeGridRepresentationForMove` writes the codes of the 21 x 21 cells of the grid representation of a move
+	* as bytes in row major order, so that many representations can be packed into one contiguous buffer.
+	* Cells represent nothing (0), a desert (1), a hex of brick, grain, lumber, ore, or wool (2 to 6), a vertex (7), an edge (8),
+	* and a settlement, city, road, or wall being placed (9 to 12).
+	* The grid of the board is computed once per layout; only the cell of the move differs between moves.
+	*/
+	void writeGridRepresentationForMove(const std::string& move, const std::string& typeOfMove, uint8_t* cells) const {
+		const GridOfBoard& gridOfBoard = getGridOfBoard();
+		std::copy(precomputedBoardLayout->cellsOfGrid.begin(), precomputedBoardLayout->cellsOfGrid.end(), cells);
+
+		if (typeOfMove == "settlement" || typeOfMove == "city" || typeOfMove == "wall") {
+			if (move.size() == 3 && move[0] == 'V') {
+				int indexOfCell = gridOfBoard.indicesOfCellsOfVertices[Game::getIndexOfLabel(move, Game::NUMBER_OF_VERTICES)];
+				cells[indexOfCell] = (typeOfMove == "settlement") ? 9 : (typeOfMove == "city") ? 10 : 12;
+			}
+		}
+		else if (typeOfMove == "road") {
+			if (move.size() == 3 && move[0] == 'E') {
+				int indexOfCell = gridOfBoard.indicesOfCellsOfEdges[Game::getIndexOfLabel(move, Game::NUMBER_OF_EDGES)];
+				cells[indexOfCell] = 11;
+			}
+		}
+		else if (typeOfMove == "pass") {
+			// Do nothing.
+		}
+		else {
+			throw std::runtime_error(typeOfMove + " is an unknown type of move.");
+		}
+	}
+
+
 	std::vector<std::string> getVectorOfLabelsOfAvailableEdges(const std::vector<std::string>& vectorOfLabelsOfOccupiedEdges) const {
-		const crow::json::rvalue& jsonObjectOfLabelsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges = isometricCoordinatesCache["objectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges"];
-		
-		std::vector<std::string> vectorOfLabelsOfEdges;
-		vectorOfLabelsOfEdges.reserve(jsonObjectOfLabelsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges.size());
-		for (const crow::json::rvalue& keyValuePair : jsonObjectOfLabelsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges) {
-			vectorOfLabelsOfEdges.push_back(keyValuePair.key());
+		std::array<bool, Game::NUMBER_OF_EDGES> edgeIsOccupied{};
+		for (const std::string& labelOfOccupiedEdge : vectorOfLabelsOfOccupiedEdges) {
+			edgeIsOccupied[Game::getIndexOfLabel(labelOfOccupiedEdge, Game::NUMBER_OF_EDGES)] = true;
 		}
 
 		std::vector<std::string> vectorOfLabelsOfAvailableEdges;
-		for (const auto& labelOfEdge : vectorOfLabelsOfEdges) {
-			if (std::find(vectorOfLabelsOfOccupiedEdges.begin(), vectorOfLabelsOfOccupiedEdges.end(), labelOfEdge) == vectorOfLabelsOfOccupiedEdges.end()) {
-				vectorOfLabelsOfAvailableEdges.push_back(labelOfEdge);
+		for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+			if (!edgeIsOccupied[indexOfEdge]) {
+				vectorOfLabelsOfAvailableEdges.push_back(Game::formatLabel('E', indexOfEdge + 1));
 			}
 		}
 
@@ -222,11 +206,14 @@ public:
 		const std::string& labelOfVertexOfLastBuilding,
 		const std::vector<std::string>& vectorOfLabelsOfOccupiedEdges
 	) const {
-		const crow::json::rvalue& jsonObjectOfAdjacencyInformation = isometricCoordinatesCache["objectOfIdsOfVerticesAndListsOfEdgesExtendingFromThoseVertices"];
+		const Game::BoardTopology& boardTopology = Game::getBoardTopology();
 
 		std::vector<std::string> vectorOfLabelsOfAvailableEdges;
-		for (const crow::json::rvalue& jsonObjectWithLabelOfEdge : jsonObjectOfAdjacencyInformation[labelOfVertexOfLastBuilding]) {
-			std::string labelOfEdge = jsonObjectWithLabelOfEdge.s();
+		for (int indexOfEdge : boardTopology.indicesOfEdgesOfVertices[Game::getIndexOfLabel(labelOfVertexOfLastBuilding, Game::NUMBER_OF_VERTICES)]) {
+			if (indexOfEdge < 0) {
+				continue;
+			}
+			std::string labelOfEdge = Game::formatLabel('E', indexOfEdge + 1);
 			if (std::find(vectorOfLabelsOfOccupiedEdges.begin(), vectorOfLabelsOfOccupiedEdges.end(), labelOfEdge) == vectorOfLabelsOfOccupiedEdges.end()) {
 				vectorOfLabelsOfAvailableEdges.push_back(labelOfEdge);
 			}
@@ -237,70 +224,65 @@ public:
 
 
 	std::vector<std::string> getVectorOfLabelsOfAvailableVertices(const std::vector<std::string>& vectorOfLabelsOfOccupiedVertices) const {
-		const crow::json::rvalue& jsonObjectOfLabelsOfVerticesAndPairsOfCoordinatesOfVertices = isometricCoordinatesCache["objectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices"];
-		const crow::json::rvalue& jsonObjectOfLabelsOfVerticesAndListsOfLabelsOfAdjacentVertices = isometricCoordinatesCache["objectOfIdsOfVerticesAndListsOfIdsOfAdjacentVertices"];
-		
-		std::unordered_set<std::string> unorderedSetOfLabelsOfOccupiedVertices(vectorOfLabelsOfOccupiedVertices.begin(), vectorOfLabelsOfOccupiedVertices.end());
+		const Game::BoardTopology& boardTopology = Game::getBoardTopology();
+
+		std::array<bool, Game::NUMBER_OF_VERTICES> vertexIsOccupied{};
+		for (const std::string& labelOfOccupiedVertex : vectorOfLabelsOfOccupiedVertices) {
+			vertexIsOccupied[Game::getIndexOfLabel(labelOfOccupiedVertex, Game::NUMBER_OF_VERTICES)] = true;
+		}
+
 		std::vector<std::string> vectorOfLabelsOfAvailableVertices;
-		
-		for (const crow::json::rvalue& keyValuePair : jsonObjectOfLabelsOfVerticesAndPairsOfCoordinatesOfVertices) {
-			const std::string labelOfVertex = keyValuePair.key();
-			if (unorderedSetOfLabelsOfOccupiedVertices.contains(labelOfVertex)) {
+		for (int indexOfVertex = 0; indexOfVertex < Game::NUMBER_OF_VERTICES; indexOfVertex++) {
+			if (vertexIsOccupied[indexOfVertex]) {
 				continue;
 			}
 			bool adjacentVertexIsOccupied = false;
-			for (const crow::json::rvalue& jsonObjectWithLabelOfAdjacentVertex : jsonObjectOfLabelsOfVerticesAndListsOfLabelsOfAdjacentVertices[labelOfVertex]) {
-				std::string labelOfAdjacentVertex = jsonObjectWithLabelOfAdjacentVertex.s();
-				if (unorderedSetOfLabelsOfOccupiedVertices.contains(labelOfAdjacentVertex)) {
+			for (int indexOfAdjacentVertex : boardTopology.indicesOfAdjacentVertices[indexOfVertex]) {
+				if (indexOfAdjacentVertex >= 0 && vertexIsOccupied[indexOfAdjacentVertex]) {
 					adjacentVertexIsOccupied = true;
 					break;
 				}
 			}
 			if (!adjacentVertexIsOccupied) {
-				vectorOfLabelsOfAvailableVertices.push_back(labelOfVertex);
+				vectorOfLabelsOfAvailableVertices.push_back(Game::formatLabel('V', indexOfVertex + 1));
 			}
 		}
 		return vectorOfLabelsOfAvailableVertices;
 	}
 
 
-	std::vector<std::string> getVectorOfLabelsOfOccupiedVertices(GameState gameState) {
+	std::vector<std::string> getVectorOfLabelsOfOccupiedVertices(const GameState& gameState) const {
+		const Game::MasksOfBoard& masksOfBoard = Game::getMasksOfBoard();
 		std::vector<std::string> vectorOfLabelsOfOccupiedVertices;
-		for (const auto& [player, vectorOfLabelsOfVerticesWithSettlements] : gameState.settlements) {
-			vectorOfLabelsOfOccupiedVertices.insert(
-				vectorOfLabelsOfOccupiedVertices.end(),
-				vectorOfLabelsOfVerticesWithSettlements.begin(),
-				vectorOfLabelsOfVerticesWithSettlements.end()
-			);
+		for (int player = 1; player <= 3; player++) {
+			for (int indexOfVertex : gameState.settlements[player]) {
+				vectorOfLabelsOfOccupiedVertices.push_back(masksOfBoard.labelsOfVertices[indexOfVertex]);
+			}
 		}
-		for (const auto& [player, vectorOfLabelsOfVerticesWithCities] : gameState.cities) {
-			vectorOfLabelsOfOccupiedVertices.insert(
-				vectorOfLabelsOfOccupiedVertices.end(),
-				vectorOfLabelsOfVerticesWithCities.begin(),
-				vectorOfLabelsOfVerticesWithCities.end()
-			);
+		for (int player = 1; player <= 3; player++) {
+			for (int indexOfVertex : gameState.cities[player]) {
+				vectorOfLabelsOfOccupiedVertices.push_back(masksOfBoard.labelsOfVertices[indexOfVertex]);
+			}
 		}
 		return vectorOfLabelsOfOccupiedVertices;
 	}
 
 
-	std::vector<std::string> getVectorOfLabelsOfOccupiedEdges(GameState gameState) {
+	std::vector<std::string> getVectorOfLabelsOfOccupiedEdges(const GameState& gameState) const {
+		const Game::MasksOfBoard& masksOfBoard = Game::getMasksOfBoard();
 		std::vector<std::string> vectorOfLabelsOfOccupiedEdges;
-		for (const auto& [player, vectorOfLabelsOfEdgesWithRoads] : gameState.roads) {
-			vectorOfLabelsOfOccupiedEdges.insert(
-				vectorOfLabelsOfOccupiedEdges.end(),
-				vectorOfLabelsOfEdgesWithRoads.begin(),
-				vectorOfLabelsOfEdgesWithRoads.end()
-			);
+		for (int player = 1; player <= 3; player++) {
+			for (int indexOfEdge : gameState.roads[player]) {
+				vectorOfLabelsOfOccupiedEdges.push_back(masksOfBoard.labelsOfEdges[indexOfEdge]);
+			}
 		}
 		return vectorOfLabelsOfOccupiedEdges;
 	}
 
 
 	std::pair<std::string, std::string> getVerticesOfEdge(const std::string& labelOfEdge) const {
-		const crow::json::rvalue& jsonObjectOfLabelsOfEdgesAndPairsOfLabelsOfVertices = isometricCoordinatesCache["objectOfIdsOfEdgesAndPairsOfIdsOfVertices"];
-		const auto& pair = jsonObjectOfLabelsOfEdgesAndPairsOfLabelsOfVertices[labelOfEdge];
-		return { pair[0].s(), pair[1].s() };
+		const std::array<int, 2>& indicesOfVertices = Game::getBoardTopology().indicesOfVerticesOfEdges[Game::getIndexOfLabel(labelOfEdge, Game::NUMBER_OF_EDGES)];
+		return { Game::formatLabel('V', indicesOfVertices[0] + 1), Game::formatLabel('V', indicesOfVertices[1] + 1) };
 	}
 
 
@@ -328,22 +310,36 @@ public:
 private:
 
 
-	void loadIsometricCoordinates() {
-		static std::once_flag onceFlag;
-		std::call_once(onceFlag, [] {
-			std::ifstream file("../generate_board_geometry/isometric_coordinates.json");
-			if (!file.is_open()) {
-				throw std::runtime_error("Isometric coordinates file could not be opened.");
-			}
-			std::stringstream buffer;
-			buffer << file.rdbuf();
-			isometricCoordinatesCache = crow::json::load(buffer.str());
-			if (!isometricCoordinatesCache) {
-				throw std::runtime_error("Isometric coordinates file could not be parsed.");
-			}
-		});
+	std::shared_ptr<const Game::PrecomputedBoardLayout> precomputedBoardLayout;
+
+
+	struct GridOfBoard {
+		std::array<int, Game::NUMBER_OF_HEXES> indicesOfCellsOfHexes{};
+		std::array<int, Game::NUMBER_OF_VERTICES> indicesOfCellsOfVertices{};
+		std::array<int, Game::NUMBER_OF_EDGES> indicesOfCellsOfEdges{};
+	};
+
+
+	// Function `getGridOfBoard` returns the cells of the grid of hexes, vertices, and edges, which are the same for every layout.
+	static const GridOfBoard& getGridOfBoard() {
+		static const GridOfBoard gridOfBoard = createGridOfBoard();
+		return gridOfBoard;
 	}
-};
 
 
-crow::json::rvalue Board::isometricCoordinatesCache;
\ No newline at end of file
+	// Function `createGridOfBoard` finds the cells of a 21 x 21 grid indexed as cells[index_of_row * 21 + index_of_column] of every hex, vertex, and edge.
+	static GridOfBoard createGridOfBoard() {
+		const Game::BoardTopology& boardTopology = Game::getBoardTopology();
+		GridOfBoard gridOfBoard;
+		for (int indexOfHex = 0; indexOfHex < Game::NUMBER_OF_HEXES; indexOfHex++) {
+			gridOfBoard.indicesOfCellsOfHexes[indexOfHex] = Game::getIndexOfCellOfGrid(boardTopology.coordinatesOfCentersOfHexes[indexOfHex]);
+		}
+		for (int indexOfVertex = 0; indexOfVertex < Game::NUMBER_OF_VERTICES; indexOfVertex++) {
+			gridOfBoard.indicesOfCellsOfVertices[indexOfVertex] = Game::getIndexOfCellOfGrid(boardTopology.coordinatesOfVertices[indexOfVertex]);
+		}
+		for (int indexOfEdge = 0; indexOfEdge < Game::NUMBER_OF_EDGES; indexOfEdge++) {
+			gridOfBoard.indicesOfCellsOfEdges[indexOfEdge] = Game::getIndexOfCellOfGrid(boardTopology.coordinatesOfCentersOfEdges[indexOfEdge]);
+		}
+		return gridOfBoard;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include "board_topology.hpp"
+#include <cstdint>
+#include "labels.hpp"
+#include <memory>
+#include <mutex>
+#include "resource_bag.hpp"
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Game {
+
+	constexpr int DIMENSION_OF_GRID = 21;
+	constexpr int NUMBER_OF_CELLS_OF_GRID = DIMENSION_OF_GRID * DIMENSION_OF_GRID;
+	constexpr int MAXIMUM_SUM_OF_DICE = 12;
+	// Brick, grain, lumber, ore, and wool are produced by hexes, in the order of `Game::Resource` and of `ResourceBag`.
+	constexpr int NUMBER_OF_PRODUCED_RESOURCES = 5;
+	constexpr int MAXIMUM_NUMBER_OF_ATTEMPTS_TO_CREATE_BOARD_LAYOUT = 10000;
+	constexpr size_t MAXIMUM_NUMBER_OF_CACHED_BOARD_LAYOUTS = 1024;
+
+	/* Structure `BoardLayout` assigns a resource and a number of token to every hex of the board topology in use.
+	* The hexes, vertices, and edges are those of the topology; a layout only shuffles terrain and tokens over them.
+	* A hex that produces nothing, such as the desert, has a number of token that no sum of the dice matches.
+	*/
+	struct BoardLayout {
+		std::array<Resource, NUMBER_OF_HEXES> resourcesOfHexes{};
+		std::array<int, NUMBER_OF_HEXES> numbersOfTokensOfHexes{};
+
+		bool operator==(const BoardLayout& other) const = default;
+
+		// Method `getCodeOfHex` packs the resource and number of token of a hex into one byte as resource + 8 * number of token.
+		uint8_t getCodeOfHex(int indexOfHex) const {
+			return static_cast<uint8_t>(static_cast<int>(resourcesOfHexes[indexOfHex]) + 8 * numbersOfTokensOfHexes[indexOfHex]);
+		}
+
+		// Method `getHash` returns the 64 bit FNV-1a hash of the codes of the hexes.
+		uint64_t getHash() const {
+			uint64_t hash = 14695981039346656037ull;
+			for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+				hash ^= getCodeOfHex(indexOfHex);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// Function `fromCodesOfHexes` unpacks a layout from the codes of its hexes written by `getCodeOfHex`.
+		static BoardLayout fromCodesOfHexes(const uint8_t* codesOfHexes) {
+			BoardLayout boardLayout;
+			for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+				const int codeOfResource = codesOfHexes[indexOfHex] & 7;
+				if (codeOfResource > static_cast<int>(Resource::Wool)) {
+					throw std::runtime_error("Code " + std::to_string(codesOfHexes[indexOfHex]) + " of a hex has an unknown resource.");
+				}
+				boardLayout.resourcesOfHexes[indexOfHex] = static_cast<Resource>(codeOfResource);
+				boardLayout.numbersOfTokensOfHexes[indexOfHex] = codesOfHexes[indexOfHex] >> 3;
+			}
+			return boardLayout;
+		}
+	};
+
+
+	// Function `getDefaultBoardLayout` returns the resources and tokens of the board topology in use, which are read once.
+	const BoardLayout& getDefaultBoardLayout() {
+		static const BoardLayout defaultBoardLayout = [] {
+			const BoardTopology& boardTopology = getBoardTopology();
+			return BoardLayout{ boardTopology.resourcesOfHexes, boardTopology.numbersOfTokensOfHexes };
+		}();
+		return defaultBoardLayout;
+	}
+
+
+	// Function `getMasksOfAdjacentHexes` returns, for every hex, the set of hexes that share an edge with it, where hex i is bit i.
+	const std::array<uint32_t, NUMBER_OF_HEXES>& getMasksOfAdjacentHexes() {
+		static const std::array<uint32_t, NUMBER_OF_HEXES> masksOfAdjacentHexes = [] {
+			const BoardTopology& boardTopology = getBoardTopology();
+			std::array<uint32_t, NUMBER_OF_HEXES> masks{};
+			for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+				for (int indexOfOtherHex = 0; indexOfOtherHex < NUMBER_OF_HEXES; indexOfOtherHex++) {
+					if (indexOfOtherHex == indexOfHex) {
+						continue;
+					}
+					int numberOfSharedVertices = 0;
+					for (int indexOfVertex : boardTopology.indicesOfVerticesOfHexes[indexOfHex]) {
+						const std::array<int, 6>& indicesOfVerticesOfOtherHex = boardTopology.indicesOfVerticesOfHexes[indexOfOtherHex];
+						numberOfSharedVertices += static_cast<int>(std::count(indicesOfVerticesOfOtherHex.begin(), indicesOfVerticesOfOtherHex.end(), indexOfVertex));
+					}
+					if (numberOfSharedVertices >= 2) {
+						masks[indexOfHex] |= uint32_t{ 1 } << indexOfOtherHex;
+					}
+				}
+			}
+			return masks;
+		}();
+		return masksOfAdjacentHexes;
+	}
+
+
+	// Function `hasAdjacentRedTokens` returns whether two adjacent hexes both have a 6 or an 8, which the standard rules forbid.
+	bool hasAdjacentRedTokens(const BoardLayout& boardLayout) {
+		const std::array<uint32_t, NUMBER_OF_HEXES>& masksOfAdjacentHexes = getMasksOfAdjacentHexes();
+		uint32_t maskOfRedHexes = 0;
+		for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+			const int numberOfToken = boardLayout.numbersOfTokensOfHexes[indexOfHex];
+			if (numberOfToken == 6 || numberOfToken == 8) {
+				maskOfRedHexes |= uint32_t{ 1 } << indexOfHex;
+			}
+		}
+		for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+			if (((maskOfRedHexes >> indexOfHex) & 1) != 0 && (masksOfAdjacentHexes[indexOfHex] & maskOfRedHexes) != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	/* Function `createRandomBoardLayout` shuffles the resources and the tokens of the default layout over the hexes of the board.
+	* Hexes that produce nothing get no token (0), and no two adjacent hexes both get a 6 or an 8.
+	* Shuffles that break that rule are drawn again, so every layout that keeps it is equally likely.
+	*/
+	template <typename UniformRandomBitGenerator>
+	BoardLayout createRandomBoardLayout(UniformRandomBitGenerator& generator) {
+		const BoardLayout& defaultBoardLayout = getDefaultBoardLayout();
+		std::vector<int> vectorOfNumbersOfTokens;
+		for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+			if (defaultBoardLayout.resourcesOfHexes[indexOfHex] != Resource::Nothing) {
+				vectorOfNumbersOfTokens.push_back(defaultBoardLayout.numbersOfTokensOfHexes[indexOfHex]);
+			}
+		}
+		BoardLayout boardLayout = defaultBoardLayout;
+		for (int attempt = 0; attempt < MAXIMUM_NUMBER_OF_ATTEMPTS_TO_CREATE_BOARD_LAYOUT; attempt++) {
+			std::shuffle(boardLayout.resourcesOfHexes.begin(), boardLayout.resourcesOfHexes.end(), generator);
+			std::shuffle(vectorOfNumbersOfTokens.begin(), vectorOfNumbersOfTokens.end(), generator);
+			size_t indexOfNextToken = 0;
+			for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+				boardLayout.numbersOfTokensOfHexes[indexOfHex] =
+					(boardLayout.resourcesOfHexes[indexOfHex] == Resource::Nothing) ? 0 : vectorOfNumbersOfTokens[indexOfNextToken++];
+			}
+			if (!hasAdjacentRedTokens(boardLayout)) {
+				return boardLayout;
+			}
+		}
+		throw std::runtime_error("No layout of the board without adjacent 6 and 8 tokens was found.");
+	}
+
+
+	// Function `getIndexOfCellOfGrid` returns the index of the cell of the 21 x 21 grid, in row major order, at a pair of isometric coordinates.
+	int getIndexOfCellOfGrid(const std::array<int, 2>& pairOfCoordinates) {
+		return pairOfCoordinates[1] * DIMENSION_OF_GRID + pairOfCoordinates[0];
+	}
+
+
+	/* Structure `PrecomputedBoardLayout` holds tables derived from a layout once, so that game states and boards that share the layout
+	* look them up instead of scanning hexes.
+	* `numbersOfResourcesProducedAtVertices[sum][vertex]` counts the brick, grain, lumber, ore, and wool that a settlement at the vertex collects
+	* when the dice sum to `sum`, and bit i of `masksOfProducingVertices[sum]` is set if vertex i collects anything for that sum.
+	* `cellsOfGrid` are the codes of the grid representation of the board without a move, as described by `Board::writeGridRepresentationForMove`.
+	*/
+	struct PrecomputedBoardLayout {
+		BoardLayout boardLayout;
+		uint64_t hash{ 0 };
+		std::array<std::array<std::array<uint8_t, NUMBER_OF_PRODUCED_RESOURCES>, NUMBER_OF_VERTICES>, MAXIMUM_SUM_OF_DICE + 1> numbersOfResourcesProducedAtVertices{};
+		std::array<uint64_t, MAXIMUM_SUM_OF_DICE + 1> masksOfProducingVertices{};
+		std::array<uint8_t, NUMBER_OF_CELLS_OF_GRID> cellsOfGrid{};
+	};
+
+
+	PrecomputedBoardLayout createPrecomputedBoardLayout(const BoardLayout& boardLayout) {
+		const BoardTopology& boardTopology = getBoardTopology();
+		PrecomputedBoardLayout precomputedBoardLayout;
+		precomputedBoardLayout.boardLayout = boardLayout;
+		precomputedBoardLayout.hash = boardLayout.getHash();
+
+		for (int indexOfHex = 0; indexOfHex < NUMBER_OF_HEXES; indexOfHex++) {
+			const Resource resource = boardLayout.resourcesOfHexes[indexOfHex];
+			const int numberOfToken = boardLayout.numbersOfTokensOfHexes[indexOfHex];
+			// Codes 1 to 6 of nothing, brick, grain, lumber, ore, and wool follow the order of `Game::Resource`.
+			precomputedBoardLayout.cellsOfGrid[getIndexOfCellOfGrid(boardTopology.coordinatesOfCentersOfHexes[indexOfHex])] = static_cast<uint8_t>(1 + static_cast<int>(resource));
+			if (resource == Resource::Nothing || numberOfToken < 2 || numberOfToken > MAXIMUM_SUM_OF_DICE) {
+				continue;
+			}
+			for (int indexOfVertex : boardTopology.indicesOfVerticesOfHexes[indexOfHex]) {
+				precomputedBoardLayout.numbersOfResourcesProducedAtVertices[numberOfToken][indexOfVertex][static_cast<int>(resource) - 1]++;
+				precomputedBoardLayout.masksOfProducingVertices[numberOfToken] |= uint64_t{ 1 } << indexOfVertex;
+			}
+		}
+		for (int indexOfVertex = 0; indexOfVertex < NUMBER_OF_VERTICES; indexOfVertex++) {
+			precomputedBoardLayout.cellsOfGrid[getIndexOfCellOfGrid(boardTopology.coordinatesOfVertices[indexOfVertex])] = 7;
+		}
+		for (int indexOfEdge = 0; indexOfEdge < NUMBER_OF_EDGES; indexOfEdge++) {
+			precomputedBoardLayout.cellsOfGrid[getIndexOfCellOfGrid(boardTopology.coordinatesOfCentersOfEdges[indexOfEdge])] = 8;
+		}
+		return precomputedBoardLayout;
+	}
+
+
+	namespace Detail {
+		inline std::mutex mutexOfCacheOfBoardLayouts;
+		inline std::unordered_map<uint64_t, std::shared_ptr<const PrecomputedBoardLayout>> unorderedMapOfHashesToPrecomputedBoardLayouts;
+	}
+
+
+	/* Function `getPrecomputedBoardLayout` returns the tables of a layout from a cache keyed by the hash of the layout, building them on a miss.
+	* Game states and boards hold the tables by shared pointer, so clearing the cache when it is full never invalidates tables in use.
+	* A layout whose hash collides with a cached layout gets tables that are not cached.
+	*/
+	std::shared_ptr<const PrecomputedBoardLayout> getPrecomputedBoardLayout(const BoardLayout& boardLayout) {
+		const uint64_t hash = boardLayout.getHash();
+		{
+			std::lock_guard<std::mutex> lock(Detail::mutexOfCacheOfBoardLayouts);
+			auto iterator = Detail::unorderedMapOfHashesToPrecomputedBoardLayouts.find(hash);
+			if (iterator != Detail::unorderedMapOfHashesToPrecomputedBoardLayouts.end()) {
+				if (iterator->second->boardLayout == boardLayout) {
+					return iterator->second;
+				}
+				return std::make_shared<const PrecomputedBoardLayout>(createPrecomputedBoardLayout(boardLayout));
+			}
+		}
+		std::shared_ptr<const PrecomputedBoardLayout> precomputedBoardLayout = std::make_shared<const PrecomputedBoardLayout>(createPrecomputedBoardLayout(boardLayout));
+		std::lock_guard<std::mutex> lock(Detail::mutexOfCacheOfBoardLayouts);
+		if (Detail::unorderedMapOfHashesToPrecomputedBoardLayouts.size() >= MAXIMUM_NUMBER_OF_CACHED_BOARD_LAYOUTS) {
+			Detail::unorderedMapOfHashesToPrecomputedBoardLayouts.clear();
+		}
+		auto [iterator, wasInserted] = Detail::unorderedMapOfHashesToPrecomputedBoardLayouts.try_emplace(hash, precomputedBoardLayout);
+		return (iterator->second->boardLayout == boardLayout) ? iterator->second : precomputedBoardLayout;
+	}
+
+
+	// Function `getDefaultPrecomputedBoardLayout` returns the tables of the default layout, which every new game state and board uses.
+	const std::shared_ptr<const PrecomputedBoardLayout>& getDefaultPrecomputedBoardLayout() {
+		static const std::shared_ptr<const PrecomputedBoardLayout> defaultPrecomputedBoardLayout = getPrecomputedBoardLayout(getDefaultBoardLayout());
+		return defaultPrecomputedBoardLayout;
+	}
+
+}
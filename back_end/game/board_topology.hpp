@@ -0,0 +1,164 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include "board_topology_generated.hpp"
+#include "crow/json.h"
+#include <fstream>
+#include "labels.hpp"
+#include <memory>
+#include "resource_bag.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+namespace Game {
+
+	static_assert(Generated::NUMBER_OF_HEXES == NUMBER_OF_HEXES, "The generated board has a different number of hexes.");
+	static_assert(Generated::NUMBER_OF_VERTICES == NUMBER_OF_VERTICES, "The generated board has a different number of vertices.");
+	static_assert(Generated::NUMBER_OF_EDGES == NUMBER_OF_EDGES, "The generated board has a different number of edges.");
+
+	constexpr int MAXIMUM_NUMBER_OF_NEIGHBORS = 3;
+
+	/* Structure `BoardTopology` describes a board by zero based indices of hexes, vertices, and edges:
+	* the isometric coordinates of hexes, vertices, and edges, the vertices, resource, and number of token of every hex,
+	* the adjacent vertices and extending edges of every vertex, and the vertices of every edge.
+	* Lists of adjacent vertices and of edges of vertices with fewer than 3 entries are padded with -1.
+	*/
+	struct BoardTopology {
+		std::array<std::array<int, 2>, NUMBER_OF_HEXES> coordinatesOfCentersOfHexes;
+		std::array<std::array<int, 6>, NUMBER_OF_HEXES> indicesOfVerticesOfHexes;
+		std::array<Resource, NUMBER_OF_HEXES> resourcesOfHexes;
+		std::array<int, NUMBER_OF_HEXES> numbersOfTokensOfHexes;
+		std::array<std::array<int, 2>, NUMBER_OF_VERTICES> coordinatesOfVertices;
+		std::array<std::array<int, MAXIMUM_NUMBER_OF_NEIGHBORS>, NUMBER_OF_VERTICES> indicesOfAdjacentVertices;
+		std::array<std::array<int, MAXIMUM_NUMBER_OF_NEIGHBORS>, NUMBER_OF_VERTICES> indicesOfEdgesOfVertices;
+		std::array<std::array<int, 2>, NUMBER_OF_EDGES> coordinatesOfCentersOfEdges;
+		std::array<std::array<int, 2>, NUMBER_OF_EDGES> indicesOfVerticesOfEdges;
+	};
+
+	// Variable `DEFAULT_BOARD_TOPOLOGY` is the board compiled in from `board_topology_generated.hpp`.
+	inline constexpr BoardTopology DEFAULT_BOARD_TOPOLOGY{
+		Generated::COORDINATES_OF_CENTERS_OF_HEXES,
+		Generated::INDICES_OF_VERTICES_OF_HEXES,
+		Generated::RESOURCES_OF_HEXES,
+		Generated::NUMBERS_OF_TOKENS_OF_HEXES,
+		Generated::COORDINATES_OF_VERTICES,
+		Generated::INDICES_OF_ADJACENT_VERTICES,
+		Generated::INDICES_OF_EDGES_OF_VERTICES,
+		Generated::COORDINATES_OF_CENTERS_OF_EDGES,
+		Generated::INDICES_OF_VERTICES_OF_EDGES
+	};
+
+	// Function `resourceFromString` converts "nothing", "brick", "grain", "lumber", "ore", or "wool" into a resource.
+	Resource resourceFromString(const std::string& nameOfResource) {
+		if (nameOfResource == "nothing") {
+			return Resource::Nothing;
+		}
+		if (nameOfResource == "brick") {
+			return Resource::Brick;
+		}
+		if (nameOfResource == "grain") {
+			return Resource::Grain;
+		}
+		if (nameOfResource == "lumber") {
+			return Resource::Lumber;
+		}
+		if (nameOfResource == "ore") {
+			return Resource::Ore;
+		}
+		if (nameOfResource == "wool") {
+			return Resource::Wool;
+		}
+		throw std::runtime_error(nameOfResource + " is an unknown resource type.");
+	}
+
+	/* Function `loadBoardTopology` reads a board from a file of isometric coordinates in the format of
+	* `generate_board_geometry/isometric_coordinates.json`, for boards other than the one compiled in.
+	* The board must have 19 hexes, 54 vertices, and 72 edges labelled from 1.
+	*/
+	BoardTopology loadBoardTopology(const std::string& pathToIsometricCoordinates) {
+		std::ifstream file(pathToIsometricCoordinates);
+		if (!file.is_open()) {
+			throw std::runtime_error("Isometric coordinates file " + pathToIsometricCoordinates + " could not be opened.");
+		}
+		std::stringstream buffer;
+		buffer << file.rdbuf();
+		const crow::json::rvalue isometricCoordinates = crow::json::load(buffer.str());
+		if (!isometricCoordinates) {
+			throw std::runtime_error("Isometric coordinates file " + pathToIsometricCoordinates + " could not be parsed.");
+		}
+
+		auto readPairOfIntegers = [](const crow::json::rvalue& jsonArray) {
+			return std::array<int, 2>{ static_cast<int>(jsonArray[0].d()), static_cast<int>(jsonArray[1].d()) };
+		};
+		auto readIndices = [](const crow::json::rvalue& jsonArrayOfLabels, int numberOfLabels, int* indices, size_t numberOfIndices) {
+			size_t i = 0;
+			for (const crow::json::rvalue& label : jsonArrayOfLabels) {
+				if (i == numberOfIndices) {
+					throw std::runtime_error("A list of labels of the isometric coordinates file has more than " + std::to_string(numberOfIndices) + " labels.");
+				}
+				indices[i++] = getIndexOfLabel(label.s(), numberOfLabels);
+			}
+			for (; i < numberOfIndices; i++) {
+				indices[i] = -1;
+			}
+		};
+
+		BoardTopology boardTopology{};
+		for (const crow::json::rvalue& pairOfCoordinates : isometricCoordinates["objectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes"]) {
+			boardTopology.coordinatesOfCentersOfHexes[getIndexOfLabel(pairOfCoordinates.key(), NUMBER_OF_HEXES)] = readPairOfIntegers(pairOfCoordinates);
+		}
+		for (const crow::json::rvalue& arrayOfLabelsOfVertices : isometricCoordinates["objectOfIdsOfHexesAndArraysOfIdsOfVertices"]) {
+			std::array<int, 6>& indicesOfVertices = boardTopology.indicesOfVerticesOfHexes[getIndexOfLabel(arrayOfLabelsOfVertices.key(), NUMBER_OF_HEXES)];
+			readIndices(arrayOfLabelsOfVertices, NUMBER_OF_VERTICES, indicesOfVertices.data(), indicesOfVertices.size());
+		}
+		for (const crow::json::rvalue& nameOfResource : isometricCoordinates["objectOfIdsOfHexesAndNamesOfResources"]) {
+			boardTopology.resourcesOfHexes[getIndexOfLabel(nameOfResource.key(), NUMBER_OF_HEXES)] = resourceFromString(nameOfResource.s());
+		}
+		for (const crow::json::rvalue& numberOfToken : isometricCoordinates["objectOfIdsOfHexesAndNumbersOfTokens"]) {
+			boardTopology.numbersOfTokensOfHexes[getIndexOfLabel(numberOfToken.key(), NUMBER_OF_HEXES)] = static_cast<int>(numberOfToken.d());
+		}
+		for (const crow::json::rvalue& pairOfCoordinates : isometricCoordinates["objectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices"]) {
+			boardTopology.coordinatesOfVertices[getIndexOfLabel(pairOfCoordinates.key(), NUMBER_OF_VERTICES)] = readPairOfIntegers(pairOfCoordinates);
+		}
+		for (const crow::json::rvalue& arrayOfLabelsOfVertices : isometricCoordinates["objectOfIdsOfVerticesAndListsOfIdsOfAdjacentVertices"]) {
+			std::array<int, MAXIMUM_NUMBER_OF_NEIGHBORS>& indicesOfVertices = boardTopology.indicesOfAdjacentVertices[getIndexOfLabel(arrayOfLabelsOfVertices.key(), NUMBER_OF_VERTICES)];
+			readIndices(arrayOfLabelsOfVertices, NUMBER_OF_VERTICES, indicesOfVertices.data(), indicesOfVertices.size());
+		}
+		for (const crow::json::rvalue& arrayOfLabelsOfEdges : isometricCoordinates["objectOfIdsOfVerticesAndListsOfEdgesExtendingFromThoseVertices"]) {
+			std::array<int, MAXIMUM_NUMBER_OF_NEIGHBORS>& indicesOfEdges = boardTopology.indicesOfEdgesOfVertices[getIndexOfLabel(arrayOfLabelsOfEdges.key(), NUMBER_OF_VERTICES)];
+			readIndices(arrayOfLabelsOfEdges, NUMBER_OF_EDGES, indicesOfEdges.data(), indicesOfEdges.size());
+		}
+		for (const crow::json::rvalue& pairOfCoordinates : isometricCoordinates["objectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges"]) {
+			boardTopology.coordinatesOfCentersOfEdges[getIndexOfLabel(pairOfCoordinates.key(), NUMBER_OF_EDGES)] = readPairOfIntegers(pairOfCoordinates);
+		}
+		for (const crow::json::rvalue& pairOfLabelsOfVertices : isometricCoordinates["objectOfIdsOfEdgesAndPairsOfIdsOfVertices"]) {
+			std::array<int, 2>& indicesOfVertices = boardTopology.indicesOfVerticesOfEdges[getIndexOfLabel(pairOfLabelsOfVertices.key(), NUMBER_OF_EDGES)];
+			readIndices(pairOfLabelsOfVertices, NUMBER_OF_VERTICES, indicesOfVertices.data(), indicesOfVertices.size());
+		}
+		return boardTopology;
+	}
+
+	namespace Detail {
+		inline std::unique_ptr<const BoardTopology> customBoardTopology;
+		inline std::atomic<const BoardTopology*> pointerToBoardTopology{ &DEFAULT_BOARD_TOPOLOGY };
+	}
+
+	// Function `getBoardTopology` returns the board in use, which is the board compiled in unless `setBoardTopology` replaced it.
+	const BoardTopology& getBoardTopology() {
+		return *Detail::pointerToBoardTopology.load(std::memory_order_acquire);
+	}
+
+	/* Function `setBoardTopology` replaces the board in use with a custom board.
+	* Boards and move generators cache tables derived from the board the first time they are used,
+	* so a program calls `setBoardTopology` once at startup, before it creates any board or game state.
+	*/
+	void setBoardTopology(const BoardTopology& boardTopology) {
+		Detail::customBoardTopology = std::make_unique<const BoardTopology>(boardTopology);
+		Detail::pointerToBoardTopology.store(Detail::customBoardTopology.get(), std::memory_order_release);
+	}
+
+}
@@ -0,0 +1,388 @@
+// File `board_topology_generated.hpp` is generated by `generate_board_geometry/generate_board_geometry.py`
+// from `generate_board_geometry/isometric_coordinates.json`. Do not edit it; run the script instead.
+#pragma once
+
+
+#include <array>
+#include "resource_bag.hpp"
+
+
+namespace Game {
+	namespace Generated {
+
+		// Indices are zero based. Lists of adjacent vertices and of edges of vertices with fewer than 3 entries are padded with -1.
+		constexpr int NUMBER_OF_HEXES = 19;
+		constexpr int NUMBER_OF_VERTICES = 54;
+		constexpr int NUMBER_OF_EDGES = 72;
+
+		constexpr std::array<std::array<int, 2>, NUMBER_OF_HEXES> COORDINATES_OF_CENTERS_OF_HEXES = { {
+			{ 2, 6 },
+			{ 4, 4 },
+			{ 6, 2 },
+			{ 4, 10 },
+			{ 8, 6 },
+			{ 6, 8 },
+			{ 10, 4 },
+			{ 6, 14 },
+			{ 8, 12 },
+			{ 10, 10 },
+			{ 12, 8 },
+			{ 14, 6 },
+			{ 10, 16 },
+			{ 12, 14 },
+			{ 14, 12 },
+			{ 16, 10 },
+			{ 14, 18 },
+			{ 16, 16 },
+			{ 18, 14 }
+		} };
+
+		constexpr std::array<std::array<int, 6>, NUMBER_OF_HEXES> INDICES_OF_VERTICES_OF_HEXES = { {
+			{ 0, 1, 2, 3, 4, 5 },
+			{ 1, 2, 6, 7, 8, 9 },
+			{ 7, 8, 10, 11, 12, 13 },
+			{ 3, 4, 14, 15, 16, 17 },
+			{ 2, 3, 9, 14, 18, 19 },
+			{ 8, 9, 13, 18, 20, 21 },
+			{ 12, 13, 20, 22, 23, 24 },
+			{ 15, 16, 25, 26, 27, 28 },
+			{ 14, 15, 19, 25, 29, 30 },
+			{ 18, 19, 21, 29, 31, 32 },
+			{ 20, 21, 24, 31, 33, 34 },
+			{ 23, 24, 33, 35, 36, 37 },
+			{ 25, 26, 30, 38, 39, 40 },
+			{ 29, 30, 32, 38, 41, 42 },
+			{ 31, 32, 34, 41, 43, 44 },
+			{ 33, 34, 37, 43, 45, 46 },
+			{ 38, 39, 42, 47, 48, 49 },
+			{ 41, 42, 44, 47, 50, 51 },
+			{ 43, 44, 46, 50, 52, 53 }
+		} };
+
+		constexpr std::array<Resource, NUMBER_OF_HEXES> RESOURCES_OF_HEXES = { Resource::Ore, Resource::Wool, Resource::Lumber, Resource::Grain, Resource::Brick, Resource::Wool, Resource::Brick, Resource::Grain, Resource::Lumber, Resource::Nothing, Resource::Lumber, Resource::Ore, Resource::Lumber, Resource::Ore, Resource::Grain, Resource::Wool, Resource::Brick, Resource::Grain, Resource::Wool };
+
+		constexpr std::array<int, NUMBER_OF_HEXES> NUMBERS_OF_TOKENS_OF_HEXES = { 10, 2, 9, 12, 6, 4, 10, 9, 11, 1, 3, 8, 8, 3, 4, 5, 5, 6, 11 };
+
+		constexpr std::array<std::array<int, 2>, NUMBER_OF_VERTICES> COORDINATES_OF_VERTICES = { {
+			{ 0, 4 },
+			{ 2, 4 },
+			{ 4, 6 },
+			{ 4, 8 },
+			{ 2, 8 },
+			{ 0, 6 },
+			{ 2, 2 },
+			{ 4, 2 },
+			{ 6, 4 },
+			{ 6, 6 },
+			{ 4, 0 },
+			{ 6, 0 },
+			{ 8, 2 },
+			{ 8, 4 },
+			{ 6, 10 },
+			{ 6, 12 },
+			{ 4, 12 },
+			{ 2, 10 },
+			{ 8, 8 },
+			{ 8, 10 },
+			{ 10, 6 },
+			{ 10, 8 },
+			{ 10, 2 },
+			{ 12, 4 },
+			{ 12, 6 },
+			{ 8, 14 },
+			{ 8, 16 },
+			{ 6, 16 },
+			{ 4, 14 },
+			{ 10, 12 },
+			{ 10, 14 },
+			{ 12, 10 },
+			{ 12, 12 },
+			{ 14, 8 },
+			{ 14, 10 },
+			{ 14, 4 },
+			{ 16, 6 },
+			{ 16, 8 },
+			{ 12, 16 },
+			{ 12, 18 },
+			{ 10, 18 },
+			{ 14, 14 },
+			{ 14, 16 },
+			{ 16, 12 },
+			{ 16, 14 },
+			{ 18, 10 },
+			{ 18, 12 },
+			{ 16, 18 },
+			{ 16, 20 },
+			{ 14, 20 },
+			{ 18, 16 },
+			{ 18, 18 },
+			{ 20, 14 },
+			{ 20, 16 }
+		} };
+
+		constexpr std::array<std::array<int, 3>, NUMBER_OF_VERTICES> INDICES_OF_ADJACENT_VERTICES = { {
+			{ 1, 5, -1 },
+			{ 0, 2, 6 },
+			{ 1, 3, 9 },
+			{ 2, 4, 14 },
+			{ 3, 5, 17 },
+			{ 0, 4, -1 },
+			{ 1, 7, -1 },
+			{ 6, 8, 10 },
+			{ 7, 9, 13 },
+			{ 2, 8, 18 },
+			{ 7, 11, -1 },
+			{ 10, 12, -1 },
+			{ 11, 13, 22 },
+			{ 8, 12, 20 },
+			{ 3, 15, 19 },
+			{ 14, 16, 25 },
+			{ 15, 17, 28 },
+			{ 4, 16, -1 },
+			{ 9, 19, 21 },
+			{ 14, 18, 29 },
+			{ 13, 21, 24 },
+			{ 18, 20, 31 },
+			{ 12, 23, -1 },
+			{ 22, 24, 35 },
+			{ 20, 23, 33 },
+			{ 15, 26, 30 },
+			{ 25, 27, 40 },
+			{ 26, 28, -1 },
+			{ 16, 27, -1 },
+			{ 19, 30, 32 },
+			{ 25, 29, 38 },
+			{ 21, 32, 34 },
+			{ 29, 31, 41 },
+			{ 24, 34, 37 },
+			{ 31, 33, 43 },
+			{ 23, 36, -1 },
+			{ 35, 37, -1 },
+			{ 33, 36, 45 },
+			{ 30, 39, 42 },
+			{ 38, 40, 49 },
+			{ 26, 39, -1 },
+			{ 32, 42, 44 },
+			{ 38, 41, 47 },
+			{ 34, 44, 46 },
+			{ 41, 43, 50 },
+			{ 37, 46, -1 },
+			{ 43, 45, 52 },
+			{ 42, 48, 51 },
+			{ 47, 49, -1 },
+			{ 39, 48, -1 },
+			{ 44, 51, 53 },
+			{ 47, 50, -1 },
+			{ 46, 53, -1 },
+			{ 50, 52, -1 }
+		} };
+
+		constexpr std::array<std::array<int, 3>, NUMBER_OF_VERTICES> INDICES_OF_EDGES_OF_VERTICES = { {
+			{ 0, 5, -1 },
+			{ 0, 1, 10 },
+			{ 1, 2, 9 },
+			{ 2, 3, 16 },
+			{ 3, 4, 20 },
+			{ 4, 5, -1 },
+			{ 6, 10, -1 },
+			{ 6, 7, 15 },
+			{ 7, 8, 14 },
+			{ 8, 9, 21 },
+			{ 11, 15, -1 },
+			{ 11, 12, -1 },
+			{ 12, 13, 27 },
+			{ 13, 14, 24 },
+			{ 16, 17, 23 },
+			{ 17, 18, 31 },
+			{ 18, 19, 35 },
+			{ 19, 20, -1 },
+			{ 21, 22, 26 },
+			{ 22, 23, 36 },
+			{ 24, 25, 30 },
+			{ 25, 26, 39 },
+			{ 27, 28, -1 },
+			{ 28, 29, 45 },
+			{ 29, 30, 42 },
+			{ 31, 32, 38 },
+			{ 32, 33, 52 },
+			{ 33, 34, -1 },
+			{ 34, 35, -1 },
+			{ 36, 37, 41 },
+			{ 37, 38, 49 },
+			{ 39, 40, 44 },
+			{ 40, 41, 53 },
+			{ 42, 43, 48 },
+			{ 43, 44, 56 },
+			{ 45, 46, -1 },
+			{ 46, 47, -1 },
+			{ 47, 48, 59 },
+			{ 49, 50, 55 },
+			{ 50, 51, 65 },
+			{ 51, 52, -1 },
+			{ 53, 54, 58 },
+			{ 54, 55, 62 },
+			{ 56, 57, 61 },
+			{ 57, 58, 66 },
+			{ 59, 60, -1 },
+			{ 60, 61, 69 },
+			{ 62, 63, 68 },
+			{ 63, 64, -1 },
+			{ 64, 65, -1 },
+			{ 66, 67, 71 },
+			{ 67, 68, -1 },
+			{ 69, 70, -1 },
+			{ 70, 71, -1 }
+		} };
+
+		constexpr std::array<std::array<int, 2>, NUMBER_OF_EDGES> COORDINATES_OF_CENTERS_OF_EDGES = { {
+			{ 1, 4 },
+			{ 3, 5 },
+			{ 4, 7 },
+			{ 3, 8 },
+			{ 1, 7 },
+			{ 0, 5 },
+			{ 3, 2 },
+			{ 5, 3 },
+			{ 6, 5 },
+			{ 5, 6 },
+			{ 2, 3 },
+			{ 5, 0 },
+			{ 7, 1 },
+			{ 8, 3 },
+			{ 7, 4 },
+			{ 4, 1 },
+			{ 5, 9 },
+			{ 6, 11 },
+			{ 5, 12 },
+			{ 3, 11 },
+			{ 2, 9 },
+			{ 7, 7 },
+			{ 8, 9 },
+			{ 7, 10 },
+			{ 9, 5 },
+			{ 10, 7 },
+			{ 9, 8 },
+			{ 9, 2 },
+			{ 11, 3 },
+			{ 12, 5 },
+			{ 11, 6 },
+			{ 7, 13 },
+			{ 8, 15 },
+			{ 7, 16 },
+			{ 5, 15 },
+			{ 4, 13 },
+			{ 9, 11 },
+			{ 10, 13 },
+			{ 9, 14 },
+			{ 11, 9 },
+			{ 12, 11 },
+			{ 11, 12 },
+			{ 13, 7 },
+			{ 14, 9 },
+			{ 13, 10 },
+			{ 13, 4 },
+			{ 15, 5 },
+			{ 16, 7 },
+			{ 15, 8 },
+			{ 11, 15 },
+			{ 12, 17 },
+			{ 11, 18 },
+			{ 9, 17 },
+			{ 13, 13 },
+			{ 14, 15 },
+			{ 13, 16 },
+			{ 15, 11 },
+			{ 16, 13 },
+			{ 15, 14 },
+			{ 17, 9 },
+			{ 18, 11 },
+			{ 17, 12 },
+			{ 15, 17 },
+			{ 16, 19 },
+			{ 15, 20 },
+			{ 13, 19 },
+			{ 17, 15 },
+			{ 18, 17 },
+			{ 17, 18 },
+			{ 19, 13 },
+			{ 20, 15 },
+			{ 19, 16 }
+		} };
+
+		constexpr std::array<std::array<int, 2>, NUMBER_OF_EDGES> INDICES_OF_VERTICES_OF_EDGES = { {
+			{ 0, 1 },
+			{ 1, 2 },
+			{ 2, 3 },
+			{ 3, 4 },
+			{ 4, 5 },
+			{ 5, 0 },
+			{ 6, 7 },
+			{ 7, 8 },
+			{ 8, 9 },
+			{ 9, 2 },
+			{ 1, 6 },
+			{ 10, 11 },
+			{ 11, 12 },
+			{ 12, 13 },
+			{ 13, 8 },
+			{ 7, 10 },
+			{ 3, 14 },
+			{ 14, 15 },
+			{ 15, 16 },
+			{ 16, 17 },
+			{ 17, 4 },
+			{ 9, 18 },
+			{ 18, 19 },
+			{ 19, 14 },
+			{ 13, 20 },
+			{ 20, 21 },
+			{ 18, 21 },
+			{ 12, 22 },
+			{ 22, 23 },
+			{ 23, 24 },
+			{ 20, 24 },
+			{ 15, 25 },
+			{ 25, 26 },
+			{ 26, 27 },
+			{ 27, 28 },
+			{ 16, 28 },
+			{ 19, 29 },
+			{ 29, 30 },
+			{ 25, 30 },
+			{ 21, 31 },
+			{ 31, 32 },
+			{ 29, 32 },
+			{ 24, 33 },
+			{ 33, 34 },
+			{ 31, 34 },
+			{ 23, 35 },
+			{ 35, 36 },
+			{ 36, 37 },
+			{ 33, 37 },
+			{ 30, 38 },
+			{ 38, 39 },
+			{ 39, 40 },
+			{ 40, 26 },
+			{ 32, 41 },
+			{ 41, 42 },
+			{ 38, 42 },
+			{ 34, 43 },
+			{ 43, 44 },
+			{ 41, 44 },
+			{ 37, 45 },
+			{ 45, 46 },
+			{ 43, 46 },
+			{ 42, 47 },
+			{ 47, 48 },
+			{ 48, 49 },
+			{ 39, 49 },
+			{ 44, 50 },
+			{ 50, 51 },
+			{ 47, 51 },
+			{ 46, 52 },
+			{ 52, 53 },
+			{ 50, 53 }
+		} };
+
+	}
+}
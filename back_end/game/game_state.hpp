@@ -1,22 +1,76 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include "board_layout.hpp"
+#include <cstdint>
+#include "../json_writer.hpp"
+#include "labels.hpp"
+#include "list_of_locations.hpp"
+#include <memory>
+#include "move_generator.hpp"
 #include "phase.hpp"
+#include <random>
+#include "../random.hpp"
+#include "resource_bag.hpp"
+#include "road_graph.hpp"
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 
-struct ResourceBag {
-    int brick{ 0 };
-    int grain{ 0 };
-    int lumber{ 0 };
-    int ore{ 0 };
-    int wool{ 0 };
-    int cloth{ 0 };
-    int coin{ 0 };
-    int paper{ 0 };
-};
+// Function `writeResourceBag` writes a JSON object with keys "brick", "grain", "lumber", "ore", "wool", "cloth", "coin", and "paper".
+void writeResourceBag(Json::JsonWriter& writer, const ResourceBag& bag) {
+    writer.beginObject();
+    writer.key("brick").value(bag.brick);
+    writer.key("grain").value(bag.grain);
+    writer.key("lumber").value(bag.lumber);
+    writer.key("ore").value(bag.ore);
+    writer.key("wool").value(bag.wool);
+    writer.key("cloth").value(bag.cloth);
+    writer.key("coin").value(bag.coin);
+    writer.key("paper").value(bag.paper);
+    writer.endObject();
+}
+
+
+// Function `writeResourceBagsOfPlayers` writes a JSON object with keys "Player 1", "Player 2", and "Player 3" and resource bags as values.
+void writeResourceBagsOfPlayers(Json::JsonWriter& writer, const std::array<ResourceBag, 4>& resources) {
+    writer.beginObject();
+    for (int player = 1; player <= 3; ++player) {
+        writer.key("Player " + std::to_string(player));
+        writeResourceBag(writer, resources[player]);
+    }
+    writer.endObject();
+}
+
+
+/* Function `writeDifferencesOfResourceBagsOfPlayers` writes a JSON object with keys "Player 1", "Player 2", and "Player 3"
+* and resource bags of the numbers of resources gained between `resourcesBefore` and `resourcesAfter` as values.
+*/
+void writeDifferencesOfResourceBagsOfPlayers(
+    Json::JsonWriter& writer,
+    const std::array<ResourceBag, 4>& resourcesBefore,
+    const std::array<ResourceBag, 4>& resourcesAfter
+) {
+    writer.beginObject();
+    for (int player = 1; player <= 3; ++player) {
+        const ResourceBag& oldBag = resourcesBefore[player];
+        const ResourceBag& newBag = resourcesAfter[player];
+        writer.key("Player " + std::to_string(player));
+        writeResourceBag(writer, ResourceBag{
+            newBag.brick - oldBag.brick,
+            newBag.grain - oldBag.grain,
+            newBag.lumber - oldBag.lumber,
+            newBag.ore - oldBag.ore,
+            newBag.wool - oldBag.wool,
+            newBag.cloth - oldBag.cloth,
+            newBag.coin - oldBag.coin,
+            newBag.paper - oldBag.paper
+        });
+    }
+    writer.endObject();
+}
 
 
 class GameState {
@@ -27,16 +81,21 @@ public:
 
     int currentPlayer;
     Game::Phase phase;
-    std::unordered_map<int, std::vector<std::string>> settlements;
-    std::unordered_map<int, std::vector<std::string>> cities;
-    std::unordered_map<int, std::vector<std::string>> roads;
-    std::unordered_map<int, std::vector<std::string>> walls;
+    // Structures are zero based indices of vertices and edges in lists indexed by player, so copying a game state never allocates.
+    std::array<Game::ListOfVertices, 4> settlements;
+    std::array<Game::ListOfVertices, 4> cities;
+    std::array<Game::ListOfEdges, 4> roads;
+    std::array<Game::ListOfVertices, 4> walls;
     std::string lastBuilding;
     int redProductionDie;
     int yellowProductionDie;
     std::string whiteEventDie;
     std::array<ResourceBag, 4> resources;
     int winner;
+    Game::MoveGenerator moveGenerator;
+    Game::RoadGraph roadGraph;
+    // Member `precomputedBoardLayout` is shared by every copy of a game state, such as the game states of the nodes of a search.
+    std::shared_ptr<const Game::PrecomputedBoardLayout> precomputedBoardLayout;
     
 
     GameState() :
@@ -46,53 +105,60 @@ public:
         redProductionDie(0),
         yellowProductionDie(0),
         whiteEventDie(""),
-        winner(0)
+        winner(0),
+        precomputedBoardLayout(Game::getDefaultPrecomputedBoardLayout())
     {
-        settlements = {
-            {1, {}},
-            {2, {}},
-            {3, {}}
-        };
-        cities = {
-            {1, {}},
-            {2, {}},
-            {3, {}}
-        };
-        roads = {
-            {1, {}},
-            {2, {}},
-            {3, {}}
-        };
-        walls = {
-            {1, {}},
-            {2, {}},
-            {3, {}}
-        };
+        // Do nothing.
     }
     
 
+    // Method `setBoardLayout` plays the game on a layout of resources and tokens other than the default, before any structure is placed.
+    void setBoardLayout(const Game::BoardLayout& boardLayout) {
+        precomputedBoardLayout = Game::getPrecomputedBoardLayout(boardLayout);
+    }
+
+
+    // Method `rollDice` rolls the dice with the generator of the calling thread, which a game of self play seeds with a stream of the game.
     void rollDice() {
-        std::random_device randomDevice;
-        std::mt19937 generator(randomDevice());
+        rollDice(Random::getGeneratorOfThread());
+    }
+
+
+    /* Method `rollDice` rolls the production and event dice with a given generator of random numbers and collects resources.
+    * Games that must be reproducible, such as games of the arena, pass a generator with a fixed seed.
+    */
+    template <typename UniformRandomBitGenerator>
+    void rollDice(UniformRandomBitGenerator& generator) {
         std::uniform_int_distribution<int> distribution(1, 6);
-        redProductionDie = distribution(generator);
-        yellowProductionDie = distribution(generator);
+        int redProductionDieToRoll = distribution(generator);
+        int yellowProductionDieToRoll = distribution(generator);
         int indexOfFaceOfWhiteEventDie = distribution(generator);
+        std::string whiteEventDieToRoll;
         switch (indexOfFaceOfWhiteEventDie) {
         case 1:
-            whiteEventDie = "yellow";
+            whiteEventDieToRoll = "yellow";
             break;
         case 2:
-            whiteEventDie = "green";
+            whiteEventDieToRoll = "green";
             break;
         case 3:
-            whiteEventDie = "blue";
+            whiteEventDieToRoll = "blue";
             break;
         default:
-            whiteEventDie = "black";
+            whiteEventDieToRoll = "black";
             break;
         }
+        applyRollOfDice(redProductionDieToRoll, yellowProductionDieToRoll, whiteEventDieToRoll);
+    }
+
 
+    /* Method `applyRollOfDice` sets the faces of the dice and collects resources for their sum.
+    * Chance nodes of MCTS apply each possible sum this way without rolling.
+    */
+    void applyRollOfDice(int redProductionDieToApply, int yellowProductionDieToApply, const std::string& whiteEventDieToApply) {
+        redProductionDie = redProductionDieToApply;
+        yellowProductionDie = yellowProductionDieToApply;
+        whiteEventDie = whiteEventDieToApply;
         collectResources();
     }
 
@@ -145,7 +211,10 @@ public:
             bag.lumber--;
             bag.wool--;
         }
-        settlements[player].push_back(vertex);
+        const int indexOfVertex = Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES);
+        settlements[player].add(indexOfVertex);
+        moveGenerator.placeSettlement(player, indexOfVertex);
+        roadGraph.placeBuilding(player, indexOfVertex);
         lastBuilding = vertex;
         if (checkForWinner()) {
             return;
@@ -158,21 +227,16 @@ public:
 
     void placeCity(int player, const std::string& vertex) {
 		bool isMainTurn = (phase == Game::Phase::Turn);
+        const int indexOfVertex = Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES);
         if (isMainTurn) {
             auto& bag = resources[player];
             bag.grain -= 2;
             bag.ore -= 3;
-            std::vector<std::string>& vectorOfLabelsOfSettlementsOfPlayer = settlements[player];
-			vectorOfLabelsOfSettlementsOfPlayer.erase(
-                std::remove(
-                    vectorOfLabelsOfSettlementsOfPlayer.begin(),
-                    vectorOfLabelsOfSettlementsOfPlayer.end(),
-                    vertex
-                ),
-                vectorOfLabelsOfSettlementsOfPlayer.end()
-            );
+            settlements[player].remove(indexOfVertex);
         }
-		cities[player].push_back(vertex);
+		cities[player].add(indexOfVertex);
+        moveGenerator.placeCity(player, indexOfVertex);
+        roadGraph.placeBuilding(player, indexOfVertex);
 
         lastBuilding = vertex;
         if (checkForWinner()) {
@@ -187,9 +251,11 @@ public:
         if (isMainTurn) {
             resources[player].brick -= 2;
         }
+        const int indexOfVertex = Game::getIndexOfLabel(vertex, Game::NUMBER_OF_VERTICES);
         auto& playerWalls = walls[player];
-		if (std::find(playerWalls.begin(), playerWalls.end(), vertex) == playerWalls.end()) {
-            playerWalls.push_back(vertex);
+		if (!playerWalls.contains(indexOfVertex)) {
+            playerWalls.add(indexOfVertex);
+            moveGenerator.placeWall(player, indexOfVertex);
             lastBuilding = vertex;
             return true;
 		}
@@ -204,7 +270,10 @@ public:
             bag.brick--;
             bag.lumber--;
         }
-        roads[player].push_back(labelOfEdge);
+        const int indexOfEdge = Game::getIndexOfLabel(labelOfEdge, Game::NUMBER_OF_EDGES);
+        roads[player].add(indexOfEdge);
+        moveGenerator.placeRoad(player, indexOfEdge);
+        roadGraph.placeRoad(player, indexOfEdge);
         lastBuilding = "";
         if (!isMainTurn) {
             updatePhase();
@@ -212,110 +281,98 @@ public:
     }
 
 
-    crow::json::wvalue toJson() const {
-        crow::json::wvalue json;
-        json["currentPlayer"] = currentPlayer;
-        json["phase"] = Game::toString(phase);
-        json["lastBuilding"] = lastBuilding;
+    // Method `getVectorOfLegalMoves` returns the legal moves of the current player in the current phase.
+    std::vector<Game::Move> getVectorOfLegalMoves() const {
+        std::vector<Game::Move> vectorOfMoves;
+        moveGenerator.generateMoves(phase, currentPlayer, lastBuilding, resources[currentPlayer], vectorOfMoves);
+        return vectorOfMoves;
+    }
 
-        crow::json::wvalue resourcesJson(crow::json::type::Object);
-        for (int player = 1; player <= 3; ++player) {
-            const auto& bag = resources[player];
-            crow::json::wvalue bagJson(crow::json::type::Object);
-            bagJson["brick"] = bag.brick;
-            bagJson["grain"] = bag.grain;
-            bagJson["lumber"] = bag.lumber;
-            bagJson["ore"] = bag.ore;
-            bagJson["wool"] = bag.wool;
-            bagJson["cloth"] = bag.cloth;
-            bagJson["coin"] = bag.coin;
-            bagJson["paper"] = bag.paper;
-            resourcesJson["Player " + std::to_string(player)] = std::move(bagJson);
-        }
-		json["resources"] = std::move(resourcesJson);
-
-        crow::json::wvalue settlementsJson(crow::json::type::Object);
-        for (const auto& [player, vertices] : settlements) {
-            crow::json::wvalue arr(crow::json::type::List);
-            int i = 0;
-            for (const auto& vertex : vertices) {
-                arr[i++] = vertex;
+
+    /* Method `getLengthOfLongestRoad` returns the number of edges of the longest road of a player,
+    * which the road graph searches again only for road networks changed since the last query.
+    */
+    int getLengthOfLongestRoad(int player) const {
+        return roadGraph.getLengthOfLongestRoad(player);
+    }
+
+
+    /* Method `synchronizeMoveGenerator` rebuilds the masks of the move generator and the road graph from the lists of structures.
+    * Code that fills `settlements`, `cities`, `roads`, or `walls` directly, such as loading a game state from the database, calls it afterwards.
+    */
+    void synchronizeMoveGenerator() {
+        moveGenerator = Game::MoveGenerator();
+        roadGraph = Game::RoadGraph();
+        for (int player = 1; player <= 3; player++) {
+            for (int indexOfVertex : settlements[player]) {
+                moveGenerator.placeSettlement(player, indexOfVertex);
+                roadGraph.placeBuilding(player, indexOfVertex);
             }
-            settlementsJson["Player " + std::to_string(player)] = std::move(arr);
-        }
-        json["settlements"] = std::move(settlementsJson);
-
-        crow::json::wvalue citiesJson(crow::json::type::Object);
-        for (const auto& pair : cities) {
-            crow::json::wvalue arr(crow::json::type::List);
-            int i = 0;
-            for (const auto& vertex : pair.second) {
-                arr[i++] = vertex;
+            for (int indexOfVertex : cities[player]) {
+                moveGenerator.placeCity(player, indexOfVertex);
+                roadGraph.placeBuilding(player, indexOfVertex);
             }
-            citiesJson["Player " + std::to_string(pair.first)] = std::move(arr);
-        }
-        json["cities"] = std::move(citiesJson);
-
-        crow::json::wvalue roadsJson(crow::json::type::Object);
-        for (const auto& pair : roads) {
-            crow::json::wvalue arr(crow::json::type::List);
-            int i = 0;
-            for (const auto& edge : pair.second) {
-                arr[i++] = edge;
+            for (int indexOfVertex : walls[player]) {
+                moveGenerator.placeWall(player, indexOfVertex);
             }
-            roadsJson["Player " + std::to_string(pair.first)] = std::move(arr);
-        }
-        json["roads"] = std::move(roadsJson);
-
-        crow::json::wvalue wallsJson(crow::json::type::Object);
-        for (const auto& pairOfNumberOfPlayerAndArrayOfLabelsOfVerticesWithWalls : walls) {
-            int numberOfPlayer = pairOfNumberOfPlayerAndArrayOfLabelsOfVerticesWithWalls.first;
-            std::vector<std::string> vectorOfLabelsOfVerticesWithWalls = pairOfNumberOfPlayerAndArrayOfLabelsOfVerticesWithWalls.second;
-            crow::json::wvalue arr(crow::json::type::List);
-            int i = 0;
-            for (auto& labelOfVertexWithWall : vectorOfLabelsOfVerticesWithWalls) {
-                arr[i++] = labelOfVertexWithWall;
+            for (int indexOfEdge : roads[player]) {
+                moveGenerator.placeRoad(player, indexOfEdge);
+                roadGraph.placeRoad(player, indexOfEdge);
             }
-            wallsJson["Player " + std::to_string(numberOfPlayer)] = std::move(arr);
         }
-        json["walls"] = std::move(wallsJson);
-
-		crow::json::wvalue jsonObjectOfDescriptionOfDiceAndRolls(crow::json::type::Object);
-        jsonObjectOfDescriptionOfDiceAndRolls["yellowProductionDie"] = yellowProductionDie;
-        jsonObjectOfDescriptionOfDiceAndRolls["redProductionDie"] = redProductionDie;
-        jsonObjectOfDescriptionOfDiceAndRolls["whiteEventDie"] = whiteEventDie;
-		json["dice"] = std::move(jsonObjectOfDescriptionOfDiceAndRolls);
-
-        return json;
     }
 
 
-private:
-
+    void writeJson(Json::JsonWriter& writer) const {
+        const Game::MasksOfBoard& masksOfBoard = Game::getMasksOfBoard();
+        auto writeLabelsOfPlayers = [&writer](const auto& listsOfLocationsOfPlayers, const auto& labelsOfLocations) {
+            writer.beginObject();
+            for (int player = 1; player <= 3; player++) {
+                writer.key("Player " + std::to_string(player)).beginArray();
+                for (int indexOfLocation : listsOfLocationsOfPlayers[player]) {
+                    writer.value(labelsOfLocations[indexOfLocation]);
+                }
+                writer.endArray();
+            }
+            writer.endObject();
+        };
 
-	inline static crow::json::rvalue isometricCoordinatesCache;
-	inline static std::once_flag onceFlag;
+        writer.beginObject();
+        writer.key("currentPlayer").value(currentPlayer);
+        writer.key("phase").value(Game::toString(phase));
+        writer.key("lastBuilding").value(lastBuilding);
+        writer.key("resources");
+        writeResourceBagsOfPlayers(writer, resources);
+        writer.key("settlements");
+        writeLabelsOfPlayers(settlements, masksOfBoard.labelsOfVertices);
+        writer.key("cities");
+        writeLabelsOfPlayers(cities, masksOfBoard.labelsOfVertices);
+        writer.key("roads");
+        writeLabelsOfPlayers(roads, masksOfBoard.labelsOfEdges);
+        writer.key("walls");
+        writeLabelsOfPlayers(walls, masksOfBoard.labelsOfVertices);
+        writer.key("dice").beginObject();
+        writer.key("yellowProductionDie").value(yellowProductionDie);
+        writer.key("redProductionDie").value(redProductionDie);
+        writer.key("whiteEventDie").value(whiteEventDie);
+        writer.endObject();
+        writer.endObject();
+    }
 
 
-    static void loadIsometricCoordinates() {
-		std::call_once(onceFlag, [] {
-            std::ifstream f("../generate_board_geometry/isometric_coordinates.json");
-			if (!f.is_open()) {
-				throw std::runtime_error("Isometric coordinates file could not be opened.");
-			}
-			std::stringstream buffer;
-			buffer << f.rdbuf();
-			isometricCoordinatesCache = crow::json::load(buffer.str());
-			if (!isometricCoordinatesCache) {
-				throw std::runtime_error("Isometric coordinates file could not be parsed.");
-			}
-		});
+    std::string toJson() const {
+        Json::JsonWriter writer;
+        writeJson(writer);
+        return writer.str();
     }
 
 
+private:
+
+
     bool checkForWinner() {
         for (int player = 1; player <= 3; player++) {
-			int numberOfBuildings = static_cast<int>(settlements[player].size() + cities[player].size());
+			int numberOfBuildings = settlements[player].size() + cities[player].size();
             if (numberOfBuildings >= 5) {
                 winner = player;
                 phase = Game::Phase::Done;
@@ -326,67 +383,47 @@ private:
     }
 
 
+    /* Method `collectResources` gives every player the resources of the hexes whose number of token is the sum of the production dice.
+    * A settlement collects 1 resource. A city collects 2 brick or 2 grain, or 1 lumber and 1 paper, 1 ore and 1 coin, or 1 wool and 1 cloth.
+    * What each vertex collects for each sum is looked up in the production table of the layout.
+    */
     void collectResources() {
-		const int rolledNumber = redProductionDie + yellowProductionDie;
-        loadIsometricCoordinates();
-
-        const crow::json::rvalue& jsonObjectOfIdsOfHexesAndNamesOfResources = isometricCoordinatesCache["objectOfIdsOfHexesAndNamesOfResources"];
-		const crow::json::rvalue& jsonObjectOfIdsOfHexesAndNumbersOfTokens = isometricCoordinatesCache["objectOfIdsOfHexesAndNumbersOfTokens"];
-        const crow::json::rvalue& jsonObjectOfIdsOfHexesAndArraysOfLabelsOfVertices = isometricCoordinatesCache["objectOfIdsOfHexesAndArraysOfIdsOfVertices"];
-
-        for (const crow::json::rvalue& jsonObjectWithNumberOfToken : jsonObjectOfIdsOfHexesAndNumbersOfTokens) {
-			std::string idOfHex = jsonObjectWithNumberOfToken.key();
-			int numberOfToken = static_cast<int>(jsonObjectWithNumberOfToken.d());
-			if (numberOfToken != rolledNumber) {
-				continue;
-			}
-			std::string resource = jsonObjectOfIdsOfHexesAndNamesOfResources[idOfHex].s();
-			if (resource == "nothing") {
-				continue;
-			}
-            const crow::json::rvalue& jsonArrayOfLabelsOfVertices = jsonObjectOfIdsOfHexesAndArraysOfLabelsOfVertices[idOfHex];
-            for (int player = 1; player <= 3; ++player) {
-                auto& bag = resources[player];
-                for (const std::string& labelOfVertex : settlements[player]) {
-                    for (const crow::json::rvalue& keyValuePair : jsonArrayOfLabelsOfVertices) {
-                        if (keyValuePair.s() == labelOfVertex) {
-                            if (resource == "brick") { bag.brick++; }
-                            else if (resource == "grain") { bag.grain++; }
-                            else if (resource == "lumber") { bag.lumber++; }
-                            else if (resource == "ore") { bag.ore++; }
-                            else if (resource == "wool") { bag.wool++; }
-                            else if (resource == "cloth") { bag.cloth++; }
-                            else if (resource == "coin") { bag.coin++; }
-                            else if (resource == "paper") { bag.paper++; }
-                            break;
-                        }
-                    }
+        const int rolledNumber = redProductionDie + yellowProductionDie;
+        if (rolledNumber < 0 || rolledNumber > Game::MAXIMUM_SUM_OF_DICE) {
+            return;
+        }
+        const uint64_t maskOfProducingVertices = precomputedBoardLayout->masksOfProducingVertices[rolledNumber];
+        if (maskOfProducingVertices == 0) {
+            return;
+        }
+        const auto& numbersOfResourcesProducedAtVertices = precomputedBoardLayout->numbersOfResourcesProducedAtVertices[rolledNumber];
+
+        for (int player = 1; player <= 3; ++player) {
+            auto& bag = resources[player];
+            for (int indexOfVertex : settlements[player]) {
+                if (((maskOfProducingVertices >> indexOfVertex) & 1) == 0) {
+                    continue;
                 }
-                for (const std::string& labelOfVertex : cities[player]) {
-                    for (const crow::json::rvalue& keyValuePair : jsonArrayOfLabelsOfVertices) {
-                        if (keyValuePair.s() == labelOfVertex) {
-                            if (resource == "brick") {
-                                bag.brick += 2;
-                            }
-                            else if (resource == "grain") {
-                                bag.grain += 2;
-                            }
-                            else if (resource == "lumber") {
-                                bag.lumber += 1;
-                                bag.paper += 1;
-                            }
-                            else if (resource == "ore") {
-                                bag.ore += 1;
-                                bag.coin += 1;
-                            }
-                            else if (resource == "wool") {
-                                bag.wool += 1;
-                                bag.cloth += 1;
-                            }
-                            break;
-                        }
-                    }
+                const std::array<uint8_t, Game::NUMBER_OF_PRODUCED_RESOURCES>& numbersOfResources = numbersOfResourcesProducedAtVertices[indexOfVertex];
+                bag.brick += numbersOfResources[0];
+                bag.grain += numbersOfResources[1];
+                bag.lumber += numbersOfResources[2];
+                bag.ore += numbersOfResources[3];
+                bag.wool += numbersOfResources[4];
+            }
+            for (int indexOfVertex : cities[player]) {
+                if (((maskOfProducingVertices >> indexOfVertex) & 1) == 0) {
+                    continue;
                 }
+                const std::array<uint8_t, Game::NUMBER_OF_PRODUCED_RESOURCES>& numbersOfResources = numbersOfResourcesProducedAtVertices[indexOfVertex];
+                bag.brick += 2 * numbersOfResources[0];
+                bag.grain += 2 * numbersOfResources[1];
+                bag.lumber += numbersOfResources[2];
+                bag.paper += numbersOfResources[2];
+                bag.ore += numbersOfResources[3];
+                bag.coin += numbersOfResources[3];
+                bag.wool += numbersOfResources[4];
+                bag.cloth += numbersOfResources[4];
             }
         }
     }
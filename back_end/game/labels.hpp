@@ -0,0 +1,31 @@
+#pragma once
+
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+
+namespace Game {
+
+	constexpr int NUMBER_OF_HEXES = 19;
+	constexpr int NUMBER_OF_VERTICES = 54;
+	constexpr int NUMBER_OF_EDGES = 72;
+
+	// Function `getIndexOfLabel` converts a label like "V07" or "E07" to a zero based index like 6.
+	int getIndexOfLabel(const std::string& label, int numberOfLabels) {
+		int index = std::stoi(label.substr(1)) - 1;
+		if (index < 0 || index >= numberOfLabels) {
+			throw std::runtime_error("Label " + label + " is out of range.");
+		}
+		return index;
+	}
+
+	// Function `formatLabel` formats a prefix and a one based index as a label like "V07".
+	std::string formatLabel(char prefix, int index) {
+		char label[4];
+		std::snprintf(label, sizeof(label), "%c%02d", prefix, index);
+		return label;
+	}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+
+#include <array>
+#include <cstdint>
+#include "labels.hpp"
+#include <stdexcept>
+#include <string>
+
+
+namespace Game {
+
+	/* Class template `ListOfLocations` is a list of zero based indices of vertices or edges, in the order they were added,
+	* stored inline with a fixed capacity. A game state holds its structures in these lists, so copying a game state,
+	* as every node of MCTS does, copies bytes and never allocates. Adding an index to a full list throws.
+	*/
+	template <int CAPACITY>
+	class ListOfLocations {
+	public:
+
+		static_assert(CAPACITY > 0 && CAPACITY <= 255, "The number of indices of a list of locations is stored in 1 byte.");
+
+		void add(int index) {
+			if (numberOfIndices == CAPACITY) {
+				throw std::length_error("A list of locations already holds " + std::to_string(CAPACITY) + " locations.");
+			}
+			indices[numberOfIndices++] = static_cast<uint8_t>(index);
+		}
+
+		// Method `remove` removes an index, keeping the order of the others, and returns whether the list held it.
+		bool remove(int index) {
+			for (int i = 0; i < numberOfIndices; i++) {
+				if (indices[i] == index) {
+					for (int j = i + 1; j < numberOfIndices; j++) {
+						indices[j - 1] = indices[j];
+					}
+					numberOfIndices--;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool contains(int index) const {
+			for (int i = 0; i < numberOfIndices; i++) {
+				if (indices[i] == index) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void clear() {
+			numberOfIndices = 0;
+		}
+
+		int size() const {
+			return numberOfIndices;
+		}
+
+		bool isEmpty() const {
+			return numberOfIndices == 0;
+		}
+
+		int operator[](int i) const {
+			return indices[i];
+		}
+
+		const uint8_t* begin() const {
+			return indices.data();
+		}
+
+		const uint8_t* end() const {
+			return indices.data() + numberOfIndices;
+		}
+
+	private:
+
+		std::array<uint8_t, CAPACITY> indices{};
+		uint8_t numberOfIndices = 0;
+	};
+
+
+	/* Constant `MAXIMUM_NUMBER_OF_BUILDINGS_OF_TYPE` bounds the settlements, cities, or walls of one player.
+	* A game ends when a player has 5 settlements and cities, so only game states built by hand come near it.
+	* A player may hold roads on every edge.
+	*/
+	constexpr int MAXIMUM_NUMBER_OF_BUILDINGS_OF_TYPE = 15;
+
+	using ListOfVertices = ListOfLocations<MAXIMUM_NUMBER_OF_BUILDINGS_OF_TYPE>;
+	using ListOfEdges = ListOfLocations<NUMBER_OF_EDGES>;
+
+}
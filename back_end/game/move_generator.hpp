@@ -0,0 +1,241 @@
+#pragma once
+
+
+#include <array>
+#include <bit>
+#include "board_topology.hpp"
+#include <cstdint>
+#include "labels.hpp"
+#include "phase.hpp"
+#include "resource_bag.hpp"
+#include <string>
+#include <vector>
+
+
+namespace Game {
+
+	/* Structure `Move` is a label of a vertex or edge, or "pass", with a type of move
+	* "settlement", "city", "wall", "road", or "pass".
+	*/
+	struct Move {
+		std::string label;
+		std::string type;
+	};
+
+
+	// Structure `MaskOfEdges` is a set of the 72 edges, where edge i is bit i % 64 of word i / 64.
+	struct MaskOfEdges {
+		std::array<uint64_t, 2> words{};
+
+		void set(int indexOfEdge) {
+			words[indexOfEdge >> 6] |= uint64_t{ 1 } << (indexOfEdge & 63);
+		}
+
+		void reset(int indexOfEdge) {
+			words[indexOfEdge >> 6] &= ~(uint64_t{ 1 } << (indexOfEdge & 63));
+		}
+
+		bool test(int indexOfEdge) const {
+			return ((words[indexOfEdge >> 6] >> (indexOfEdge & 63)) & 1) != 0;
+		}
+
+		bool isEmpty() const {
+			return (words[0] | words[1]) == 0;
+		}
+
+		int count() const {
+			return std::popcount(words[0]) + std::popcount(words[1]);
+		}
+
+		// Method `getFirst` returns the lowest index of an edge in a set that is not empty.
+		int getFirst() const {
+			return (words[0] != 0) ? std::countr_zero(words[0]) : 64 + std::countr_zero(words[1]);
+		}
+
+		MaskOfEdges& operator|=(const MaskOfEdges& other) {
+			words[0] |= other.words[0];
+			words[1] |= other.words[1];
+			return *this;
+		}
+
+		MaskOfEdges& operator&=(const MaskOfEdges& other) {
+			words[0] &= other.words[0];
+			words[1] &= other.words[1];
+			return *this;
+		}
+
+		// Method `removeAll` removes every edge of another set from this set.
+		MaskOfEdges& removeAll(const MaskOfEdges& other) {
+			words[0] &= ~other.words[0];
+			words[1] &= ~other.words[1];
+			return *this;
+		}
+	};
+
+
+	/* Structure `MasksOfBoard` holds, for every vertex, the set of adjacent vertices and the set of edges extending from it,
+	* the two vertices of every edge, and the labels of vertices and edges, indexed by zero based indices.
+	*/
+	struct MasksOfBoard {
+		std::array<uint64_t, NUMBER_OF_VERTICES> masksOfAdjacentVertices{};
+		std::array<MaskOfEdges, NUMBER_OF_VERTICES> masksOfEdgesOfVertices{};
+		std::array<std::array<int, 2>, NUMBER_OF_EDGES> indicesOfVerticesOfEdges{};
+		std::array<std::string, NUMBER_OF_VERTICES> labelsOfVertices;
+		std::array<std::string, NUMBER_OF_EDGES> labelsOfEdges;
+	};
+
+
+	// Function `createMasksOfBoard` converts the lists of adjacent vertices and extending edges of the board in use into masks.
+	MasksOfBoard createMasksOfBoard() {
+		const BoardTopology& boardTopology = getBoardTopology();
+		MasksOfBoard masksOfBoard;
+		for (int indexOfVertex = 0; indexOfVertex < NUMBER_OF_VERTICES; indexOfVertex++) {
+			masksOfBoard.labelsOfVertices[indexOfVertex] = formatLabel('V', indexOfVertex + 1);
+			for (int indexOfAdjacentVertex : boardTopology.indicesOfAdjacentVertices[indexOfVertex]) {
+				if (indexOfAdjacentVertex >= 0) {
+					masksOfBoard.masksOfAdjacentVertices[indexOfVertex] |= uint64_t{ 1 } << indexOfAdjacentVertex;
+				}
+			}
+			for (int indexOfEdge : boardTopology.indicesOfEdgesOfVertices[indexOfVertex]) {
+				if (indexOfEdge >= 0) {
+					masksOfBoard.masksOfEdgesOfVertices[indexOfVertex].set(indexOfEdge);
+				}
+			}
+		}
+		for (int indexOfEdge = 0; indexOfEdge < NUMBER_OF_EDGES; indexOfEdge++) {
+			masksOfBoard.labelsOfEdges[indexOfEdge] = formatLabel('E', indexOfEdge + 1);
+		}
+		masksOfBoard.indicesOfVerticesOfEdges = boardTopology.indicesOfVerticesOfEdges;
+		return masksOfBoard;
+	}
+
+
+	// Function `getMasksOfBoard` returns the masks of the board in use, which are created once.
+	const MasksOfBoard& getMasksOfBoard() {
+		static const MasksOfBoard masksOfBoard = createMasksOfBoard();
+		return masksOfBoard;
+	}
+
+
+	/* Class `MoveGenerator` keeps sets of vertices and edges as masks of bits that a game state updates as structures are placed,
+	* so that generating legal moves iterates over the set bits of a few masks instead of scanning the board.
+	* A vertex is blocked if it or an adjacent vertex is occupied. The frontier of a player is the set of unoccupied edges
+	* extending from a vertex of a road of that player. Placing a structure costs a few operations on words;
+	* generating moves costs time proportional to the number of moves.
+	*/
+	class MoveGenerator {
+	public:
+
+		void placeSettlement(int player, int indexOfVertex) {
+			const uint64_t bitOfVertex = uint64_t{ 1 } << indexOfVertex;
+			maskOfOccupiedVertices |= bitOfVertex;
+			maskOfBlockedVertices |= bitOfVertex | getMasksOfBoard().masksOfAdjacentVertices[indexOfVertex];
+			masksOfSettlementsOfPlayers[player] |= bitOfVertex;
+		}
+
+		// Method `placeCity` places a city at a vertex, which replaces a settlement of the player at that vertex if there is one.
+		void placeCity(int player, int indexOfVertex) {
+			const uint64_t bitOfVertex = uint64_t{ 1 } << indexOfVertex;
+			maskOfOccupiedVertices |= bitOfVertex;
+			maskOfBlockedVertices |= bitOfVertex | getMasksOfBoard().masksOfAdjacentVertices[indexOfVertex];
+			masksOfSettlementsOfPlayers[player] &= ~bitOfVertex;
+			masksOfCitiesOfPlayers[player] |= bitOfVertex;
+		}
+
+		void placeWall(int player, int indexOfVertex) {
+			masksOfWallsOfPlayers[player] |= uint64_t{ 1 } << indexOfVertex;
+		}
+
+		/* Method `placeRoad` removes an edge from the frontiers of all players
+		* and adds the unoccupied edges extending from the vertices of the edge to the frontier of the player.
+		*/
+		void placeRoad(int player, int indexOfEdge) {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			MaskOfEdges maskOfEdge;
+			maskOfEdge.set(indexOfEdge);
+			maskOfOccupiedEdges |= maskOfEdge;
+			for (MaskOfEdges& maskOfFrontierEdges : masksOfFrontierEdgesOfPlayers) {
+				maskOfFrontierEdges.removeAll(maskOfEdge);
+			}
+			for (int indexOfVertex : masksOfBoard.indicesOfVerticesOfEdges[indexOfEdge]) {
+				masksOfVerticesOfRoadsOfPlayers[player] |= uint64_t{ 1 } << indexOfVertex;
+				masksOfFrontierEdgesOfPlayers[player] |= masksOfBoard.masksOfEdgesOfVertices[indexOfVertex];
+			}
+			masksOfFrontierEdgesOfPlayers[player].removeAll(maskOfOccupiedEdges);
+		}
+
+		/* Method `generateMoves` appends the legal moves of a player in a phase to a vector.
+		* In phases FirstSettlement and FirstCity, every vertex that is not blocked is legal.
+		* In phases FirstRoad and SecondRoad, every unoccupied edge extending from the last building is legal.
+		* In phase Turn, if the player can afford them, settlements at unblocked vertices of roads of the player, roads on the frontier of the player,
+		* cities at settlements of the player, and walls at cities of the player without walls are legal, and passing always is.
+		* Other phases have no legal moves.
+		*/
+		void generateMoves(
+			Phase phase,
+			int player,
+			const std::string& labelOfLastBuilding,
+			const ResourceBag& resources,
+			std::vector<Move>& vectorOfMoves
+		) const {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			const uint64_t maskOfAvailableVertices = MASK_OF_ALL_VERTICES & ~maskOfBlockedVertices;
+			if (phase == Phase::FirstSettlement) {
+				appendVertices(maskOfAvailableVertices, "settlement", vectorOfMoves);
+			}
+			else if (phase == Phase::FirstCity) {
+				appendVertices(maskOfAvailableVertices, "city", vectorOfMoves);
+			}
+			else if (phase == Phase::FirstRoad || phase == Phase::SecondRoad) {
+				MaskOfEdges maskOfEdges = masksOfBoard.masksOfEdgesOfVertices[getIndexOfLabel(labelOfLastBuilding, NUMBER_OF_VERTICES)];
+				maskOfEdges.removeAll(maskOfOccupiedEdges);
+				appendEdges(maskOfEdges, vectorOfMoves);
+			}
+			else if (phase == Phase::Turn) {
+				if (resources.brick >= 1 && resources.grain >= 1 && resources.lumber >= 1 && resources.wool >= 1) {
+					appendVertices(maskOfAvailableVertices & masksOfVerticesOfRoadsOfPlayers[player], "settlement", vectorOfMoves);
+				}
+				if (resources.brick >= 1 && resources.lumber >= 1) {
+					appendEdges(masksOfFrontierEdgesOfPlayers[player], vectorOfMoves);
+				}
+				if (resources.grain >= 2 && resources.ore >= 3) {
+					appendVertices(masksOfSettlementsOfPlayers[player], "city", vectorOfMoves);
+				}
+				if (resources.brick >= 2) {
+					appendVertices(masksOfCitiesOfPlayers[player] & ~masksOfWallsOfPlayers[player], "wall", vectorOfMoves);
+				}
+				vectorOfMoves.push_back(Move{ "pass", "pass" });
+			}
+		}
+
+	private:
+
+		static constexpr uint64_t MASK_OF_ALL_VERTICES = (uint64_t{ 1 } << NUMBER_OF_VERTICES) - 1;
+
+		uint64_t maskOfOccupiedVertices = 0;
+		uint64_t maskOfBlockedVertices = 0;
+		MaskOfEdges maskOfOccupiedEdges;
+		std::array<uint64_t, 4> masksOfSettlementsOfPlayers{};
+		std::array<uint64_t, 4> masksOfCitiesOfPlayers{};
+		std::array<uint64_t, 4> masksOfWallsOfPlayers{};
+		std::array<uint64_t, 4> masksOfVerticesOfRoadsOfPlayers{};
+		std::array<MaskOfEdges, 4> masksOfFrontierEdgesOfPlayers{};
+
+		static void appendVertices(uint64_t maskOfVertices, const char* typeOfMove, std::vector<Move>& vectorOfMoves) {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			for (; maskOfVertices != 0; maskOfVertices &= maskOfVertices - 1) {
+				vectorOfMoves.push_back(Move{ masksOfBoard.labelsOfVertices[std::countr_zero(maskOfVertices)], typeOfMove });
+			}
+		}
+
+		static void appendEdges(const MaskOfEdges& maskOfEdges, std::vector<Move>& vectorOfMoves) {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			for (int indexOfWord = 0; indexOfWord < 2; indexOfWord++) {
+				for (uint64_t word = maskOfEdges.words[indexOfWord]; word != 0; word &= word - 1) {
+					vectorOfMoves.push_back(Move{ masksOfBoard.labelsOfEdges[indexOfWord * 64 + std::countr_zero(word)], "road" });
+				}
+			}
+		}
+	};
+
+}
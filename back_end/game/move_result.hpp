@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <array>
+#include "game_state.hpp"
+#include "../json_writer.hpp"
+#include <string>
+
+
+namespace Game {
+
+	/* Structure `MoveResult` describes the outcome of a move without serializing it.
+	* Endpoints write it with a `Json::JsonWriter` and store its serialized dice and resources as settings.
+	*/
+	struct MoveResult {
+		std::string message;
+
+		// "settlement", "city", "road", "wall", or empty if no structure was placed.
+		std::string typeOfStructure;
+		int idOfStructure{ 0 };
+		int player{ 0 };
+		std::string labelOfVertexOrEdge;
+
+		bool diceWereRolled{ false };
+		int yellowProductionDie{ 0 };
+		int redProductionDie{ 0 };
+		std::string whiteEventDie;
+
+		bool resourcesAreReported{ false };
+		std::array<ResourceBag, 4> resourcesBeforeMove;
+		std::array<ResourceBag, 4> resourcesAfterMove;
+
+		void recordStructure(const std::string& typeOfStructureToRecord, int idOfStructureToRecord, int playerToRecord, const std::string& labelToRecord) {
+			typeOfStructure = typeOfStructureToRecord;
+			idOfStructure = idOfStructureToRecord;
+			player = playerToRecord;
+			labelOfVertexOrEdge = labelToRecord;
+		}
+
+		void recordDice(const GameState& state) {
+			diceWereRolled = true;
+			yellowProductionDie = state.yellowProductionDie;
+			redProductionDie = state.redProductionDie;
+			whiteEventDie = state.whiteEventDie;
+		}
+
+		void recordResources(const std::array<ResourceBag, 4>& resourcesBefore, const std::array<ResourceBag, 4>& resourcesAfter) {
+			resourcesAreReported = true;
+			resourcesBeforeMove = resourcesBefore;
+			resourcesAfterMove = resourcesAfter;
+		}
+
+		// Method `writeStructure` writes a JSON object with keys "id", "player", and "vertex" or "edge".
+		void writeStructure(Json::JsonWriter& writer) const {
+			writer.beginObject();
+			writer.key("id").value(idOfStructure);
+			writer.key("player").value(player);
+			writer.key(typeOfStructure == "road" ? "edge" : "vertex").value(labelOfVertexOrEdge);
+			writer.endObject();
+		}
+
+		std::string serializeDice() const {
+			Json::JsonWriter writer;
+			writer.beginObject();
+			writer.key("yellowProductionDie").value(yellowProductionDie);
+			writer.key("redProductionDie").value(redProductionDie);
+			writer.key("whiteEventDie").value(whiteEventDie);
+			writer.endObject();
+			return writer.str();
+		}
+
+		std::string serializeGainedResources() const {
+			Json::JsonWriter writer;
+			writeDifferencesOfResourceBagsOfPlayers(writer, resourcesBeforeMove, resourcesAfterMove);
+			return writer.str();
+		}
+
+		std::string serializeTotalResources() const {
+			Json::JsonWriter writer;
+			writeResourceBagsOfPlayers(writer, resourcesAfterMove);
+			return writer.str();
+		}
+	};
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+
+#include <cstdint>
+
+
+namespace Game {
+
+	// Enumeration `Resource` is the resource produced by a hex; a desert produces nothing.
+	enum class Resource : uint8_t {
+		Nothing,
+		Brick,
+		Grain,
+		Lumber,
+		Ore,
+		Wool
+	};
+
+}
+
+
+struct ResourceBag {
+    int brick{ 0 };
+    int grain{ 0 };
+    int lumber{ 0 };
+    int ore{ 0 };
+    int wool{ 0 };
+    int cloth{ 0 };
+    int coin{ 0 };
+    int paper{ 0 };
+};
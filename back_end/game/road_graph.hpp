@@ -0,0 +1,249 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "labels.hpp"
+#include "move_generator.hpp"
+
+
+namespace Game {
+
+	/* Class `RoadGraph` keeps the roads of every player as road networks, the connected components of the roads of the player,
+	* and caches the length of the longest road of each network.
+	* Two roads of a player are connected if they share a vertex without a building of another player, so a building of another player
+	* ends a road and may split a network. A network is labelled by the index of one of its edges, its representative,
+	* and every edge of the network stores that label.
+	* Placing a road merges the networks at its vertices, and placing a building splits the networks of other players through its vertex.
+	* Either marks only the networks it touches as dirty. The longest road of a network, the longest trail of distinct edges, is found by
+	* a depth first search over the edges of that network when the longest road is next queried, so a query after a move searches one network.
+	*/
+	class RoadGraph {
+	public:
+
+		void placeRoad(int player, int indexOfEdge) {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			MaskOfEdges& maskOfRoads = masksOfRoadsOfPlayers[player];
+			std::array<uint8_t, NUMBER_OF_EDGES>& labelsOfNetworks = labelsOfNetworksOfEdgesOfPlayers[player];
+			maskOfRoads.set(indexOfEdge);
+
+			const uint64_t maskOfBlockedVertices = getMaskOfBlockedVertices(player);
+			MaskOfEdges maskOfNetworksToMerge;
+			for (int indexOfVertex : masksOfBoard.indicesOfVerticesOfEdges[indexOfEdge]) {
+				if (((maskOfBlockedVertices >> indexOfVertex) & 1) != 0) {
+					continue;
+				}
+				MaskOfEdges maskOfAdjacentRoads = masksOfBoard.masksOfEdgesOfVertices[indexOfVertex];
+				maskOfAdjacentRoads &= maskOfRoads;
+				maskOfAdjacentRoads.reset(indexOfEdge);
+				for (; !maskOfAdjacentRoads.isEmpty(); maskOfAdjacentRoads.reset(maskOfAdjacentRoads.getFirst())) {
+					maskOfNetworksToMerge.set(labelsOfNetworks[maskOfAdjacentRoads.getFirst()]);
+				}
+			}
+			if (maskOfNetworksToMerge.isEmpty()) {
+				labelsOfNetworks[indexOfEdge] = static_cast<uint8_t>(indexOfEdge);
+				masksOfDirtyNetworksOfPlayers[player].set(indexOfEdge);
+				return;
+			}
+			const uint8_t labelOfMergedNetwork = static_cast<uint8_t>(maskOfNetworksToMerge.getFirst());
+			labelsOfNetworks[indexOfEdge] = labelOfMergedNetwork;
+			if (maskOfNetworksToMerge.count() > 1) {
+				for (MaskOfEdges maskOfEdges = maskOfRoads; !maskOfEdges.isEmpty(); maskOfEdges.reset(maskOfEdges.getFirst())) {
+					const int indexOfRoad = maskOfEdges.getFirst();
+					if (maskOfNetworksToMerge.test(labelsOfNetworks[indexOfRoad])) {
+						labelsOfNetworks[indexOfRoad] = labelOfMergedNetwork;
+					}
+				}
+			}
+			masksOfDirtyNetworksOfPlayers[player].removeAll(maskOfNetworksToMerge);
+			masksOfDirtyNetworksOfPlayers[player].set(labelOfMergedNetwork);
+		}
+
+		/* Method `placeBuilding` places a settlement or city of a player at a vertex.
+		* A network of another player with 2 or more roads at the vertex is labelled again, since the building may split it.
+		*/
+		void placeBuilding(int player, int indexOfVertex) {
+			const uint64_t bitOfVertex = uint64_t{ 1 } << indexOfVertex;
+			if ((masksOfBuildingsOfPlayers[player] & bitOfVertex) != 0) {
+				return;
+			}
+			masksOfBuildingsOfPlayers[player] |= bitOfVertex;
+			const MaskOfEdges& maskOfEdgesOfVertex = getMasksOfBoard().masksOfEdgesOfVertices[indexOfVertex];
+			for (int otherPlayer = 1; otherPlayer < NUMBER_OF_SLOTS_OF_PLAYERS; otherPlayer++) {
+				if (otherPlayer == player) {
+					continue;
+				}
+				MaskOfEdges maskOfRoadsAtVertex = maskOfEdgesOfVertex;
+				maskOfRoadsAtVertex &= masksOfRoadsOfPlayers[otherPlayer];
+				if (maskOfRoadsAtVertex.count() < 2) {
+					continue;
+				}
+				const std::array<uint8_t, NUMBER_OF_EDGES>& labelsOfNetworks = labelsOfNetworksOfEdgesOfPlayers[otherPlayer];
+				const uint8_t labelOfNetwork = labelsOfNetworks[maskOfRoadsAtVertex.getFirst()];
+				MaskOfEdges maskOfNetwork;
+				for (MaskOfEdges maskOfEdges = masksOfRoadsOfPlayers[otherPlayer]; !maskOfEdges.isEmpty(); maskOfEdges.reset(maskOfEdges.getFirst())) {
+					const int indexOfRoad = maskOfEdges.getFirst();
+					if (labelsOfNetworks[indexOfRoad] == labelOfNetwork) {
+						maskOfNetwork.set(indexOfRoad);
+					}
+				}
+				masksOfDirtyNetworksOfPlayers[otherPlayer].reset(labelOfNetwork);
+				labelNetworks(otherPlayer, maskOfNetwork);
+			}
+		}
+
+		// Method `getLengthOfLongestRoad` returns the number of edges of the longest road of a player, searching only networks changed since the last query.
+		int getLengthOfLongestRoad(int player) const {
+			const std::array<uint8_t, NUMBER_OF_EDGES>& labelsOfNetworks = labelsOfNetworksOfEdgesOfPlayers[player];
+			std::array<uint8_t, NUMBER_OF_EDGES>& lengthsOfLongestRoads = lengthsOfLongestRoadsOfNetworksOfPlayers[player];
+			MaskOfEdges& maskOfDirtyNetworks = masksOfDirtyNetworksOfPlayers[player];
+			int lengthOfLongestRoad = 0;
+			for (MaskOfEdges maskOfEdges = masksOfRoadsOfPlayers[player]; !maskOfEdges.isEmpty(); maskOfEdges.reset(maskOfEdges.getFirst())) {
+				const int indexOfRoad = maskOfEdges.getFirst();
+				if (labelsOfNetworks[indexOfRoad] != indexOfRoad) {
+					continue;
+				}
+				if (maskOfDirtyNetworks.test(indexOfRoad)) {
+					lengthsOfLongestRoads[indexOfRoad] = static_cast<uint8_t>(findLengthOfLongestRoadOfNetwork(player, indexOfRoad));
+					maskOfDirtyNetworks.reset(indexOfRoad);
+				}
+				lengthOfLongestRoad = std::max<int>(lengthOfLongestRoad, lengthsOfLongestRoads[indexOfRoad]);
+			}
+			return lengthOfLongestRoad;
+		}
+
+		int getNumberOfRoadNetworks(int player) const {
+			int numberOfRoadNetworks = 0;
+			for (MaskOfEdges maskOfEdges = masksOfRoadsOfPlayers[player]; !maskOfEdges.isEmpty(); maskOfEdges.reset(maskOfEdges.getFirst())) {
+				const int indexOfRoad = maskOfEdges.getFirst();
+				numberOfRoadNetworks += (labelsOfNetworksOfEdgesOfPlayers[player][indexOfRoad] == indexOfRoad) ? 1 : 0;
+			}
+			return numberOfRoadNetworks;
+		}
+
+		// Method `areRoadsConnected` returns whether two edges both hold roads of a player in the same network.
+		bool areRoadsConnected(int player, int indexOfEdge, int indexOfOtherEdge) const {
+			const MaskOfEdges& maskOfRoads = masksOfRoadsOfPlayers[player];
+			return
+				maskOfRoads.test(indexOfEdge) &&
+				maskOfRoads.test(indexOfOtherEdge) &&
+				labelsOfNetworksOfEdgesOfPlayers[player][indexOfEdge] == labelsOfNetworksOfEdgesOfPlayers[player][indexOfOtherEdge];
+		}
+
+	private:
+
+		static constexpr int NUMBER_OF_SLOTS_OF_PLAYERS = 4;
+
+		std::array<MaskOfEdges, NUMBER_OF_SLOTS_OF_PLAYERS> masksOfRoadsOfPlayers{};
+		std::array<uint64_t, NUMBER_OF_SLOTS_OF_PLAYERS> masksOfBuildingsOfPlayers{};
+		// Labels are meaningful only for edges with roads of the player.
+		std::array<std::array<uint8_t, NUMBER_OF_EDGES>, NUMBER_OF_SLOTS_OF_PLAYERS> labelsOfNetworksOfEdgesOfPlayers{};
+		mutable std::array<std::array<uint8_t, NUMBER_OF_EDGES>, NUMBER_OF_SLOTS_OF_PLAYERS> lengthsOfLongestRoadsOfNetworksOfPlayers{};
+		mutable std::array<MaskOfEdges, NUMBER_OF_SLOTS_OF_PLAYERS> masksOfDirtyNetworksOfPlayers{};
+
+		// Method `getMaskOfBlockedVertices` returns the set of vertices that hold a building of a player other than a given player.
+		uint64_t getMaskOfBlockedVertices(int player) const {
+			uint64_t maskOfBlockedVertices = 0;
+			for (int otherPlayer = 1; otherPlayer < NUMBER_OF_SLOTS_OF_PLAYERS; otherPlayer++) {
+				if (otherPlayer != player) {
+					maskOfBlockedVertices |= masksOfBuildingsOfPlayers[otherPlayer];
+				}
+			}
+			return maskOfBlockedVertices;
+		}
+
+		// Method `labelNetworks` labels the roads of a set of roads of a player by flood fills that stop at vertices where the player is blocked.
+		void labelNetworks(int player, MaskOfEdges maskOfRoadsToLabel) {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			std::array<uint8_t, NUMBER_OF_EDGES>& labelsOfNetworks = labelsOfNetworksOfEdgesOfPlayers[player];
+			const uint64_t maskOfBlockedVertices = getMaskOfBlockedVertices(player);
+			std::array<int, NUMBER_OF_EDGES> stackOfEdges;
+			while (!maskOfRoadsToLabel.isEmpty()) {
+				const int indexOfRepresentative = maskOfRoadsToLabel.getFirst();
+				maskOfRoadsToLabel.reset(indexOfRepresentative);
+				labelsOfNetworks[indexOfRepresentative] = static_cast<uint8_t>(indexOfRepresentative);
+				masksOfDirtyNetworksOfPlayers[player].set(indexOfRepresentative);
+				int sizeOfStack = 0;
+				stackOfEdges[sizeOfStack++] = indexOfRepresentative;
+				while (sizeOfStack > 0) {
+					const int indexOfEdge = stackOfEdges[--sizeOfStack];
+					for (int indexOfVertex : masksOfBoard.indicesOfVerticesOfEdges[indexOfEdge]) {
+						if (((maskOfBlockedVertices >> indexOfVertex) & 1) != 0) {
+							continue;
+						}
+						MaskOfEdges maskOfAdjacentRoads = masksOfBoard.masksOfEdgesOfVertices[indexOfVertex];
+						maskOfAdjacentRoads &= maskOfRoadsToLabel;
+						for (; !maskOfAdjacentRoads.isEmpty(); maskOfAdjacentRoads.reset(maskOfAdjacentRoads.getFirst())) {
+							const int indexOfAdjacentRoad = maskOfAdjacentRoads.getFirst();
+							maskOfRoadsToLabel.reset(indexOfAdjacentRoad);
+							labelsOfNetworks[indexOfAdjacentRoad] = static_cast<uint8_t>(indexOfRepresentative);
+							stackOfEdges[sizeOfStack++] = indexOfAdjacentRoad;
+						}
+					}
+				}
+			}
+		}
+
+		/* Method `findLengthOfLongestRoadOfNetwork` searches trails of a network starting from the vertices where a longest trail may end.
+		* A trail that cannot be extended ends at a blocked vertex or at a vertex with an odd number of roads of the network,
+		* unless the network has no such vertex, in which case every road lies on a closed trail through any vertex.
+		*/
+		int findLengthOfLongestRoadOfNetwork(int player, int labelOfNetwork) const {
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			MaskOfEdges maskOfNetwork;
+			uint64_t maskOfVerticesOfNetwork = 0;
+			for (MaskOfEdges maskOfEdges = masksOfRoadsOfPlayers[player]; !maskOfEdges.isEmpty(); maskOfEdges.reset(maskOfEdges.getFirst())) {
+				const int indexOfRoad = maskOfEdges.getFirst();
+				if (labelsOfNetworksOfEdgesOfPlayers[player][indexOfRoad] == labelOfNetwork) {
+					maskOfNetwork.set(indexOfRoad);
+					for (int indexOfVertex : masksOfBoard.indicesOfVerticesOfEdges[indexOfRoad]) {
+						maskOfVerticesOfNetwork |= uint64_t{ 1 } << indexOfVertex;
+					}
+				}
+			}
+			const uint64_t maskOfBlockedVertices = getMaskOfBlockedVertices(player);
+			uint64_t maskOfStartingVertices = maskOfVerticesOfNetwork & maskOfBlockedVertices;
+			for (uint64_t maskOfVertices = maskOfVerticesOfNetwork; maskOfVertices != 0; maskOfVertices &= maskOfVertices - 1) {
+				const int indexOfVertex = std::countr_zero(maskOfVertices);
+				MaskOfEdges maskOfRoadsAtVertex = masksOfBoard.masksOfEdgesOfVertices[indexOfVertex];
+				maskOfRoadsAtVertex &= maskOfNetwork;
+				if ((maskOfRoadsAtVertex.count() & 1) != 0) {
+					maskOfStartingVertices |= uint64_t{ 1 } << indexOfVertex;
+				}
+			}
+			if (maskOfStartingVertices == 0) {
+				maskOfStartingVertices = maskOfVerticesOfNetwork & (~maskOfVerticesOfNetwork + 1);
+			}
+			int lengthOfLongestRoad = 0;
+			for (; maskOfStartingVertices != 0; maskOfStartingVertices &= maskOfStartingVertices - 1) {
+				lengthOfLongestRoad = std::max(lengthOfLongestRoad, extendRoad(std::countr_zero(maskOfStartingVertices), maskOfNetwork, maskOfBlockedVertices, true));
+			}
+			return lengthOfLongestRoad;
+		}
+
+		/* Function `extendRoad` returns the number of edges of the longest trail of unused roads from a vertex.
+		* A trail may start at a blocked vertex but may not pass through one.
+		*/
+		static int extendRoad(int indexOfVertex, MaskOfEdges& maskOfUnusedRoads, uint64_t maskOfBlockedVertices, bool isStartOfRoad) {
+			if (!isStartOfRoad && ((maskOfBlockedVertices >> indexOfVertex) & 1) != 0) {
+				return 0;
+			}
+			const MasksOfBoard& masksOfBoard = getMasksOfBoard();
+			MaskOfEdges maskOfNextRoads = masksOfBoard.masksOfEdgesOfVertices[indexOfVertex];
+			maskOfNextRoads &= maskOfUnusedRoads;
+			int lengthOfLongestRoad = 0;
+			for (; !maskOfNextRoads.isEmpty(); maskOfNextRoads.reset(maskOfNextRoads.getFirst())) {
+				const int indexOfRoad = maskOfNextRoads.getFirst();
+				const std::array<int, 2>& indicesOfVertices = masksOfBoard.indicesOfVerticesOfEdges[indexOfRoad];
+				const int indexOfOtherVertex = (indicesOfVertices[0] == indexOfVertex) ? indicesOfVertices[1] : indicesOfVertices[0];
+				maskOfUnusedRoads.reset(indexOfRoad);
+				lengthOfLongestRoad = std::max(lengthOfLongestRoad, 1 + extendRoad(indexOfOtherVertex, maskOfUnusedRoads, maskOfBlockedVertices, false));
+				maskOfUnusedRoads.set(indexOfRoad);
+			}
+			return lengthOfLongestRoad;
+		}
+	};
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+namespace Json {
+
+	/* Class `JsonWriter` appends JSON text directly to a string without building a tree of values.
+	* Commas and colons are inserted automatically; callers open and close objects and arrays and write keys and values in order.
+	* By default a writer appends to a buffer owned by the current thread, which keeps its capacity between responses.
+	* A writer constructed while another writer on the same thread is using that buffer uses a buffer of its own.
+	*
+	* Example:
+	*     Json::JsonWriter writer;
+	*     writer.beginObject();
+	*     writer.key("message").value("Player 1 passed.");
+	*     writer.key("dice").beginObject().key("redProductionDie").value(3).endObject();
+	*     writer.endObject();
+	*     std::string body = writer.str();
+	*/
+	class JsonWriter {
+	public:
+
+		JsonWriter() :
+			bufferIsOwnedByThread(!bufferOfThreadIsInUse),
+			buffer(bufferIsOwnedByThread ? bufferOfThread : ownBuffer)
+		{
+			if (bufferIsOwnedByThread) {
+				bufferOfThreadIsInUse = true;
+			}
+			buffer.clear();
+		}
+
+		JsonWriter(const JsonWriter&) = delete;
+		JsonWriter& operator=(const JsonWriter&) = delete;
+
+		~JsonWriter() {
+			if (bufferIsOwnedByThread) {
+				bufferOfThreadIsInUse = false;
+			}
+		}
+
+		JsonWriter& beginObject() {
+			return open('{');
+		}
+
+		JsonWriter& endObject() {
+			return close('}');
+		}
+
+		JsonWriter& beginArray() {
+			return open('[');
+		}
+
+		JsonWriter& endArray() {
+			return close(']');
+		}
+
+		JsonWriter& key(std::string_view keyToWrite) {
+			prepareForValue();
+			appendQuotedString(keyToWrite);
+			buffer += ':';
+			keyWasJustWritten = true;
+			return *this;
+		}
+
+		JsonWriter& value(std::string_view string) {
+			prepareForValue();
+			appendQuotedString(string);
+			return *this;
+		}
+
+		JsonWriter& value(const char* string) {
+			return value(std::string_view(string));
+		}
+
+		JsonWriter& value(const std::string& string) {
+			return value(std::string_view(string));
+		}
+
+		JsonWriter& value(bool boolean) {
+			prepareForValue();
+			buffer += boolean ? "true" : "false";
+			return *this;
+		}
+
+		JsonWriter& value(int integer) {
+			return appendNumber(integer);
+		}
+
+		JsonWriter& value(long long integer) {
+			return appendNumber(integer);
+		}
+
+		JsonWriter& value(unsigned long long integer) {
+			return appendNumber(integer);
+		}
+
+		// Method `value` writes a finite number, or `null` for NaN and infinities, which JSON cannot represent.
+		JsonWriter& value(double number) {
+			if (!std::isfinite(number)) {
+				return null();
+			}
+			return appendNumber(number);
+		}
+
+		JsonWriter& null() {
+			prepareForValue();
+			buffer += "null";
+			return *this;
+		}
+
+		// Method `raw` writes text that is already valid JSON, such as a value stored in the database, as the next value.
+		JsonWriter& raw(std::string_view json) {
+			prepareForValue();
+			buffer += json;
+			return *this;
+		}
+
+		const std::string& getBuffer() const {
+			return buffer;
+		}
+
+		std::string str() const {
+			return buffer;
+		}
+
+		// Function `quote` returns a string as a JSON string literal.
+		static std::string quote(std::string_view string) {
+			JsonWriter writer;
+			writer.value(string);
+			return writer.str();
+		}
+
+	private:
+
+		static constexpr int MAXIMUM_DEPTH = 32;
+
+		inline static thread_local std::string bufferOfThread;
+		inline static thread_local bool bufferOfThreadIsInUse = false;
+
+		bool bufferIsOwnedByThread;
+		std::string ownBuffer;
+		std::string& buffer;
+		int depth = 0;
+		bool valueWasWrittenAtDepth[MAXIMUM_DEPTH + 1] = {};
+		bool keyWasJustWritten = false;
+
+		void prepareForValue() {
+			if (keyWasJustWritten) {
+				keyWasJustWritten = false;
+				return;
+			}
+			if (depth > 0) {
+				if (valueWasWrittenAtDepth[depth]) {
+					buffer += ',';
+				}
+				valueWasWrittenAtDepth[depth] = true;
+			}
+		}
+
+		JsonWriter& open(char bracket) {
+			prepareForValue();
+			if (depth == MAXIMUM_DEPTH) {
+				throw std::runtime_error("JSON is nested more deeply than " + std::to_string(MAXIMUM_DEPTH) + " levels.");
+			}
+			buffer += bracket;
+			valueWasWrittenAtDepth[++depth] = false;
+			return *this;
+		}
+
+		JsonWriter& close(char bracket) {
+			if (depth == 0) {
+				throw std::runtime_error("JSON writer closed more objects or arrays than it opened.");
+			}
+			--depth;
+			buffer += bracket;
+			return *this;
+		}
+
+		template<typename T>
+		JsonWriter& appendNumber(T number) {
+			prepareForValue();
+			char digits[32];
+			std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+			buffer.append(digits, result.ptr);
+			return *this;
+		}
+
+		void appendQuotedString(std::string_view string) {
+			static constexpr char HEXADECIMAL_DIGITS[] = "0123456789abcdef";
+			buffer += '"';
+			size_t startOfRun = 0;
+			for (size_t i = 0; i < string.size(); i++) {
+				unsigned char character = static_cast<unsigned char>(string[i]);
+				if (character >= 0x20 && character != '"' && character != '\\') {
+					continue;
+				}
+				buffer.append(string.data() + startOfRun, i - startOfRun);
+				startOfRun = i + 1;
+				switch (character) {
+				case '"': buffer += "\\\""; break;
+				case '\\': buffer += "\\\\"; break;
+				case '\n': buffer += "\\n"; break;
+				case '\r': buffer += "\\r"; break;
+				case '\t': buffer += "\\t"; break;
+				case '\b': buffer += "\\b"; break;
+				case '\f': buffer += "\\f"; break;
+				default:
+					buffer += "\\u00";
+					buffer += HEXADECIMAL_DIGITS[character >> 4];
+					buffer += HEXADECIMAL_DIGITS[character & 0xF];
+					break;
+				}
+			}
+			buffer.append(string.data() + startOfRun, string.size() - startOfRun);
+			buffer += '"';
+		}
+	};
+
+}
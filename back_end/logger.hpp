@@ -1,34 +1,362 @@
 #pragma once
 
 
+#include <atomic>
 #include <chrono>
-#include <cmath>
-#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <format>
+#include "json_writer.hpp"
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <thread>
 
 
+/* Namespace `Logger` writes records asynchronously.
+* A caller formats its message, stamps the record with the time, and pushes it into a lock free ring; a background thread
+* pops records in batches, formats them as text or as JSON lines, and writes each batch to standard error with one write and one flush.
+* Callers never wait for I/O. If the ring is full, the record is dropped and counted, and the writer reports the number dropped.
+* Errors are the exception: they wait for a free slot instead of being dropped, and then until they are written,
+* so that neither a burst of other records nor the process exiting just afterwards loses an error.
+*
+* Records below the minimum level are filtered with one branch. Defining `LOGGER_MINIMUM_LEVEL` as 0, 1, 2, or 3 removes
+* records of debug, info, warning, or error below that level at compile time. Callers that build expensive messages in hot loops
+* should check `isEnabled` first, so that a filtered message is never built.
+*/
 namespace Logger {
 
-	std::string currentTime() {
-		std::chrono::system_clock::time_point timePoint = std::chrono::system_clock::now();
-		auto now = std::chrono::time_point_cast<std::chrono::seconds>(timePoint);
-		return std::format("{:%Y-%m-%d %H:%M:%S}", now);
+	enum class Level {
+		Debug,
+		Info,
+		Warning,
+		Error
+	};
+
+	enum class Format {
+		Text,
+		JsonLines
+	};
+
+#ifndef LOGGER_MINIMUM_LEVEL
+#define LOGGER_MINIMUM_LEVEL 0
+#endif
+
+	constexpr Level MINIMUM_LEVEL_OF_BUILD = static_cast<Level>(LOGGER_MINIMUM_LEVEL);
+
+	namespace Detail {
+
+		constexpr size_t CAPACITY_OF_RING = 8192;
+		constexpr size_t MAXIMUM_NUMBER_OF_RECORDS_PER_BATCH = 1024;
+		constexpr std::chrono::milliseconds INTERVAL_OF_POLLING{ 10 };
+		constexpr size_t SIZE_OF_CACHE_LINE = 64;
+
+		inline std::atomic<Level> minimumLevel{ Level::Info };
+		inline std::atomic<Format> format{ Format::Text };
+
+		struct Record {
+			Level level = Level::Info;
+			std::chrono::system_clock::time_point time;
+			std::string context;
+			std::string message;
+		};
+
+		/* Class `RingOfRecords` is a bounded queue of records for many producers and one consumer.
+		* Each slot holds a sequence number that tells producers whether the slot is free and the consumer whether it is full,
+		* so pushing is one compare and swap of the position of enqueueing and popping takes no atomic read modify write.
+		*/
+		class RingOfRecords {
+		public:
+			RingOfRecords() :
+				arrayOfSlots(std::make_unique<Slot[]>(CAPACITY_OF_RING))
+			{
+				static_assert((CAPACITY_OF_RING & (CAPACITY_OF_RING - 1)) == 0, "The capacity of the ring must be a power of 2.");
+				for (size_t i = 0; i < CAPACITY_OF_RING; i++) {
+					arrayOfSlots[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			// Method `tryPush` moves a record into the ring and returns false without waiting if the ring is full.
+			bool tryPush(Record& record) {
+				uint64_t position = positionOfEnqueueing.load(std::memory_order_relaxed);
+				while (true) {
+					Slot& slot = arrayOfSlots[position & (CAPACITY_OF_RING - 1)];
+					const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+					const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+					if (difference == 0) {
+						if (positionOfEnqueueing.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+							slot.record = std::move(record);
+							slot.sequence.store(position + 1, std::memory_order_release);
+							return true;
+						}
+					}
+					else if (difference < 0) {
+						return false;
+					}
+					else {
+						position = positionOfEnqueueing.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			// Method `tryPop` moves the oldest record out of the ring and returns false if no record is ready. Only the writer calls it.
+			bool tryPop(Record& record) {
+				Slot& slot = arrayOfSlots[positionOfDequeueing & (CAPACITY_OF_RING - 1)];
+				if (slot.sequence.load(std::memory_order_acquire) != positionOfDequeueing + 1) {
+					return false;
+				}
+				record = std::move(slot.record);
+				slot.sequence.store(positionOfDequeueing + CAPACITY_OF_RING, std::memory_order_release);
+				positionOfDequeueing++;
+				return true;
+			}
+
+			uint64_t getPositionOfEnqueueing() const {
+				return positionOfEnqueueing.load(std::memory_order_acquire);
+			}
+
+		private:
+			struct alignas(SIZE_OF_CACHE_LINE) Slot {
+				std::atomic<uint64_t> sequence{ 0 };
+				Record record;
+			};
+
+			std::unique_ptr<Slot[]> arrayOfSlots;
+			alignas(SIZE_OF_CACHE_LINE) std::atomic<uint64_t> positionOfEnqueueing{ 0 };
+			alignas(SIZE_OF_CACHE_LINE) uint64_t positionOfDequeueing = 0;
+		};
+
+		std::string_view getNameOfLevel(Level level) {
+			switch (level) {
+			case Level::Debug:
+				return "DEBUG";
+			case Level::Info:
+				return "INFO";
+			case Level::Warning:
+				return "WARNING";
+			default:
+				return "ERROR";
+			}
+		}
+
+		/* Class `Writer` owns the ring and the thread that drains it.
+		* The time is formatted once per second and reused for every record stamped within that second.
+		*/
+		class Writer {
+		public:
+
+			static Writer& getInstance() {
+				static Writer writer;
+				return writer;
+			}
+
+			Writer(const Writer&) = delete;
+			Writer& operator=(const Writer&) = delete;
+
+			~Writer() {
+				threadOfWriting.request_stop();
+				threadOfWriting.join();
+			}
+
+			/* Method `push` moves a record into the ring. A record is dropped and counted if the ring is full,
+			* except that an error waits for the writer to free a slot, unless the writer is stopping and will free none.
+			*/
+			void push(Record& record) {
+				while (!ringOfRecords.tryPush(record)) {
+					if (record.level != Level::Error || threadOfWriting.get_stop_token().stop_requested()) {
+						numberOfDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			// Method `flush` waits until every record pushed before the call has been written.
+			void flush() {
+				const uint64_t numberOfRecordsPushed = ringOfRecords.getPositionOfEnqueueing();
+				while (numberOfRecordsWritten.load(std::memory_order_acquire) < numberOfRecordsPushed && threadOfWriting.joinable()) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+		private:
+			RingOfRecords ringOfRecords;
+			std::atomic<uint64_t> numberOfDroppedRecords{ 0 };
+			std::atomic<uint64_t> numberOfRecordsWritten{ 0 };
+			std::chrono::sys_seconds secondOfCachedTime{};
+			std::string cachedTime;
+			std::string batch;
+			std::jthread threadOfWriting;
+
+			Writer() :
+				threadOfWriting([this](std::stop_token stopToken) { run(stopToken); })
+			{
+				// Do nothing.
+			}
+
+			void run(std::stop_token stopToken) {
+				while (!stopToken.stop_requested()) {
+					if (writeBatch() == 0) {
+						std::this_thread::sleep_for(INTERVAL_OF_POLLING);
+					}
+				}
+				while (writeBatch() > 0) {
+					// Drain records pushed before the writer was stopped.
+				}
+			}
+
+			// Method `writeBatch` writes up to `MAXIMUM_NUMBER_OF_RECORDS_PER_BATCH` records and returns the number written.
+			size_t writeBatch() {
+				batch.clear();
+				size_t numberOfRecordsInBatch = 0;
+				Record record;
+				while (numberOfRecordsInBatch < MAXIMUM_NUMBER_OF_RECORDS_PER_BATCH && ringOfRecords.tryPop(record)) {
+					append(record);
+					numberOfRecordsInBatch++;
+				}
+				const uint64_t numberOfDroppedRecordsSinceLastBatch = numberOfDroppedRecords.exchange(0, std::memory_order_relaxed);
+				if (numberOfDroppedRecordsSinceLastBatch > 0) {
+					Record recordOfDrops{
+						Level::Warning,
+						std::chrono::system_clock::now(),
+						"Logger",
+						std::to_string(numberOfDroppedRecordsSinceLastBatch) + " records were dropped because the ring of records was full."
+					};
+					append(recordOfDrops);
+				}
+				if (!batch.empty()) {
+					std::fwrite(batch.data(), 1, batch.size(), stderr);
+					std::fflush(stderr);
+				}
+				numberOfRecordsWritten.fetch_add(numberOfRecordsInBatch, std::memory_order_release);
+				return numberOfRecordsInBatch;
+			}
+
+			const std::string& formatTime(std::chrono::system_clock::time_point time) {
+				std::chrono::sys_seconds second = std::chrono::time_point_cast<std::chrono::seconds>(time);
+				if (cachedTime.empty() || second != secondOfCachedTime) {
+					secondOfCachedTime = second;
+					cachedTime = std::format("{:%Y-%m-%d %H:%M:%S}", second);
+				}
+				return cachedTime;
+			}
+
+			/* Method `append` appends a record to the batch.
+			* As text, a record is `[LEVEL][time][context] message`, or `[LEVEL][time]message` without a context.
+			* As a JSON line, a record is an object with keys "time", "level", "context" if any, and "message".
+			*/
+			void append(const Record& record) {
+				const std::string& time = formatTime(record.time);
+				if (format.load(std::memory_order_relaxed) == Format::JsonLines) {
+					Json::JsonWriter writer;
+					writer.beginObject();
+					writer.key("time").value(time);
+					writer.key("level").value(getNameOfLevel(record.level));
+					if (!record.context.empty()) {
+						writer.key("context").value(record.context);
+					}
+					writer.key("message").value(record.message);
+					writer.endObject();
+					batch += writer.getBuffer();
+				}
+				else {
+					batch += '[';
+					batch += getNameOfLevel(record.level);
+					batch += "][";
+					batch += time;
+					batch += ']';
+					if (!record.context.empty()) {
+						batch += '[';
+						batch += record.context;
+						batch += "] ";
+					}
+					batch += record.message;
+				}
+				batch += '\n';
+			}
+		};
 	}
 
-	void error(const std::string& context, const std::exception& e) {
-		std::cerr << "[ERROR][" << currentTime() << "][" << context << "] " << e.what() << std::endl;
+	// Function `isEnabled` returns whether records of a level are written, which costs one relaxed load and one branch.
+	bool isEnabled(Level level) {
+		if constexpr (MINIMUM_LEVEL_OF_BUILD > Level::Debug) {
+			if (level < MINIMUM_LEVEL_OF_BUILD) {
+				return false;
+			}
+		}
+		return level >= Detail::minimumLevel.load(std::memory_order_relaxed);
 	}
 
-	void error(const std::string& context, const std::string& message) {
-		std::cerr << "[ERROR][" << currentTime() << "][" << context << "] " << message << std::endl;
+	void setMinimumLevel(Level level) {
+		Detail::minimumLevel.store(level, std::memory_order_relaxed);
 	}
 
-	void warn(const std::string& context, const std::string& message) {
-		std::cerr << "[WARNING][" << currentTime() << "][" << context << "] " << message << std::endl;
+	void setFormat(Format formatToUse) {
+		Detail::format.store(formatToUse, std::memory_order_relaxed);
+	}
+
+	// Function `levelFromString` converts "debug", "info", "warning", or "error" into a level.
+	Level levelFromString(const std::string& nameOfLevel) {
+		if (nameOfLevel == "debug") {
+			return Level::Debug;
+		}
+		if (nameOfLevel == "info") {
+			return Level::Info;
+		}
+		if (nameOfLevel == "warning") {
+			return Level::Warning;
+		}
+		if (nameOfLevel == "error") {
+			return Level::Error;
+		}
+		throw std::invalid_argument("Level of logging " + nameOfLevel + " is not known.");
+	}
+
+	// Function `formatFromString` converts "text" or "jsonLines" into a format.
+	Format formatFromString(const std::string& nameOfFormat) {
+		if (nameOfFormat == "text") {
+			return Format::Text;
+		}
+		if (nameOfFormat == "jsonLines") {
+			return Format::JsonLines;
+		}
+		throw std::invalid_argument("Format of logging " + nameOfFormat + " is not known.");
+	}
+
+	// Function `flush` waits until every record logged before the call has been written.
+	void flush() {
+		Detail::Writer::getInstance().flush();
+	}
+
+	void log(Level level, std::string context, std::string message) {
+		if (!isEnabled(level)) {
+			return;
+		}
+		Detail::Record record{ level, std::chrono::system_clock::now(), std::move(context), std::move(message) };
+		Detail::Writer::getInstance().push(record);
+	}
+
+	void debug(const std::string& message) {
+		log(Level::Debug, "", message);
 	}
 
 	void info(const std::string& message) {
-		std::clog << "[INFO][" << currentTime() << "]" << message << std::endl;
+		log(Level::Info, "", message);
+	}
+
+	void warn(const std::string& context, const std::string& message) {
+		log(Level::Warning, context, message);
+	}
+
+	void error(const std::string& context, const std::string& message) {
+		log(Level::Error, context, message);
+		flush();
+	}
+
+	void error(const std::string& context, const std::exception& e) {
+		error(context, std::string(e.what()));
 	}
 
-}
\ No newline at end of file
+}
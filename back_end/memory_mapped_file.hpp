@@ -0,0 +1,165 @@
+#pragma once
+
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/* Class `MemoryMappedFile` maps an entire file into memory for reading.
+* Pages are loaded by the operating system when they are first read, so large files can be read at random
+* without loading them into memory. The mapping covers the size of the file when it was opened;
+* a file that grows afterward must be mapped again to read the new bytes.
+*/
+class MemoryMappedFile {
+public:
+
+	MemoryMappedFile() = default;
+
+	explicit MemoryMappedFile(const std::string& path) {
+#ifdef _WIN32
+		handleOfFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handleOfFile == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("File " + path + " could not be opened for mapping.");
+		}
+		LARGE_INTEGER sizeOfFile;
+		if (!GetFileSizeEx(handleOfFile, &sizeOfFile)) {
+			close();
+			throw std::runtime_error("Size of file " + path + " could not be determined.");
+		}
+		size = static_cast<size_t>(sizeOfFile.QuadPart);
+		if (size == 0) {
+			return;
+		}
+		handleOfMapping = CreateFileMappingA(handleOfFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (handleOfMapping == nullptr) {
+			close();
+			throw std::runtime_error("File " + path + " could not be mapped.");
+		}
+		data = static_cast<const unsigned char*>(MapViewOfFile(handleOfMapping, FILE_MAP_READ, 0, 0, 0));
+		if (data == nullptr) {
+			close();
+			throw std::runtime_error("A view of file " + path + " could not be mapped.");
+		}
+#else
+		fileDescriptor = ::open(path.c_str(), O_RDONLY);
+		if (fileDescriptor < 0) {
+			throw std::runtime_error("File " + path + " could not be opened for mapping.");
+		}
+		struct stat status;
+		if (::fstat(fileDescriptor, &status) != 0) {
+			close();
+			throw std::runtime_error("Size of file " + path + " could not be determined.");
+		}
+		size = static_cast<size_t>(status.st_size);
+		if (size == 0) {
+			return;
+		}
+		void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+		if (address == MAP_FAILED) {
+			close();
+			throw std::runtime_error("File " + path + " could not be mapped.");
+		}
+		data = static_cast<const unsigned char*>(address);
+		::madvise(address, size, MADV_RANDOM);
+#endif
+	}
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+	MemoryMappedFile(MemoryMappedFile&& other) noexcept {
+		swap(other);
+	}
+
+	MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept {
+		if (this != &other) {
+			close();
+			swap(other);
+		}
+		return *this;
+	}
+
+	~MemoryMappedFile() {
+		close();
+	}
+
+	const unsigned char* getData() const {
+		return data;
+	}
+
+	size_t getSize() const {
+		return size;
+	}
+
+	bool isOpen() const {
+#ifdef _WIN32
+		return handleOfFile != INVALID_HANDLE_VALUE;
+#else
+		return fileDescriptor >= 0;
+#endif
+	}
+
+	void close() {
+#ifdef _WIN32
+		if (data != nullptr) {
+			UnmapViewOfFile(data);
+		}
+		if (handleOfMapping != nullptr) {
+			CloseHandle(handleOfMapping);
+		}
+		if (handleOfFile != INVALID_HANDLE_VALUE) {
+			CloseHandle(handleOfFile);
+		}
+		handleOfMapping = nullptr;
+		handleOfFile = INVALID_HANDLE_VALUE;
+#else
+		if (data != nullptr) {
+			::munmap(const_cast<unsigned char*>(data), size);
+		}
+		if (fileDescriptor >= 0) {
+			::close(fileDescriptor);
+		}
+		fileDescriptor = -1;
+#endif
+		data = nullptr;
+		size = 0;
+	}
+
+private:
+	const unsigned char* data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	HANDLE handleOfFile = INVALID_HANDLE_VALUE;
+	HANDLE handleOfMapping = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+
+	void swap(MemoryMappedFile& other) noexcept {
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+#ifdef _WIN32
+		std::swap(handleOfFile, other.handleOfFile);
+		std::swap(handleOfMapping, other.handleOfMapping);
+#else
+		std::swap(fileDescriptor, other.fileDescriptor);
+#endif
+	}
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/* Namespace `Metrics` provides counters, gauges, and histograms that are cheap enough to record in hot paths, and
+* a registry that renders them in the text exposition format of Prometheus for route `/metrics`.
+* Counters and histograms are sharded: each thread adds to the shard of its index with a relaxed atomic addition on its own cache line, and
+* shards are summed only when metrics are rendered. Recording never takes a lock or allocates.
+* A metric is looked up by name and labels once, under the lock of the registry, and callers keep the returned reference.
+*/
+namespace Metrics {
+
+	constexpr size_t NUMBER_OF_SHARDS = 16;
+	constexpr size_t SIZE_OF_CACHE_LINE = 64;
+
+	namespace Detail {
+		inline std::atomic<size_t> indexOfNextThread{ 0 };
+
+		// Function `getIndexOfShard` returns the shard of the calling thread, which is assigned in the order in which threads first record.
+		size_t getIndexOfShard() {
+			thread_local size_t indexOfShard = indexOfNextThread.fetch_add(1, std::memory_order_relaxed) % NUMBER_OF_SHARDS;
+			return indexOfShard;
+		}
+
+		struct alignas(SIZE_OF_CACHE_LINE) ShardOfCounter {
+			std::atomic<uint64_t> value{ 0 };
+		};
+
+		// Function `formatNumber` formats a number in its shortest exact form, with "+Inf" for infinity as Prometheus expects.
+		std::string formatNumber(double number) {
+			if (number == std::numeric_limits<double>::infinity()) {
+				return "+Inf";
+			}
+			char buffer[32];
+			std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+			return std::string(buffer, result.ptr);
+		}
+	}
+
+	// Type `Labels` is a vector of pairs of names and values of labels, such as { { "route", "/state" } }.
+	using Labels = std::vector<std::pair<std::string, std::string>>;
+
+	// Class `Counter` counts events, such as simulations of MCTS or requests, and only increases.
+	class Counter {
+	public:
+		void increment(uint64_t amount = 1) {
+			arrayOfShards[Detail::getIndexOfShard()].value.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		uint64_t getValue() const {
+			uint64_t value = 0;
+			for (const Detail::ShardOfCounter& shard : arrayOfShards) {
+				value += shard.value.load(std::memory_order_relaxed);
+			}
+			return value;
+		}
+
+	private:
+		std::array<Detail::ShardOfCounter, NUMBER_OF_SHARDS> arrayOfShards;
+	};
+
+	// Class `Gauge` holds the last value set, such as the loss of the latest epoch of training.
+	class Gauge {
+	public:
+		void set(double value) {
+			bitsOfValue.store(std::bit_cast<uint64_t>(value), std::memory_order_relaxed);
+		}
+
+		double getValue() const {
+			return std::bit_cast<double>(bitsOfValue.load(std::memory_order_relaxed));
+		}
+
+	private:
+		std::atomic<uint64_t> bitsOfValue{ std::bit_cast<uint64_t>(0.0) };
+	};
+
+	/* Class `Histogram` counts observations, such as latencies in seconds or sizes of batches, in buckets with fixed upper bounds.
+	* Each shard holds a count per bucket and a sum of observations. Recording is a search of at most a few upper bounds and 2 relaxed atomic additions.
+	*/
+	class Histogram {
+	public:
+		explicit Histogram(const std::vector<double>& vectorOfUpperBoundsToUse) :
+			vectorOfUpperBounds(vectorOfUpperBoundsToUse),
+			arrayOfShards()
+		{
+			if (vectorOfUpperBounds.empty() || !std::is_sorted(vectorOfUpperBounds.begin(), vectorOfUpperBounds.end())) {
+				throw std::invalid_argument("A histogram requires sorted upper bounds of buckets.");
+			}
+			for (std::unique_ptr<Shard>& shard : arrayOfShards) {
+				shard = std::make_unique<Shard>(vectorOfUpperBounds.size() + 1);
+			}
+		}
+
+		void observe(double value) {
+			const size_t indexOfBucket = std::lower_bound(vectorOfUpperBounds.begin(), vectorOfUpperBounds.end(), value) - vectorOfUpperBounds.begin();
+			Shard& shard = *arrayOfShards[Detail::getIndexOfShard()];
+			shard.arrayOfCounts[indexOfBucket].fetch_add(1, std::memory_order_relaxed);
+			shard.sum.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		const std::vector<double>& getUpperBounds() const {
+			return vectorOfUpperBounds;
+		}
+
+		// Method `getCounts` returns the number of observations in each bucket, where the last bucket holds observations above every upper bound.
+		std::vector<uint64_t> getCounts() const {
+			std::vector<uint64_t> vectorOfCounts(vectorOfUpperBounds.size() + 1, 0);
+			for (const std::unique_ptr<Shard>& shard : arrayOfShards) {
+				for (size_t i = 0; i < vectorOfCounts.size(); i++) {
+					vectorOfCounts[i] += shard->arrayOfCounts[i].load(std::memory_order_relaxed);
+				}
+			}
+			return vectorOfCounts;
+		}
+
+		double getSum() const {
+			double sum = 0.0;
+			for (const std::unique_ptr<Shard>& shard : arrayOfShards) {
+				sum += shard->sum.load(std::memory_order_relaxed);
+			}
+			return sum;
+		}
+
+	private:
+		struct alignas(SIZE_OF_CACHE_LINE) Shard {
+			explicit Shard(size_t numberOfBuckets) :
+				arrayOfCounts(std::make_unique<std::atomic<uint64_t>[]>(numberOfBuckets))
+			{
+				// Do nothing.
+			}
+
+			std::unique_ptr<std::atomic<uint64_t>[]> arrayOfCounts;
+			std::atomic<double> sum{ 0.0 };
+		};
+
+		std::vector<double> vectorOfUpperBounds;
+		std::array<std::unique_ptr<Shard>, NUMBER_OF_SHARDS> arrayOfShards;
+	};
+
+	// Function `createExponentialBuckets` returns `numberOfBuckets` upper bounds starting at `start` and multiplied by `factor`.
+	std::vector<double> createExponentialBuckets(double start, double factor, int numberOfBuckets) {
+		std::vector<double> vectorOfUpperBounds;
+		double upperBound = start;
+		for (int i = 0; i < numberOfBuckets; i++) {
+			vectorOfUpperBounds.push_back(upperBound);
+			upperBound *= factor;
+		}
+		return vectorOfUpperBounds;
+	}
+
+	// Upper bounds of buckets of latencies in seconds, from 50 microseconds to about 26 seconds.
+	inline const std::vector<double> BUCKETS_OF_LATENCIES = createExponentialBuckets(0.00005, 2.0, 20);
+
+	/* Class `Registry` owns every metric and renders them. Metrics with the same name share a help text and a type and
+	* differ by labels. References returned by the registry remain valid for the life of the process.
+	*/
+	class Registry {
+	public:
+
+		static Registry& getInstance() {
+			static Registry registry;
+			return registry;
+		}
+
+		Counter& getCounter(const std::string& name, const std::string& help, const Labels& labels = {}) {
+			return getMetric<Counter>(name, help, "counter", labels, mapOfFamiliesOfCounters, [] { return std::make_unique<Counter>(); });
+		}
+
+		Gauge& getGauge(const std::string& name, const std::string& help, const Labels& labels = {}) {
+			return getMetric<Gauge>(name, help, "gauge", labels, mapOfFamiliesOfGauges, [] { return std::make_unique<Gauge>(); });
+		}
+
+		Histogram& getHistogram(const std::string& name, const std::string& help, const std::vector<double>& vectorOfUpperBounds, const Labels& labels = {}) {
+			return getMetric<Histogram>(name, help, "histogram", labels, mapOfFamiliesOfHistograms, [&] { return std::make_unique<Histogram>(vectorOfUpperBounds); });
+		}
+
+		// Method `render` renders every metric in the text exposition format of Prometheus, version 0.0.4.
+		std::string render() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			std::string text;
+			for (const auto& [name, family] : mapOfFamiliesOfCounters) {
+				writeHeader(text, name, family);
+				for (const auto& [labels, counter] : family.mapOfLabelsAndMetrics) {
+					text += name + formatLabels(labels) + " " + std::to_string(counter->getValue()) + "\n";
+				}
+			}
+			for (const auto& [name, family] : mapOfFamiliesOfGauges) {
+				writeHeader(text, name, family);
+				for (const auto& [labels, gauge] : family.mapOfLabelsAndMetrics) {
+					text += name + formatLabels(labels) + " " + Detail::formatNumber(gauge->getValue()) + "\n";
+				}
+			}
+			for (const auto& [name, family] : mapOfFamiliesOfHistograms) {
+				writeHeader(text, name, family);
+				for (const auto& [labels, histogram] : family.mapOfLabelsAndMetrics) {
+					const std::vector<double>& vectorOfUpperBounds = histogram->getUpperBounds();
+					std::vector<uint64_t> vectorOfCounts = histogram->getCounts();
+					uint64_t cumulativeCount = 0;
+					for (size_t i = 0; i < vectorOfCounts.size(); i++) {
+						cumulativeCount += vectorOfCounts[i];
+						Labels labelsOfBucket = labels;
+						labelsOfBucket.emplace_back("le", Detail::formatNumber(i < vectorOfUpperBounds.size() ? vectorOfUpperBounds[i] : std::numeric_limits<double>::infinity()));
+						text += name + "_bucket" + formatLabels(labelsOfBucket) + " " + std::to_string(cumulativeCount) + "\n";
+					}
+					text += name + "_sum" + formatLabels(labels) + " " + Detail::formatNumber(histogram->getSum()) + "\n";
+					text += name + "_count" + formatLabels(labels) + " " + std::to_string(cumulativeCount) + "\n";
+				}
+			}
+			return text;
+		}
+
+	private:
+
+		template <typename Metric>
+		struct Family {
+			std::string help;
+			std::string type;
+			std::map<Labels, std::unique_ptr<Metric>> mapOfLabelsAndMetrics;
+		};
+
+		mutable std::mutex mutex;
+		std::map<std::string, Family<Counter>> mapOfFamiliesOfCounters;
+		std::map<std::string, Family<Gauge>> mapOfFamiliesOfGauges;
+		std::map<std::string, Family<Histogram>> mapOfFamiliesOfHistograms;
+
+		Registry() = default;
+
+		template <typename Metric, typename Factory>
+		Metric& getMetric(
+			const std::string& name,
+			const std::string& help,
+			const std::string& type,
+			const Labels& labels,
+			std::map<std::string, Family<Metric>>& mapOfFamilies,
+			Factory createMetric
+		) {
+			std::lock_guard<std::mutex> lock(mutex);
+			Family<Metric>& family = mapOfFamilies[name];
+			if (family.type.empty()) {
+				family.help = help;
+				family.type = type;
+			}
+			std::unique_ptr<Metric>& metric = family.mapOfLabelsAndMetrics[labels];
+			if (!metric) {
+				metric = createMetric();
+			}
+			return *metric;
+		}
+
+		template <typename Metric>
+		static void writeHeader(std::string& text, const std::string& name, const Family<Metric>& family) {
+			text += "# HELP " + name + " " + family.help + "\n";
+			text += "# TYPE " + name + " " + family.type + "\n";
+		}
+
+		// Function `formatLabels` formats labels as `{name="value",...}`, escaping backslashes, quotes, and newlines in values.
+		static std::string formatLabels(const Labels& labels) {
+			if (labels.empty()) {
+				return "";
+			}
+			std::string text = "{";
+			for (size_t i = 0; i < labels.size(); i++) {
+				if (i > 0) {
+					text += ',';
+				}
+				text += labels[i].first + "=\"";
+				for (char character : labels[i].second) {
+					if (character == '\\' || character == '"') {
+						text += '\\';
+						text += character;
+					}
+					else if (character == '\n') {
+						text += "\\n";
+					}
+					else {
+						text += character;
+					}
+				}
+				text += '"';
+			}
+			text += '}';
+			return text;
+		}
+	};
+
+	/* Class `ScopedTimer` observes the seconds from its construction to its destruction in a histogram.
+	* Reading the steady clock twice costs tens of nanoseconds, so timers belong around work of microseconds or more.
+	*/
+	class ScopedTimer {
+	public:
+		explicit ScopedTimer(Histogram& histogramToUse) :
+			histogram(histogramToUse),
+			timeOfStart(std::chrono::steady_clock::now())
+		{
+			// Do nothing.
+		}
+
+		~ScopedTimer() {
+			histogram.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - timeOfStart).count());
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		Histogram& histogram;
+		std::chrono::steady_clock::time_point timeOfStart;
+	};
+
+}
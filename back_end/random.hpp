@@ -0,0 +1,174 @@
+#pragma once
+
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+
+/* Namespace `Random` provides the generators of random numbers of the back end.
+* One seed, set from key "seed" of `config.json`, determines every stream, so that self play, the arena, training, and benchmarks are reproducible.
+* A stream is identified by a purpose and an index, such as the index of a game of self play, and
+* streams of different purposes or indices are statistically independent.
+* Generators are xoshiro256++, which is seeded with SplitMix64 and needs no system calls after the seed is set.
+*/
+namespace Random {
+
+	// Function `splitMix64` advances a SplitMix64 state and returns its next output, which is used to seed and to derive streams.
+	uint64_t splitMix64(uint64_t& state) {
+		uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	/* Class `Xoshiro256PlusPlus` is a generator of 64 bit random numbers with a period of 2^256 - 1 that
+	* satisfies the requirements of a uniform random bit generator, so that it can be used with distributions and `std::shuffle`.
+	* Method `split` returns a generator whose sequence does not overlap this generator's for 2^128 outputs.
+	*/
+	class Xoshiro256PlusPlus {
+	public:
+		using result_type = uint64_t;
+
+		explicit Xoshiro256PlusPlus(uint64_t seed = 0) {
+			uint64_t stateOfSplitMix64 = seed;
+			for (uint64_t& word : state) {
+				word = splitMix64(stateOfSplitMix64);
+			}
+		}
+
+		static constexpr result_type min() {
+			return std::numeric_limits<result_type>::min();
+		}
+
+		static constexpr result_type max() {
+			return std::numeric_limits<result_type>::max();
+		}
+
+		result_type operator()() {
+			const uint64_t result = std::rotl(state[0] + state[3], 23) + state[0];
+			const uint64_t t = state[1] << 17;
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = std::rotl(state[3], 45);
+			return result;
+		}
+
+		// Method `jump` advances this generator by 2^128 outputs.
+		void jump() {
+			constexpr uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+			uint64_t s0 = 0;
+			uint64_t s1 = 0;
+			uint64_t s2 = 0;
+			uint64_t s3 = 0;
+			for (uint64_t word : JUMP) {
+				for (int b = 0; b < 64; b++) {
+					if (word & (1ULL << b)) {
+						s0 ^= state[0];
+						s1 ^= state[1];
+						s2 ^= state[2];
+						s3 ^= state[3];
+					}
+					(*this)();
+				}
+			}
+			state[0] = s0;
+			state[1] = s1;
+			state[2] = s2;
+			state[3] = s3;
+		}
+
+		Xoshiro256PlusPlus split() {
+			Xoshiro256PlusPlus generator = *this;
+			jump();
+			return generator;
+		}
+
+	private:
+		uint64_t state[4];
+	};
+
+	// Enumeration `Purpose` separates streams used for different parts of the back end.
+	enum class Purpose : uint64_t {
+		Thread = 1,
+		SelfPlay = 2,
+		Arena = 3,
+		Training = 4,
+		ReplayBuffer = 5
+	};
+
+	namespace Detail {
+		inline std::atomic<uint64_t> seed{ 0 };
+		inline std::atomic<uint64_t> indexOfNextThread{ 0 };
+	}
+
+	// Function `setSeed` sets the seed of all streams. It should be called once at start up, before any stream is created.
+	void setSeed(uint64_t seed) {
+		Detail::seed.store(seed, std::memory_order_relaxed);
+	}
+
+	uint64_t getSeed() {
+		return Detail::seed.load(std::memory_order_relaxed);
+	}
+
+	// Function `deriveSeed` mixes a seed, a purpose, and an index into the seed of a stream.
+	uint64_t deriveSeed(uint64_t seed, Purpose purpose, uint64_t index) {
+		uint64_t state = seed ^ (static_cast<uint64_t>(purpose) * 0xd1b54a32d192ed03ULL);
+		uint64_t mixedSeedAndPurpose = splitMix64(state);
+		state = mixedSeedAndPurpose ^ index;
+		return splitMix64(state);
+	}
+
+	// Function `createStream` creates the generator of the stream of a purpose and an index under the seed set with `setSeed`.
+	Xoshiro256PlusPlus createStream(Purpose purpose, uint64_t index) {
+		return Xoshiro256PlusPlus(deriveSeed(getSeed(), purpose, index));
+	}
+
+	namespace Detail {
+		Xoshiro256PlusPlus& getStorageOfGeneratorOfThread() {
+			thread_local Xoshiro256PlusPlus generatorOfThread = createStream(Purpose::Thread, indexOfNextThread.fetch_add(1, std::memory_order_relaxed));
+			return generatorOfThread;
+		}
+	}
+
+	/* Function `getGeneratorOfThread` returns the generator of the calling thread.
+	* A thread's generator is the stream of the order in which the thread first asked for it, unless a `ScopedStream` replaces it.
+	*/
+	Xoshiro256PlusPlus& getGeneratorOfThread() {
+		return Detail::getStorageOfGeneratorOfThread();
+	}
+
+	/* Class `ScopedStream` replaces the generator of the calling thread with a given stream until the scope ends, so that
+	* code that draws from the generator of its thread, such as rolling dice and injecting Dirichlet noise, is reproducible per game.
+	*/
+	class ScopedStream {
+	public:
+		explicit ScopedStream(const Xoshiro256PlusPlus& generator) :
+			previousGenerator(getGeneratorOfThread())
+		{
+			getGeneratorOfThread() = generator;
+		}
+
+		~ScopedStream() {
+			getGeneratorOfThread() = previousGenerator;
+		}
+
+		ScopedStream(const ScopedStream&) = delete;
+		ScopedStream& operator=(const ScopedStream&) = delete;
+
+	private:
+		Xoshiro256PlusPlus previousGenerator;
+	};
+
+	// Function `createSeedFromDevice` draws a seed from the random device, for runs that do not configure a seed.
+	uint64_t createSeedFromDevice() {
+		std::random_device randomDevice;
+		return (static_cast<uint64_t>(randomDevice()) << 32) ^ static_cast<uint64_t>(randomDevice());
+	}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+
+#include "cors_middleware.hpp"
+#include "crow.h"
+#include "metrics_middleware.hpp"
+
+
+namespace Server {
+
+    /* Type `App` is the application of the back end.
+    * Middlewares run before handlers in the order listed and after handlers in reverse order,
+    * so `MetricsMiddleware` times a request including the work of every other middleware.
+    */
+    using App = crow::App<MetricsMiddleware, CorsMiddleware>;
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+
+#include <cstdint>
+#include "../db/models.hpp"
+#include "../json_writer.hpp"
+#include "../game/labels.hpp"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+
+namespace Server {
+
+	constexpr uint8_t VERSION_OF_BINARY_FORMAT_OF_BOARD = 1;
+
+	/* Function `encodeBoardSnapshotAsJson` serializes a board snapshot as a JSON object with keys
+	* "cities", "settlements", "roads", and "walls", whose arrays match the responses of the endpoints of the same names,
+	* and keys "totalResources", "currentPlayer", and "phase".
+	*/
+	std::string encodeBoardSnapshotAsJson(const BoardSnapshot& boardSnapshot) {
+		Json::JsonWriter writer;
+		auto writeStructures = [&writer](const char* key, const char* keyOfLocation, const auto& vectorOfStructures) {
+			writer.key(key).beginArray();
+			for (const auto& structure : vectorOfStructures) {
+				writer.beginObject();
+				writer.key("id").value(structure.id);
+				writer.key("player").value(structure.player);
+				if constexpr (std::is_same_v<std::decay_t<decltype(structure)>, Road>) {
+					writer.key(keyOfLocation).value(structure.edge);
+				}
+				else {
+					writer.key(keyOfLocation).value(structure.vertex);
+				}
+				writer.endObject();
+			}
+			writer.endArray();
+		};
+		writer.beginObject();
+		writeStructures("cities", "vertex", boardSnapshot.cities);
+		writeStructures("settlements", "vertex", boardSnapshot.settlements);
+		writeStructures("roads", "edge", boardSnapshot.roads);
+		writeStructures("walls", "vertex", boardSnapshot.walls);
+		writer.key("totalResources");
+		writeResourceBagsOfPlayers(writer, boardSnapshot.resources);
+		writer.key("currentPlayer").value(boardSnapshot.currentPlayer);
+		writer.key("phase").value(Game::toString(boardSnapshot.phase));
+		writer.endObject();
+		return writer.str();
+	}
+
+	/* Function `encodeBoardSnapshotAsBinary` serializes a board snapshot into 176 little endian bytes.
+	* Identifiers of structures are omitted; structures are identified by player and location.
+	*
+	* bytes 0 to 3: "CTNB"
+	* byte 4: version of format
+	* byte 5: index of phase in enumeration `Game::Phase`
+	* byte 6: current player
+	* byte 7: number of players P (3)
+	* P blocks of 56 bytes, one per player in order:
+	*     8 bytes: mask of settlements, where bit i represents vertex i + 1
+	*     8 bytes: mask of cities
+	*     8 bytes: mask of walls
+	*     16 bytes: mask of roads, where bit i of the first 8 bytes represents edge i + 1 and bit i of the next 8 bytes represents edge i + 65
+	*     16 bytes: 8 signed 16 bit counts of brick, grain, lumber, ore, wool, cloth, coin, and paper
+	*/
+	std::string encodeBoardSnapshotAsBinary(const BoardSnapshot& boardSnapshot) {
+		constexpr int NUMBER_OF_PLAYERS = 3;
+		uint64_t masksOfSettlements[NUMBER_OF_PLAYERS + 1] = {};
+		uint64_t masksOfCities[NUMBER_OF_PLAYERS + 1] = {};
+		uint64_t masksOfWalls[NUMBER_OF_PLAYERS + 1] = {};
+		uint64_t masksOfRoads[NUMBER_OF_PLAYERS + 1][2] = {};
+		for (const Settlement& settlement : boardSnapshot.settlements) {
+			masksOfSettlements[settlement.player] |= uint64_t{ 1 } << Game::getIndexOfLabel(settlement.vertex, Game::NUMBER_OF_VERTICES);
+		}
+		for (const City& city : boardSnapshot.cities) {
+			masksOfCities[city.player] |= uint64_t{ 1 } << Game::getIndexOfLabel(city.vertex, Game::NUMBER_OF_VERTICES);
+		}
+		for (const Wall& wall : boardSnapshot.walls) {
+			masksOfWalls[wall.player] |= uint64_t{ 1 } << Game::getIndexOfLabel(wall.vertex, Game::NUMBER_OF_VERTICES);
+		}
+		for (const Road& road : boardSnapshot.roads) {
+			int indexOfEdge = Game::getIndexOfLabel(road.edge, Game::NUMBER_OF_EDGES);
+			masksOfRoads[road.player][indexOfEdge / 64] |= uint64_t{ 1 } << (indexOfEdge % 64);
+		}
+
+		std::string bytes;
+		bytes.reserve(8 + NUMBER_OF_PLAYERS * 56);
+		auto appendInteger = [&bytes](uint64_t integer, int numberOfBytes) {
+			for (int i = 0; i < numberOfBytes; i++) {
+				bytes.push_back(static_cast<char>((integer >> (8 * i)) & 0xFF));
+			}
+		};
+		bytes.append("CTNB");
+		appendInteger(VERSION_OF_BINARY_FORMAT_OF_BOARD, 1);
+		appendInteger(static_cast<uint64_t>(boardSnapshot.phase), 1);
+		appendInteger(static_cast<uint64_t>(boardSnapshot.currentPlayer), 1);
+		appendInteger(NUMBER_OF_PLAYERS, 1);
+		for (int player = 1; player <= NUMBER_OF_PLAYERS; ++player) {
+			appendInteger(masksOfSettlements[player], 8);
+			appendInteger(masksOfCities[player], 8);
+			appendInteger(masksOfWalls[player], 8);
+			appendInteger(masksOfRoads[player][0], 8);
+			appendInteger(masksOfRoads[player][1], 8);
+			const ResourceBag& bag = boardSnapshot.resources[player];
+			for (int count : { bag.brick, bag.grain, bag.lumber, bag.ore, bag.wool, bag.cloth, bag.coin, bag.paper }) {
+				appendInteger(static_cast<uint16_t>(static_cast<int16_t>(count)), 2);
+			}
+		}
+		return bytes;
+	}
+
+}
@@ -1,116 +1,58 @@
 #pragma once
 
 
-#include "../game/board.hpp"
 #include "crow.h"
 #include "../db/database.hpp"
+#include "../game/game_state.hpp"
+#include "../json_writer.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Server {
 
 
-	void buildNextMoves(DB::Database& liveDb, crow::json::wvalue& response) {
+	/* Function `buildNextMoves` determines the moves available to the next player, stores them as setting "lastPossibleNextMoves",
+	* and returns them as a JSON object with keys "player", "nextPlayerWillRollDice", "vertices", and "edges".
+	*/
+	std::string buildNextMoves(DB::Database& liveDb) {
 		GameState nextState = liveDb.getGameState();
 		const int nextPlayer = nextState.currentPlayer;
-		const Game::Phase nextPhase = nextState.phase;
-		Board board;
+		const bool nextPlayerWillRollDice = (nextState.phase == Game::Phase::RollDice);
 		std::unordered_map<std::string, std::vector<std::string>> unorderedMapOfLabelsOfVerticesAndMoveTypes;
 		std::vector<std::string> vectorOfLabelsOfEdges;
-		bool nextPlayerWillRollDice = false;
-		std::vector<std::string> vectorOfLabelsOfOccupiedVertices = board.getVectorOfLabelsOfOccupiedVertices(nextState);
-		std::vector<std::string> vectorOfLabelsOfOccupiedEdges = board.getVectorOfLabelsOfOccupiedEdges(nextState);
-		std::vector<std::string> vectorOfLabelsOfAvailableVertices = board.getVectorOfLabelsOfAvailableVertices(vectorOfLabelsOfOccupiedVertices);
-
-		if (nextPhase == Game::Phase::FirstSettlement) {
-			for (auto& labelOfAvailableVertex : vectorOfLabelsOfAvailableVertices) {
-				unorderedMapOfLabelsOfVerticesAndMoveTypes[labelOfAvailableVertex].push_back("settlement");
+		for (const Game::Move& legalMove : nextState.getVectorOfLegalMoves()) {
+			if (legalMove.type == "road") {
+				vectorOfLabelsOfEdges.push_back(legalMove.label);
 			}
-		}
-		else if (nextPhase == Game::Phase::FirstRoad) {
-			auto adjacentEdges = board.getVectorOfLabelsOfAvailableEdgesExtendingFromLastBuilding(nextState.lastBuilding, vectorOfLabelsOfOccupiedEdges);
-			vectorOfLabelsOfEdges.insert(vectorOfLabelsOfEdges.end(), adjacentEdges.begin(), adjacentEdges.end());
-		}
-		else if (nextPhase == Game::Phase::FirstCity) {
-			for (auto& labelOfAvailableVertex : vectorOfLabelsOfAvailableVertices) {
-				unorderedMapOfLabelsOfVerticesAndMoveTypes[labelOfAvailableVertex].push_back("city");
+			else if (legalMove.type != "pass") {
+				unorderedMapOfLabelsOfVerticesAndMoveTypes[legalMove.label].push_back(legalMove.type);
 			}
 		}
-		else if (nextPhase == Game::Phase::SecondRoad) {
-			auto adjacentEdges = board.getVectorOfLabelsOfAvailableEdgesExtendingFromLastBuilding(nextState.lastBuilding, vectorOfLabelsOfOccupiedEdges);
-			vectorOfLabelsOfEdges.insert(vectorOfLabelsOfEdges.end(), adjacentEdges.begin(), adjacentEdges.end());
-		}
-		else if (nextPhase == Game::Phase::RollDice) {
-			nextPlayerWillRollDice = true;
-		}
-		else if (nextPhase == Game::Phase::Turn) {
-			const ResourceBag& resources = nextState.resources[nextPlayer];
-			std::unordered_set<std::string> unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer;
-			std::vector<std::string>& vectorOfLabelsOfEdgesWithRoadsOfPlayer = nextState.roads.at(nextPlayer);
-			for (const std::string& labelOfEdge : vectorOfLabelsOfEdgesWithRoadsOfPlayer) {
-				auto [firstLabelOfVertex, secondLabelOfVertex] = board.getVerticesOfEdge(labelOfEdge);
-				unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.insert(firstLabelOfVertex);
-				unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.insert(secondLabelOfVertex);
-			}
-			for (std::string& labelOfAvailableVertex : vectorOfLabelsOfAvailableVertices) {
-				if (
-					unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(labelOfAvailableVertex) &&
-					resources.brick >= 1 &&
-					resources.grain >= 1 &&
-					resources.lumber >= 1 &&
-					resources.wool >= 1
-					) {
-					unorderedMapOfLabelsOfVerticesAndMoveTypes[labelOfAvailableVertex].push_back("settlement");
-				}
-			}
-			std::vector<std::string> vectorOfLabelsOfVerticesWithSettlementOfPlayer = nextState.settlements[nextPlayer];
-			for (std::string& labelOfVertex : vectorOfLabelsOfVerticesWithSettlementOfPlayer) {
-				if (resources.grain >= 2 && resources.ore >= 3) {
-					unorderedMapOfLabelsOfVerticesAndMoveTypes[labelOfVertex].push_back("city");
-				}
-			}
-			std::vector<std::string> vectorOfLabelsOfVerticesWithCityOfPlayer = nextState.cities[nextPlayer];
-			for (std::string& labelOfVertex : vectorOfLabelsOfVerticesWithCityOfPlayer) {
-				if (
-					resources.brick >= 2 &&
-					std::find(nextState.walls[nextPlayer].begin(), nextState.walls[nextPlayer].end(), labelOfVertex) == nextState.walls[nextPlayer].end()
-					) {
-					unorderedMapOfLabelsOfVerticesAndMoveTypes[labelOfVertex].push_back("wall");
-				}
-			}
-			std::vector<std::string> vectorOfLabelsOfAvailableEdges = board.getVectorOfLabelsOfAvailableEdges(vectorOfLabelsOfOccupiedEdges);
-			for (auto& labelOfEdge : vectorOfLabelsOfAvailableEdges) {
-				auto [firstLabelOfVertex, secondLabelOfVertex] = board.getVerticesOfEdge(labelOfEdge);
-				if (
-					(unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(firstLabelOfVertex) || unorderedSetOfLabelsOfVerticesOfRoadsOfPlayer.contains(secondLabelOfVertex)) &&
-					resources.brick >= 1 &&
-					resources.lumber >= 1
-					) {
-					vectorOfLabelsOfEdges.push_back(labelOfEdge);
-				}
-			}
-		}
-		crow::json::wvalue jsonObjectOfPossibleNextMoves(crow::json::type::Object);
-		jsonObjectOfPossibleNextMoves["player"] = nextPlayer;
-		jsonObjectOfPossibleNextMoves["nextPlayerWillRollDice"] = nextPlayerWillRollDice;
-
-		crow::json::wvalue jsonObjectOfLabelsOfVerticesAndMoveTypes(crow::json::type::Object);
+		Json::JsonWriter writer;
+		writer.beginObject();
+		writer.key("player").value(nextPlayer);
+		writer.key("nextPlayerWillRollDice").value(nextPlayerWillRollDice);
+		writer.key("vertices").beginObject();
 		for (auto& [labelOfVertex, vectorOfMoveTypes] : unorderedMapOfLabelsOfVerticesAndMoveTypes) {
-			crow::json::wvalue arrayOfMoveTypes(crow::json::type::List);
-			for (size_t i = 0; i < vectorOfMoveTypes.size(); i++) {
-				arrayOfMoveTypes[i] = vectorOfMoveTypes[i];
+			writer.key(labelOfVertex).beginArray();
+			for (const std::string& moveType : vectorOfMoveTypes) {
+				writer.value(moveType);
 			}
-			jsonObjectOfLabelsOfVerticesAndMoveTypes[labelOfVertex.c_str()] = std::move(arrayOfMoveTypes);
+			writer.endArray();
 		}
-		jsonObjectOfPossibleNextMoves["vertices"] = std::move(jsonObjectOfLabelsOfVerticesAndMoveTypes);
-
-		crow::json::wvalue jsonArrayOfLabelsOfEdges(crow::json::type::List);
-		for (size_t i = 0; i < vectorOfLabelsOfEdges.size(); i++) {
-			jsonArrayOfLabelsOfEdges[i] = vectorOfLabelsOfEdges[i].c_str();
+		writer.endObject();
+		writer.key("edges").beginArray();
+		for (const std::string& labelOfEdge : vectorOfLabelsOfEdges) {
+			writer.value(labelOfEdge);
 		}
-		jsonObjectOfPossibleNextMoves["edges"] = std::move(jsonArrayOfLabelsOfEdges);
+		writer.endArray();
+		writer.endObject();
 
-		response["possibleNextMoves"] = std::move(jsonObjectOfPossibleNextMoves);
-		liveDb.upsertSetting("lastPossibleNextMoves", response["possibleNextMoves"].dump());
+		std::string possibleNextMoves = writer.str();
+		liveDb.upsertSetting("lastPossibleNextMoves", possibleNextMoves);
+		return possibleNextMoves;
 	}
 
 };
\ No newline at end of file
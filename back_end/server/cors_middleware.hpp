@@ -18,7 +18,9 @@ namespace Server {
         template <typename AllContext>
         void after_handle(const crow::request&, crow::response& res, context&, AllContext&) {
             res.add_header("Access-Control-Allow-Origin", "http://localhost:3000");
-            res.add_header("Access-Control-Allow-Headers", "Content-Type");
+            res.add_header("Access-Control-Allow-Methods", "GET, POST, DELETE, OPTIONS");
+            res.add_header("Access-Control-Allow-Headers", "Content-Type, If-None-Match");
+            res.add_header("Access-Control-Expose-Headers", "ETag");
         }
     };
 
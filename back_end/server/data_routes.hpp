@@ -1,35 +1,38 @@
 #pragma once
 
 
+#include "app.hpp"
 #include "../game/board.hpp"
+#include "board_snapshot_encoder.hpp"
 #include "build_next_moves.hpp"
-#include "cors_middleware.hpp"
+#include <charconv>
 #include "crow.h"
+#include <cstring>
 #include "../db/database.hpp"
+#include "../json_writer.hpp"
+#include "state_cache.hpp"
 
 
 namespace Server {
 
 
-	crow::json::wvalue loadBlob(const DB::Database& db, const std::string& key) {
+	// Function `loadBlob` returns the JSON stored as a setting, or an empty object if the setting is empty or invalid.
+	std::string loadBlob(const DB::Database& db, const std::string& key) {
 		std::string setting = db.getSetting(key);
         if (setting.empty()) {
-            return crow::json::wvalue(crow::json::type::Object);
+            return "{}";
         }
-        auto parsed = crow::json::load(setting);
-        if (!parsed) {
+        if (!crow::json::load(setting)) {
             Logger::warn("/state", "Setting \"" + key + "\" contained invalid JSON - returning empty object.");
-            return crow::json::wvalue(crow::json::type::Object);
+            return "{}";
         }
-        crow::json::wvalue object;
-        object = parsed;
-        return object;
+        return setting;
 	};
 
 
     struct DataRoutes {
 
-        static void registerRoutes(crow::App<CorsMiddleware>& app, DB::Database& db) {
+        static void registerRoutes(App& app, DB::Database& db, StateCache& stateCache) {
 
             CROW_ROUTE(app, "/cities").methods("GET"_method)(
                 [&db]() -> crow::json::wvalue {
@@ -55,17 +58,83 @@ namespace Server {
                 }
             );
 
+            /* Endpoint `/board` returns all structures, resources, the current player, and the phase,
+            * read in one database session, so that a client need not request `/cities`, `/roads`, `/settlements`, and `/walls`.
+            * A request with header Accept containing "application/octet-stream" receives the binary encoding
+            * described at function `encodeBoardSnapshotAsBinary`; other requests receive JSON.
+            */
+            CROW_ROUTE(app, "/board").methods("GET"_method)(
+                [&db](const crow::request& request) -> crow::response {
+                    try {
+                        BoardSnapshot boardSnapshot = db.getBoardSnapshot();
+                        bool binaryIsAccepted = request.get_header_value("Accept").find("application/octet-stream") != std::string::npos;
+                        crow::response response{ 200, binaryIsAccepted ? encodeBoardSnapshotAsBinary(boardSnapshot) : encodeBoardSnapshotAsJson(boardSnapshot) };
+                        response.set_header("Content-Type", binaryIsAccepted ? "application/octet-stream" : "application/json");
+                        response.set_header("Vary", "Accept");
+                        return response;
+                    }
+                    catch (const std::exception& e) {
+                        Logger::error("/board", e);
+                        crow::json::wvalue err;
+                        err["error"] = std::string("Failed to build /board: ") + e.what();
+                        return crow::response{ 500, err.dump() };
+                    }
+                }
+            );
+
+            /* Endpoint `/state` is served from `stateCache`, which is invalidated by every mutation of the live game.
+            * Responses carry an entity tag, and a request with a matching header If-None-Match receives status code 304.
+            * A request with query parameter `since` set to a version previously received receives only changed fields,
+            * under an entity tag of its own; a value of `since` that is not a version receives status code 400.
+            */
             CROW_ROUTE(app, "/state").methods("GET"_method)(
-                [&db]() -> crow::response {
+                [&db, &stateCache](const crow::request& request) -> crow::response {
+                    const char* sinceVersion = request.url_params.get("since");
+                    uint64_t since = 0;
+                    if (sinceVersion != nullptr) {
+                        const char* endOfSinceVersion = sinceVersion + std::strlen(sinceVersion);
+                        auto [pointer, errorCode] = std::from_chars(sinceVersion, endOfSinceVersion, since);
+                        if (errorCode != std::errc() || pointer != endOfSinceVersion || pointer == sinceVersion) {
+                            crow::json::wvalue err;
+                            err["error"] = std::string("Query parameter since must be a version, not \"") + sinceVersion + "\".";
+                            return crow::response{ 400, err.dump() };
+                        }
+                    }
                     try {
-                        crow::json::wvalue result;
-                        result["message"] = db.getSetting("lastMessage");
-                        result["dice"] = loadBlob(db, "lastDice");
-                        result["gainedResources"] = loadBlob(db, "lastGainedResources");
-                        result["totalResources"] = loadBlob(db, "lastTotalResources");
-                        buildNextMoves(db, result);
-                        result["phase"] = Game::toString(db.getGameState().phase);
-                        return crow::response{ 200, result.dump() };
+                        std::shared_ptr<const StateCache::Snapshot> snapshot = stateCache.getSnapshot(
+                            [&db]() -> StateCache::Fields {
+                                StateCache::Fields fields;
+                                fields.emplace_back("message", Json::JsonWriter::quote(db.getSetting("lastMessage")));
+                                fields.emplace_back("dice", loadBlob(db, "lastDice"));
+                                fields.emplace_back("gainedResources", loadBlob(db, "lastGainedResources"));
+                                fields.emplace_back("totalResources", loadBlob(db, "lastTotalResources"));
+                                fields.emplace_back("possibleNextMoves", buildNextMoves(db));
+                                fields.emplace_back("phase", Json::JsonWriter::quote(Game::toString(db.getGameState().phase)));
+                                return fields;
+                            }
+                        );
+
+                        /* A delta is a different representation than the full body, so it carries its own entity tag,
+                        * and a cache holding one never answers a request for the other.
+                        */
+                        std::string entityTag = snapshot->entityTag;
+                        if (sinceVersion != nullptr) {
+                            entityTag.insert(entityTag.size() - 1, "-delta-" + std::to_string(since));
+                        }
+
+                        if (request.get_header_value("If-None-Match") == entityTag) {
+                            crow::response response(304);
+                            response.set_header("ETag", entityTag);
+                            response.set_header("Cache-Control", "no-cache");
+                            return response;
+                        }
+
+                        std::string body = sinceVersion != nullptr ? stateCache.getDelta(*snapshot, since) : snapshot->body;
+                        crow::response response{ 200, body };
+                        response.set_header("Content-Type", "application/json");
+                        response.set_header("ETag", entityTag);
+                        response.set_header("Cache-Control", "no-cache");
+                        return response;
                     }
                     catch (const std::exception& e) {
                         Logger::error("/state", e);
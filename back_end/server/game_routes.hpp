@@ -1,99 +1,274 @@
 #pragma once
 
 
+#include "app.hpp"
+#include <atomic>
 #include "build_next_moves.hpp"
+#include <chrono>
 #include "../config.hpp"
-#include "cors_middleware.hpp"
 #include "crow.h"
 #include "../db/database.hpp"
+#include <filesystem>
 #include "../game/game.hpp"
+#include "../json_writer.hpp"
+#include "job_pool.hpp"
 #include "../logger.hpp"
+#include <mutex>
 #include "../ai/neural_network.hpp"
+#include <optional>
+#include "push_channel.hpp"
+#include "../ai/search_budget.hpp"
+#include "../ai/mcts/search_tracer.hpp"
+#include "state_cache.hpp"
 
 
 namespace Server {
 
     struct GameRoutes {
 
+        /* The live game is mutated by `/makeMove`, `/reset`, and jobs of `/automateMove`.
+        * Mutations hold `mutexOfLiveGame` and increment `numberOfMutationsOfLiveGame`, so that a job that searched
+        * on a game state that has since changed can detect the conflict instead of applying a stale move.
+        * Jobs of `/recommendMove` change only the last message. They hold the mutex, invalidate the state cache, and push a message of type "message"
+        * only if the counter is unchanged since their search started, but do not increment it, since a message cannot make a searched move stale.
+        * Searches themselves run without the mutex.
+        */
+        inline static std::mutex mutexOfLiveGame;
+        inline static uint64_t numberOfMutationsOfLiveGame = 0;
+
+        static crow::response makeJsonResponse(const std::string& body, int code = 200) {
+            crow::response response{ code, body };
+            response.set_header("Content-Type", "application/json");
+            return response;
+        }
+
+        static crow::response makeErrorResponse(const std::string& description, int code = 200) {
+            Json::JsonWriter writer;
+            writer.beginObject();
+            writer.key("error").value(description);
+            writer.endObject();
+            return makeJsonResponse(writer.str(), code);
+        }
+
+        static crow::response makeErrorResponse(const std::string& description, const std::exception& e, int code = 200) {
+            return makeErrorResponse(description + e.what(), code);
+        }
+
+        // Function `makeJobResponse` returns a response with status 202 Accepted describing a queued job.
+        static crow::response makeJobResponse(uint64_t idOfJob) {
+            Json::JsonWriter writer;
+            writer.beginObject();
+            writer.key("jobId").value(static_cast<unsigned long long>(idOfJob));
+            writer.key("status").value(toString(StatusOfJob::Queued));
+            writer.endObject();
+            return makeJsonResponse(writer.str(), 202);
+        }
+
+        /* Function `parseSearchBudget` reads optional keys "numberOfSimulations", "timeLimitInMilliseconds", and "maximumNumberOfNodes"
+        * from the body of a request. Missing keys and an empty body fall back to the configuration.
+        * A time limit or a budget of nodes makes the latency of a search predictable regardless of the number of legal moves.
+        * Throws if a key is negative or if no bound is positive.
+        */
+        static AI::SearchBudget parseSearchBudget(const crow::request& request, const Config::Config& config) {
+            AI::SearchBudget searchBudget;
+            searchBudget.numberOfSimulations = config.numberOfSimulations;
+            searchBudget.timeLimitInMilliseconds = config.timeLimitInMilliseconds;
+            searchBudget.maximumNumberOfNodes = config.maximumNumberOfNodes;
+            searchBudget.stopsEarlyWhenLeadIsUnassailable = config.stopsSearchEarlyWhenLeadIsUnassailable;
+            if (!request.body.empty()) {
+                auto bodyOfRequest = crow::json::load(request.body);
+                if (!bodyOfRequest) {
+                    throw std::invalid_argument("The body of the request is not valid JSON.");
+                }
+                if (bodyOfRequest.has("numberOfSimulations")) {
+                    searchBudget.numberOfSimulations = static_cast<int>(bodyOfRequest["numberOfSimulations"].i());
+                }
+                if (bodyOfRequest.has("timeLimitInMilliseconds")) {
+                    searchBudget.timeLimitInMilliseconds = static_cast<int>(bodyOfRequest["timeLimitInMilliseconds"].i());
+                }
+                if (bodyOfRequest.has("maximumNumberOfNodes")) {
+                    searchBudget.maximumNumberOfNodes = static_cast<int>(bodyOfRequest["maximumNumberOfNodes"].i());
+                }
+            }
+            if (searchBudget.numberOfSimulations < 0 || searchBudget.timeLimitInMilliseconds < 0 || searchBudget.maximumNumberOfNodes < 0) {
+                throw std::invalid_argument("Number of simulations, time limit, and maximum number of nodes must not be negative.");
+            }
+            if (!searchBudget.isBounded()) {
+                throw std::invalid_argument("Number of simulations, time limit, or maximum number of nodes must be positive.");
+            }
+            return searchBudget;
+        }
+
+        /* Function `parseIntervalOfTracing` reads optional key "intervalOfTracing" from the body of a request.
+        * A positive interval traces every interval-th simulation of the search; 0, the default, does not trace.
+        */
+        static int parseIntervalOfTracing(const crow::request& request) {
+            if (request.body.empty()) {
+                return 0;
+            }
+            auto bodyOfRequest = crow::json::load(request.body);
+            if (!bodyOfRequest || !bodyOfRequest.has("intervalOfTracing")) {
+                return 0;
+            }
+            int intervalOfTracing = static_cast<int>(bodyOfRequest["intervalOfTracing"].i());
+            if (intervalOfTracing < 0) {
+                throw std::invalid_argument("The interval of tracing must not be negative.");
+            }
+            return intervalOfTracing;
+        }
+
+        // Function `saveTrace` saves the trace of a search as `search_<milliseconds since the epoch>_<number>.trace` in `pathToTraces` and returns its path.
+        static std::string saveTrace(const AI::MCTS::SearchTracer& searchTracer, const std::string& pathToTraces) {
+            static std::atomic<uint64_t> numberOfTraces{ 0 };
+            std::filesystem::create_directories(pathToTraces);
+            long long millisecondsSinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            std::string nameOfFile = "search_" + std::to_string(millisecondsSinceEpoch) + "_" + std::to_string(numberOfTraces++) + ".trace";
+            std::string pathToTrace = (std::filesystem::path(pathToTraces) / nameOfFile).string();
+            AI::MCTS::saveSearchTrace(searchTracer.getTrace(), pathToTrace);
+            return pathToTrace;
+        }
+
+        /* Function `writeMoveResponse` stores the message, dice, resources, and possible next moves of a move as settings
+        * and returns the body of a response of `/automateMove` or `/makeMove`.
+        * Each value is serialized once; the stored settings and the body share the same text.
+        */
+        static std::string writeMoveResponse(DB::Database& db, const Game::MoveResult& moveResult, Game::Phase phase) {
+            db.upsertSetting("lastMessage", moveResult.message);
+            std::string dice;
+            if (moveResult.diceWereRolled) {
+                dice = moveResult.serializeDice();
+                db.upsertSetting("lastDice", dice);
+            }
+            std::string gainedResources;
+            std::string totalResources;
+            if (moveResult.resourcesAreReported) {
+                gainedResources = moveResult.serializeGainedResources();
+                totalResources = moveResult.serializeTotalResources();
+                db.upsertSetting("lastGainedResources", gainedResources);
+                db.upsertSetting("lastTotalResources", totalResources);
+            }
+            std::string possibleNextMoves = buildNextMoves(db);
+
+            Json::JsonWriter writer;
+            writer.beginObject();
+            writer.key("message").value(moveResult.message);
+            if (!moveResult.typeOfStructure.empty()) {
+                writer.key(moveResult.typeOfStructure);
+                moveResult.writeStructure(writer);
+            }
+            if (moveResult.diceWereRolled) {
+                writer.key("dice").raw(dice);
+            }
+            if (moveResult.resourcesAreReported) {
+                writer.key("gainedResources").raw(gainedResources);
+                writer.key("totalResources").raw(totalResources);
+            }
+            writer.key("possibleNextMoves").raw(possibleNextMoves);
+            writer.key("phase").value(Game::toString(phase));
+            writer.endObject();
+            return writer.str();
+        }
+
         static void registerRoutes(
-            crow::App<CorsMiddleware>& app,
+            App& app,
             DB::Database& db,
             AI::WrapperOfNeuralNetwork& wrapperOfNeuralNetwork,
-            const Config::Config& config
+            const Config::Config& config,
+            StateCache& stateCache,
+            PushChannel& pushChannel,
+            JobPool& jobPool
         ) {
 
             CROW_ROUTE(app, "/automateMove").methods("POST"_method)(
-                [&db, &wrapperOfNeuralNetwork, &config]() -> crow::json::wvalue {
-					crow::json::wvalue response;
-
+                [&db, &wrapperOfNeuralNetwork, &config, &stateCache, &pushChannel, &jobPool](const crow::request& request) -> crow::response {
+					AI::SearchBudget searchBudget;
 					try {
-						Logger::info("A user posted to endpoint automateMove. The game state will be transitioned.");
-						GameState currentGameState = db.getGameState();
-						Game::Game game(
-							db,
-							wrapperOfNeuralNetwork,
-							config.numberOfSimulations,
-							config.cPuct,
-							config.tolerance,
-							currentGameState,
-							config.dirichletMixingWeight,
-							config.dirichletShape
-						);
-						response = game.handlePhase();
-						currentGameState = game.getState();
-						db.updateGameState(currentGameState);
-
-						auto save_if_present = [&](const char* field, const char* setting) {
-							const auto& val = response[field];
-							if (val.t() != crow::json::type::Null) {
-								db.upsertSetting(setting, val.dump());
-							}
-							};
-						std::string message = crow::json::load(response["message"].dump()).s();
-						db.upsertSetting("lastMessage", message);
-						save_if_present("dice", "lastDice");
-						save_if_present("gainedResources", "lastGainedResources");
-						save_if_present("totalResources", "lastTotalResources");
-
-						buildNextMoves(db, response);
-						response["phase"] = Game::toString(db.getGameState().phase);
+						searchBudget = parseSearchBudget(request, config);
 					}
 					catch (const std::exception& e) {
-						response["error"] = std::string("The following error occurred while transitioning the game state. ") + e.what();
-						Logger::error("automateMove", e);
+						return makeErrorResponse("The search budget is invalid. ", e, 400);
 					}
-					return response;
+					Logger::info("A user posted to endpoint automateMove. A job to transition the game state will be queued.");
+					uint64_t idOfJob = jobPool.submit(
+						"automateMove",
+						[&db, &wrapperOfNeuralNetwork, &config, &stateCache, &pushChannel, searchBudget](const std::atomic<bool>& cancellationFlag) -> std::string {
+							try {
+								GameState currentGameState;
+								uint64_t numberOfMutationsAtStart;
+								{
+									std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+									currentGameState = db.getGameState();
+									numberOfMutationsAtStart = numberOfMutationsOfLiveGame;
+								}
+								AI::SearchBudget searchBudgetOfJob = searchBudget;
+								searchBudgetOfJob.cancellationFlag = &cancellationFlag;
+								Game::Game game(
+									db,
+									wrapperOfNeuralNetwork,
+									searchBudgetOfJob,
+									config.cPuct,
+									config.tolerance,
+									currentGameState,
+									config.dirichletMixingWeight,
+									config.dirichletShape
+								);
+								AI::SearchResult searchResult = game.searchForMove();
+								if (cancellationFlag) {
+									throw JobWasCancelled();
+								}
+
+								std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+								if (numberOfMutationsOfLiveGame != numberOfMutationsAtStart) {
+									throw std::runtime_error("The game changed while a move was being searched for. Automate the move again.");
+								}
+								++numberOfMutationsOfLiveGame;
+								Game::MoveResult moveResult = game.applyMove(searchResult);
+								currentGameState = game.getState();
+								db.updateGameState(currentGameState);
+								std::string body = writeMoveResponse(db, moveResult, currentGameState.phase);
+								stateCache.invalidate();
+								pushChannel.publishMove(body, stateCache.getVersion());
+								return body;
+							}
+							catch (const JobWasCancelled&) {
+								throw;
+							}
+							catch (const std::exception&) {
+								stateCache.invalidate();
+								throw;
+							}
+						}
+					);
+					return makeJobResponse(idOfJob);
                 }
             );
 
             CROW_ROUTE(app, "/makeMove").methods("POST"_method)(
-                [&db, &wrapperOfNeuralNetwork, &config](const crow::request& request) -> crow::json::wvalue {
-					crow::json::wvalue response;
+                [&db, &wrapperOfNeuralNetwork, &config, &stateCache, &pushChannel](const crow::request& request) -> crow::response {
 					try {
 						auto bodyOfRequest = crow::json::load(request.body);
 						std::string move = bodyOfRequest["move"].s();
 						std::string moveType = bodyOfRequest["moveType"].s();
 						Logger::info("User requested move " + move + " of type " + moveType);
 
+						std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+						++numberOfMutationsOfLiveGame;
 						GameState currentGameState = db.getGameState();
 						auto resourcesBeforeMove = currentGameState.resources;
 						int player = currentGameState.currentPlayer;
+						Game::MoveResult moveResult;
 
 						if (moveType == "road") {
 							currentGameState.placeRoad(player, move);
 							int id = db.addStructure("roads", player, move, "edge");
-							response["road"]["id"] = id;
-							response["road"]["player"] = player;
-							response["road"]["edge"] = move;
-							response["message"] = "Player " + std::to_string(player) + " placed a road at " + move + ".";
+							moveResult.recordStructure("road", id, player, move);
+							moveResult.message = "Player " + std::to_string(player) + " placed a road at " + move + ".";
 						}
 						else if (moveType == "settlement") {
 							currentGameState.placeSettlement(player, move);
 							int id = db.addStructure("settlements", player, move, "vertex");
-							response["settlement"]["id"] = id;
-							response["settlement"]["player"] = player;
-							response["settlement"]["vertex"] = move;
-							response["message"] = "Player " + std::to_string(player) + " placed a settlement at " + move + ".";
+							moveResult.recordStructure("settlement", id, player, move);
+							moveResult.message = "Player " + std::to_string(player) + " placed a settlement at " + move + ".";
 						}
 						else if (moveType == "city") {
 							currentGameState.placeCity(player, move);
@@ -108,10 +283,8 @@ namespace Server {
 								mysqlx::abi2::r0::Result result = cities.insert("player", "vertex").values(player, move).execute();
 								int id = static_cast<int>(result.getAutoIncrementValue());
 								session.commit();
-								response["city"]["id"] = id;
-								response["city"]["player"] = player;
-								response["city"]["vertex"] = move;
-								response["message"] = "Player " + std::to_string(player) + " upgraded to a city at " + move + ".";
+								moveResult.recordStructure("city", id, player, move);
+								moveResult.message = "Player " + std::to_string(player) + " upgraded to a city at " + move + ".";
 							}
 							catch (const std::exception& e) {
 								session.rollback();
@@ -124,18 +297,16 @@ namespace Server {
 								throw std::runtime_error("A wall cannot be placed at " + move);
 							}
 							int id = db.addStructure("walls", player, move, "vertex");
-							response["wall"]["id"] = id;
-							response["wall"]["player"] = player;
-							response["wall"]["vertex"] = move;
-							response["message"] = "Player " + std::to_string(player) + " placed a wall at " + move + ".";
+							moveResult.recordStructure("wall", id, player, move);
+							moveResult.message = "Player " + std::to_string(player) + " placed a wall at " + move + ".";
 						}
 						else if (moveType == "pass") {
 							if (currentGameState.phase == Game::Phase::Turn) {
 								currentGameState.updatePhase();
-								response["message"] = "Player " + std::to_string(player) + " passed.";
+								moveResult.message = "Player " + std::to_string(player) + " passed.";
 							}
 							else {
-								response["message"] = "Phase is not turn.";
+								moveResult.message = "Phase is not turn.";
 							}
 						}
 						else {
@@ -143,123 +314,170 @@ namespace Server {
 
 						}
 						db.updateGameState(currentGameState);
-
-						crow::json::wvalue gainedAll(crow::json::type::Object);
-						for (int player = 1; player <= 3; ++player) {
-							const auto& newBag = currentGameState.resources[player];
-							const auto& oldBag = resourcesBeforeMove[player];
-							crow::json::wvalue bagJson(crow::json::type::Object);
-							bagJson["brick"] = newBag.brick - oldBag.brick;
-							bagJson["grain"] = newBag.grain - oldBag.grain;
-							bagJson["lumber"] = newBag.lumber - oldBag.lumber;
-							bagJson["ore"] = newBag.ore - oldBag.ore;
-							bagJson["wool"] = newBag.wool - oldBag.wool;
-							bagJson["cloth"] = newBag.cloth - oldBag.cloth;
-							bagJson["coin"] = newBag.coin - oldBag.coin;
-							bagJson["paper"] = newBag.paper - oldBag.paper;
-							gainedAll["Player " + std::to_string(player)] = std::move(bagJson);
-						}
-						response["gainedResources"] = std::move(gainedAll);
-						db.upsertSetting("lastGainedResources", response["gainedResources"].dump());
-
-						crow::json::wvalue totalAll(crow::json::type::Object);
-						for (int player = 1; player <= 3; ++player) {
-							const auto& bag = currentGameState.resources[player];
-							crow::json::wvalue bagJson(crow::json::type::Object);
-							bagJson["brick"] = bag.brick;
-							bagJson["grain"] = bag.grain;
-							bagJson["lumber"] = bag.lumber;
-							bagJson["ore"] = bag.ore;
-							bagJson["wool"] = bag.wool;
-							bagJson["cloth"] = bag.cloth;
-							bagJson["coin"] = bag.coin;
-							bagJson["paper"] = bag.paper;
-							totalAll["Player " + std::to_string(player)] = std::move(bagJson);
-						}
-						response["totalResources"] = std::move(totalAll);
-						db.upsertSetting("lastTotalResources", response["totalResources"].dump());
-
-						buildNextMoves(db, response);
-						response["phase"] = Game::toString(currentGameState.phase);
-						db.upsertSetting("lastPossibleNextMoves", response["possibleNextMoves"].dump());
-						std::string lastMessage = crow::json::load(response["message"].dump()).s();
-						db.upsertSetting("lastMessage", lastMessage);
+						moveResult.recordResources(resourcesBeforeMove, currentGameState.resources);
+						std::string body = writeMoveResponse(db, moveResult, currentGameState.phase);
+						stateCache.invalidate();
+						pushChannel.publishMove(body, stateCache.getVersion());
+						return makeJsonResponse(body);
 					}
 					catch (const std::exception& e) {
-						response["error"] = std::string("Making move failed with error ") + e.what();
 						Logger::error("makeMove", e);
+						stateCache.invalidate();
+						return makeErrorResponse("Making move failed with error ", e);
 					}
-					return response;
 				}
             );
 
             CROW_ROUTE(app, "/reset").methods("POST"_method)(
-                [&db]() -> crow::json::wvalue {
-					crow::json::wvalue response;
+                [&db, &stateCache, &pushChannel]() -> crow::response {
+					std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+					++numberOfMutationsOfLiveGame;
 					try {
 						Logger::info("A user posted to endpoint reset. Game state and database will be reset.");
 						bool success = db.resetGame();
-						response["message"] = success ? "Game has been reset to initial state." : "Resetting game failed.";
-						std::string messageWithQuotes = response["message"].dump();
-						std::string message = (messageWithQuotes.front() == '"' && messageWithQuotes.back() == '"') ? messageWithQuotes.substr(1, messageWithQuotes.size() - 2) : messageWithQuotes;
+						std::string message = success ? "Game has been reset to initial state." : "Resetting game failed.";
 						db.upsertSetting("lastMessage", message);
 						db.upsertSetting("lastDice", {});
 
-						auto makeZeroBag = []() {
-							crow::json::wvalue bag(crow::json::type::Object);
-							bag["brick"] = 0;
-							bag["grain"] = 0;
-							bag["lumber"] = 0;
-							bag["ore"] = 0;
-							bag["wool"] = 0;
-							bag["cloth"] = 0;
-							bag["coin"] = 0;
-							bag["paper"] = 0;
-							return bag;
-							};
-						crow::json::wvalue zeroTotals(crow::json::type::Object);
-						crow::json::wvalue zeroGained(crow::json::type::Object);
-						for (int player = 1; player <= 3; ++player) {
-							const std::string key = "Player " + std::to_string(player);
-							zeroTotals[key] = makeZeroBag();
-							zeroGained[key] = makeZeroBag();
-						}
-						db.upsertSetting("lastGainedResources", zeroGained.dump());
-						db.upsertSetting("lastTotalResources", zeroTotals.dump());
+						Json::JsonWriter writerOfZeroBags;
+						writeResourceBagsOfPlayers(writerOfZeroBags, std::array<ResourceBag, 4>{});
+						db.upsertSetting("lastGainedResources", writerOfZeroBags.getBuffer());
+						db.upsertSetting("lastTotalResources", writerOfZeroBags.getBuffer());
 
 						db.upsertSetting("lastPossibleNextMoves", {});
+
+						Json::JsonWriter writer;
+						writer.beginObject();
+						writer.key("message").value(message);
+						writer.endObject();
+						stateCache.invalidate();
+						pushChannel.publishReset(stateCache.getVersion());
+						return makeJsonResponse(writer.str());
 					}
 					catch (const std::exception& e) {
-						response["error"] = std::string("Resetting game failed with the following error. ") + e.what();
 						Logger::error("setUpRoutes", e);
+						stateCache.invalidate();
+						pushChannel.publishReset(stateCache.getVersion());
+						return makeErrorResponse("Resetting game failed with the following error. ", e);
 					}
-					return response;
 				}
             );
 
-            CROW_ROUTE(app, "/recommendMove").methods("GET"_method)(
-                [&db, &wrapperOfNeuralNetwork, &config]() -> crow::json::wvalue {
-					crow::json::wvalue response;
+            CROW_ROUTE(app, "/recommendMove").methods("POST"_method)(
+                [&db, &wrapperOfNeuralNetwork, &config, &stateCache, &pushChannel, &jobPool](const crow::request& request) -> crow::response {
+					AI::SearchBudget searchBudget;
+					int intervalOfTracing = 0;
 					try {
-						GameState state = db.getGameState();
-						auto [move, moveType, visitCount] = runMcts(
-							state,
-							wrapperOfNeuralNetwork,
-							config.numberOfSimulations,
-							config.cPuct,
-							config.tolerance,
-							config.dirichletMixingWeight,
-							config.dirichletShape
-						);
-						std::string message = "Recommended move: " + moveType + " at " + move + ".";
-						response["message"] = message;
-						db.upsertSetting("lastMessage", message);
+						searchBudget = parseSearchBudget(request, config);
+						intervalOfTracing = parseIntervalOfTracing(request);
 					}
 					catch (const std::exception& e) {
-						response["error"] = std::string("Recommendation failed with error ") + e.what();
-						Logger::error("recommendMove", e);
+						return makeErrorResponse("The search budget or the interval of tracing is invalid. ", e, 400);
+					}
+					uint64_t idOfJob = jobPool.submit(
+						"recommendMove",
+						[&db, &wrapperOfNeuralNetwork, &config, &stateCache, &pushChannel, searchBudget, intervalOfTracing](const std::atomic<bool>& cancellationFlag) -> std::string {
+							GameState state;
+							uint64_t numberOfMutationsAtStart;
+							{
+								std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+								state = db.getGameState();
+								numberOfMutationsAtStart = numberOfMutationsOfLiveGame;
+							}
+							// No move is searched for before the dice are rolled or after the game ends, as in `Game::searchForMove`.
+							if (state.phase == Game::Phase::RollDice || state.phase == Game::Phase::Done) {
+								Json::JsonWriter writer;
+								writer.beginObject();
+								writer.key("message").value(
+									(state.phase == Game::Phase::RollDice) ?
+									"Roll the dice before asking for a recommended move." :
+									"The game is over, so no move is recommended."
+								);
+								writer.key("move").value("");
+								writer.key("moveType").value("");
+								writer.key("numberOfSimulations").value(0);
+								writer.key("visitCount").value(0);
+								writer.key("visitDistribution").beginArray().endArray();
+								writer.endObject();
+								return writer.str();
+							}
+							AI::SearchBudget searchBudgetOfJob = searchBudget;
+							searchBudgetOfJob.cancellationFlag = &cancellationFlag;
+							std::optional<AI::MCTS::SearchTracer> searchTracer;
+							if (intervalOfTracing > 0) {
+								searchTracer.emplace(intervalOfTracing);
+							}
+							auto [move, moveType, visitCount, visitDistribution, numberOfSimulations] = runMcts(
+								state,
+								wrapperOfNeuralNetwork,
+								searchBudgetOfJob,
+								config.cPuct,
+								config.tolerance,
+								config.dirichletMixingWeight,
+								config.dirichletShape,
+								searchTracer ? &*searchTracer : nullptr
+							);
+							if (cancellationFlag) {
+								throw JobWasCancelled();
+							}
+							std::string pathToTrace;
+							if (searchTracer) {
+								pathToTrace = saveTrace(*searchTracer, config.pathToTraces);
+							}
+							std::string message = "Recommended move: " + moveType + " at " + move + ".";
+							{
+								std::lock_guard<std::mutex> lock(mutexOfLiveGame);
+								if (numberOfMutationsOfLiveGame != numberOfMutationsAtStart) {
+									throw std::runtime_error("The game changed while a move was being searched for. Recommend a move again.");
+								}
+								db.upsertSetting("lastMessage", message);
+								stateCache.invalidate();
+								pushChannel.publishMessage(message, stateCache.getVersion());
+							}
+							Json::JsonWriter writer;
+							writer.beginObject();
+							writer.key("message").value(message);
+							writer.key("move").value(move);
+							writer.key("moveType").value(moveType);
+							writer.key("numberOfSimulations").value(numberOfSimulations);
+							if (!pathToTrace.empty()) {
+								writer.key("pathToTrace").value(pathToTrace);
+							}
+							writer.key("visitCount").value(visitCount);
+							writer.key("visitDistribution").beginArray();
+							for (const auto& [indexOfAction, probability] : visitDistribution) {
+								writer.beginObject();
+								writer.key("move").value(AI::getMoveOfAction(indexOfAction));
+								writer.key("probability").value(static_cast<double>(probability));
+								writer.endObject();
+							}
+							writer.endArray();
+							writer.endObject();
+							return writer.str();
+						}
+					);
+					return makeJobResponse(idOfJob);
+				}
+            );
+
+            CROW_ROUTE(app, "/jobs/<uint>").methods("GET"_method)(
+                [&jobPool](uint64_t idOfJob) -> crow::response {
+					std::optional<std::string> description = jobPool.describeJob(idOfJob);
+					if (!description) {
+						return makeErrorResponse("Job " + std::to_string(idOfJob) + " is unknown or no longer retained.", 404);
+					}
+					return makeJsonResponse(*description);
+				}
+            );
+
+            CROW_ROUTE(app, "/jobs/<uint>").methods("DELETE"_method)(
+                [&jobPool](uint64_t idOfJob) -> crow::response {
+					std::optional<std::string> description = jobPool.cancel(idOfJob);
+					if (!description) {
+						return makeErrorResponse("Job " + std::to_string(idOfJob) + " is unknown or no longer retained.", 404);
 					}
-					return response;
+					Logger::info("A user cancelled job " + std::to_string(idOfJob) + ".");
+					return makeJsonResponse(*description);
 				}
             );
         }
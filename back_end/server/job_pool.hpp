@@ -0,0 +1,233 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include "../json_writer.hpp"
+#include "../logger.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include "push_channel.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Server {
+
+	// Class `JobWasCancelled` is thrown by the work of a job that observes that the job was cancelled.
+	class JobWasCancelled : public std::runtime_error {
+	public:
+		JobWasCancelled() : std::runtime_error("Job was cancelled.") {}
+	};
+
+	enum class StatusOfJob {
+		Queued,
+		Running,
+		Succeeded,
+		Failed,
+		Cancelled
+	};
+
+	std::string toString(StatusOfJob statusOfJob) {
+		switch (statusOfJob) {
+		case StatusOfJob::Queued: return "queued";
+		case StatusOfJob::Running: return "running";
+		case StatusOfJob::Succeeded: return "succeeded";
+		case StatusOfJob::Failed: return "failed";
+		case StatusOfJob::Cancelled: return "cancelled";
+		default: return "unknown";
+		}
+	}
+
+	/* Class `JobPool` runs long computations such as searches with MCTS on dedicated compute threads
+	* so that threads of Crow are free to serve requests.
+	* Submitting work returns an identifier of a job at once. Clients poll the job by identifier or
+	* receive a message of type "job" through `PushChannel` when the job finishes.
+	* The work of a job receives a flag of cancellation, which becomes true when the job is cancelled.
+	* Descriptions of finished jobs are retained for a limited number of jobs.
+	*/
+	class JobPool {
+	public:
+
+		// Type `Work` returns the JSON result of a job, or throws `JobWasCancelled` or another exception.
+		using Work = std::function<std::string(const std::atomic<bool>& cancellationFlag)>;
+
+		JobPool(int numberOfThreads, PushChannel& pushChannelToUse) : pushChannel(pushChannelToUse) {
+			if (numberOfThreads < 1) {
+				throw std::invalid_argument("A job pool requires at least 1 thread.");
+			}
+			for (int i = 0; i < numberOfThreads; i++) {
+				vectorOfThreads.emplace_back([this](std::stop_token stopToken) {
+					runWorker(stopToken);
+				});
+			}
+		}
+
+		~JobPool() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				for (auto& [idOfJob, job] : unorderedMapOfIdsAndJobs) {
+					job->cancellationFlag = true;
+				}
+			}
+			for (std::jthread& thread : vectorOfThreads) {
+				thread.request_stop();
+			}
+			conditionVariable.notify_all();
+		}
+
+		uint64_t submit(const std::string& kind, Work work) {
+			std::shared_ptr<Job> job = std::make_shared<Job>();
+			job->kind = kind;
+			job->work = std::move(work);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				job->id = nextIdOfJob++;
+				unorderedMapOfIdsAndJobs[job->id] = job;
+				queueOfJobs.push_back(job);
+			}
+			conditionVariable.notify_one();
+			return job->id;
+		}
+
+		// Method `describeJob` returns a JSON description of a job, or nothing if the job is unknown or no longer retained.
+		std::optional<std::string> describeJob(uint64_t idOfJob) const {
+			std::lock_guard<std::mutex> lock(mutex);
+			auto iterator = unorderedMapOfIdsAndJobs.find(idOfJob);
+			if (iterator == unorderedMapOfIdsAndJobs.end()) {
+				return std::nullopt;
+			}
+			return describeJobWhileLocked(*iterator->second);
+		}
+
+		/* Method `cancel` cancels a queued job at once and asks a running job to stop.
+		* A running job that has already started to apply its result finishes normally.
+		* Returns a description of the job, or nothing if the job is unknown or no longer retained.
+		*/
+		std::optional<std::string> cancel(uint64_t idOfJob) {
+			std::string description;
+			bool jobWasQueued = false;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				auto iterator = unorderedMapOfIdsAndJobs.find(idOfJob);
+				if (iterator == unorderedMapOfIdsAndJobs.end()) {
+					return std::nullopt;
+				}
+				Job& job = *iterator->second;
+				job.cancellationFlag = true;
+				if (job.status == StatusOfJob::Queued) {
+					job.status = StatusOfJob::Cancelled;
+					job.work = nullptr;
+					retainFinishedJobWhileLocked(job.id);
+					jobWasQueued = true;
+				}
+				description = describeJobWhileLocked(job);
+			}
+			if (jobWasQueued) {
+				pushChannel.publishJob(description);
+			}
+			return description;
+		}
+
+	private:
+
+		static constexpr size_t MAXIMUM_NUMBER_OF_FINISHED_JOBS = 256;
+
+		struct Job {
+			uint64_t id{ 0 };
+			std::string kind;
+			StatusOfJob status{ StatusOfJob::Queued };
+			Work work;
+			std::atomic<bool> cancellationFlag{ false };
+			std::string result;
+			std::string error;
+		};
+
+		mutable std::mutex mutex;
+		std::condition_variable_any conditionVariable;
+		std::deque<std::shared_ptr<Job>> queueOfJobs;
+		std::unordered_map<uint64_t, std::shared_ptr<Job>> unorderedMapOfIdsAndJobs;
+		std::deque<uint64_t> queueOfIdsOfFinishedJobs;
+		uint64_t nextIdOfJob = 1;
+		PushChannel& pushChannel;
+		std::vector<std::jthread> vectorOfThreads;
+
+		void runWorker(std::stop_token stopToken) {
+			while (!stopToken.stop_requested()) {
+				std::shared_ptr<Job> job;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					if (!conditionVariable.wait(lock, stopToken, [this] { return !queueOfJobs.empty(); })) {
+						return;
+					}
+					job = queueOfJobs.front();
+					queueOfJobs.pop_front();
+					if (job->status != StatusOfJob::Queued) {
+						continue;
+					}
+					job->status = StatusOfJob::Running;
+				}
+
+				StatusOfJob status;
+				std::string result;
+				std::string error;
+				try {
+					result = job->work(job->cancellationFlag);
+					status = StatusOfJob::Succeeded;
+				}
+				catch (const JobWasCancelled&) {
+					status = StatusOfJob::Cancelled;
+				}
+				catch (const std::exception& e) {
+					Logger::error("job " + std::to_string(job->id) + " of kind " + job->kind, e);
+					status = StatusOfJob::Failed;
+					error = e.what();
+				}
+
+				std::string description;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					job->status = status;
+					job->result = std::move(result);
+					job->error = std::move(error);
+					job->work = nullptr;
+					retainFinishedJobWhileLocked(job->id);
+					description = describeJobWhileLocked(*job);
+				}
+				pushChannel.publishJob(description);
+			}
+		}
+
+		void retainFinishedJobWhileLocked(uint64_t idOfJob) {
+			queueOfIdsOfFinishedJobs.push_back(idOfJob);
+			while (queueOfIdsOfFinishedJobs.size() > MAXIMUM_NUMBER_OF_FINISHED_JOBS) {
+				unorderedMapOfIdsAndJobs.erase(queueOfIdsOfFinishedJobs.front());
+				queueOfIdsOfFinishedJobs.pop_front();
+			}
+		}
+
+		std::string describeJobWhileLocked(const Job& job) const {
+			Json::JsonWriter writer;
+			writer.beginObject();
+			writer.key("jobId").value(static_cast<unsigned long long>(job.id));
+			writer.key("kind").value(job.kind);
+			writer.key("status").value(toString(job.status));
+			if (job.status == StatusOfJob::Succeeded) {
+				writer.key("result").raw(job.result);
+			}
+			else if (job.status == StatusOfJob::Failed) {
+				writer.key("error").value(job.error);
+			}
+			writer.endObject();
+			return writer.str();
+		}
+	};
+
+}
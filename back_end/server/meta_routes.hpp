@@ -1,16 +1,17 @@
 #pragma once
 
 
+#include "app.hpp"
 #include "crow.h"
 #include "../db/database.hpp"
-#include "cors_middleware.hpp"
+#include "../metrics.hpp"
 
 
 namespace Server {
 
     struct MetaRoutes {
 
-        static void registerRoutes(crow::App<CorsMiddleware>& app) {
+        static void registerRoutes(App& app) {
 
             CROW_ROUTE(app, "/").methods("GET"_method)(
                 []() -> crow::json::wvalue {
@@ -20,6 +21,24 @@ namespace Server {
                 }
             );
 
+            // Route `/metrics` renders every metric in the text exposition format of Prometheus.
+            CROW_ROUTE(app, "/metrics").methods("GET"_method)(
+                []() {
+                    crow::response response(Metrics::Registry::getInstance().render());
+                    response.set_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+                    return response;
+                }
+            );
+
+            // The catch all route answers requests that match no rule with status code 404 and labels them as unmatched in metrics.
+            CROW_CATCHALL_ROUTE(app)(
+                [&app](const crow::request& request, crow::response& response) {
+                    app.get_context<MetricsMiddleware>(request).routeWasMatched = false;
+                    response.code = 404;
+                    response.end();
+                }
+            );
+
         }
     };
 
@@ -0,0 +1,109 @@
+#pragma once
+
+
+#include <chrono>
+#include "crow.h"
+#include "../db/database.hpp"
+#include "../metrics.hpp"
+#include <string>
+#include <unordered_map>
+
+
+namespace Server {
+
+    /* Structure `MetricsMiddleware` records the latency, status, and number of database sessions of every request.
+    * Latency is labelled by method and route. The route of a request that matched a rule is the template of that rule, since segments of digits
+    * are replaced by `<uint>` so that `/jobs/7` and `/jobs/8` share route `/jobs/<uint>`, even if its handler responds with status code 404.
+    * Crow does not tell middlewares which rule matched, so the catch all route, which runs only when no rule matched, marks a request as unmatched.
+    * Such requests share route `unmatched`, which keeps the number of series bounded.
+    * Sessions are counted on the thread that handles the request; work run by the job pool is not attributed to a request.
+    */
+    struct MetricsMiddleware {
+        struct context {
+            std::chrono::steady_clock::time_point timeOfStart;
+            uint64_t numberOfSessionsAtStart = 0;
+            bool routeWasMatched = true;
+        };
+
+        void before_handle(crow::request&, crow::response&, context& ctx) {
+            ctx.timeOfStart = std::chrono::steady_clock::now();
+            ctx.numberOfSessionsAtStart = DB::numberOfSessionsOpenedOnThread;
+        }
+
+        template <typename AllContext>
+        void after_handle(const crow::request& req, crow::response& res, context& ctx, AllContext&) {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - ctx.timeOfStart).count();
+            const std::string method = crow::method_name(req.method);
+            const std::string route = ctx.routeWasMatched ? normalizeRoute(req.url) : "unmatched";
+            MetricsOfRoute& metricsOfRoute = getMetricsOfRoute(method, route);
+            metricsOfRoute.histogramOfDurations->observe(seconds);
+            metricsOfRoute.histogramOfSessions->observe(static_cast<double>(DB::numberOfSessionsOpenedOnThread - ctx.numberOfSessionsAtStart));
+            getCounterOfResponses(method, route, res.code).increment();
+        }
+
+    private:
+        struct MetricsOfRoute {
+            Metrics::Histogram* histogramOfDurations = nullptr;
+            Metrics::Histogram* histogramOfSessions = nullptr;
+        };
+
+        // Function `normalizeRoute` replaces every segment of a path that consists only of digits with `<uint>`.
+        static std::string normalizeRoute(const std::string& path) {
+            std::string route;
+            size_t start = 0;
+            while (start < path.size()) {
+                size_t end = path.find('/', start + 1);
+                if (end == std::string::npos) {
+                    end = path.size();
+                }
+                std::string segment = path.substr(start, end - start);
+                if (segment.size() > 1 && segment.find_first_not_of("0123456789", 1) == std::string::npos) {
+                    route += "/<uint>";
+                }
+                else {
+                    route += segment;
+                }
+                start = end;
+            }
+            return route.empty() ? "/" : route;
+        }
+
+        // Method `getMetricsOfRoute` looks up the histograms of a route in the registry once per thread and caches them.
+        static MetricsOfRoute& getMetricsOfRoute(const std::string& method, const std::string& route) {
+            thread_local std::unordered_map<std::string, MetricsOfRoute> unorderedMapOfKeysAndMetrics;
+            MetricsOfRoute& metricsOfRoute = unorderedMapOfKeysAndMetrics[method + " " + route];
+            if (metricsOfRoute.histogramOfDurations == nullptr) {
+                Metrics::Registry& registry = Metrics::Registry::getInstance();
+                const Metrics::Labels labels = { { "method", method }, { "route", route } };
+                metricsOfRoute.histogramOfDurations = &registry.getHistogram(
+                    "catan_http_request_duration_seconds",
+                    "Seconds from receiving a request to sending its response.",
+                    Metrics::BUCKETS_OF_LATENCIES,
+                    labels
+                );
+                metricsOfRoute.histogramOfSessions = &registry.getHistogram(
+                    "catan_db_sessions_per_request",
+                    "Number of database sessions opened while handling a request.",
+                    { 0.0, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0 },
+                    labels
+                );
+            }
+            return metricsOfRoute;
+        }
+
+        // Method `getCounterOfResponses` looks up the counter of responses of a route with a status once per thread and caches it.
+        static Metrics::Counter& getCounterOfResponses(const std::string& method, const std::string& route, int status) {
+            thread_local std::unordered_map<std::string, Metrics::Counter*> unorderedMapOfKeysAndCounters;
+            Metrics::Counter*& counter = unorderedMapOfKeysAndCounters[method + " " + route + " " + std::to_string(status)];
+            if (counter == nullptr) {
+                counter = &Metrics::Registry::getInstance().getCounter(
+                    "catan_http_responses_total",
+                    "Number of responses by method, route, and status.",
+                    { { "method", method }, { "route", route }, { "status", std::to_string(status) } }
+                );
+            }
+            return *counter;
+        }
+    };
+
+}
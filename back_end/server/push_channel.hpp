@@ -0,0 +1,98 @@
+#pragma once
+
+
+#include "crow.h"
+#include <cstdint>
+#include "../json_writer.hpp"
+#include <mutex>
+#include "state_cache.hpp"
+#include <string>
+#include <unordered_set>
+
+
+namespace Server {
+
+	/* Class `PushChannel` keeps track of the WebSocket connections of subscribed clients
+	* and pushes a compact description of every change of the live game to all of them.
+	* Each description is serialized once and the same buffer is sent to every subscriber.
+	*/
+	class PushChannel {
+	public:
+
+		/* Method `subscribe` adds a connection and sends it a hello with the current version of the game state under the same lock as publishing,
+		* so that every change published after the hello has a later version and every change published before it is included in that version.
+		*/
+		void subscribe(crow::websocket::connection* connection, const StateCache& stateCache) {
+			std::lock_guard<std::mutex> lock(mutex);
+			setOfConnections.insert(connection);
+			connection->send_text("{\"type\":\"hello\",\"version\":" + std::to_string(stateCache.getVersion()) + "}");
+		}
+
+		void unsubscribe(crow::websocket::connection* connection) {
+			std::lock_guard<std::mutex> lock(mutex);
+			setOfConnections.erase(connection);
+		}
+
+		size_t getNumberOfSubscribers() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return setOfConnections.size();
+		}
+
+		void publish(const std::string& message) {
+			std::lock_guard<std::mutex> lock(mutex);
+			for (crow::websocket::connection* connection : setOfConnections) {
+				connection->send_text(message);
+			}
+		}
+
+		/* Method `publishMove` pushes the body of a successful response of `/automateMove` or `/makeMove`,
+		* which describes the structure placed, the dice rolled, the resources changed, the phase, and the possible next moves,
+		* with keys "type" and "version" prepended. The body is not parsed or serialized again.
+		* Upgrading a settlement to a city is described only by key "city"; clients remove the settlement at the same vertex.
+		*/
+		void publishMove(const std::string& bodyOfResponse, uint64_t version) {
+			std::string message = "{\"type\":\"move\",\"version\":" + std::to_string(version);
+			if (bodyOfResponse.size() > 2) {
+				message += ',';
+				message.append(bodyOfResponse, 1, std::string::npos);
+			}
+			else {
+				message += '}';
+			}
+			publish(message);
+		}
+
+		/* Method `publishMessage` pushes a change of only the last message, such as a recommended move, which is not a move
+		* and so carries none of the other keys of a pushed move.
+		*/
+		void publishMessage(const std::string& message, uint64_t version) {
+			std::string text = "{\"type\":\"message\",\"version\":" + std::to_string(version) + ",\"message\":";
+			text += Json::JsonWriter::quote(message);
+			text += '}';
+			publish(text);
+		}
+
+		// Method `publishReset` tells subscribers to discard everything they know about the game.
+		void publishReset(uint64_t version) {
+			publish("{\"type\":\"reset\",\"version\":" + std::to_string(version) + "}");
+		}
+
+		// Method `publishJob` pushes the description of a job that finished, with key "type" prepended.
+		void publishJob(const std::string& descriptionOfJob) {
+			std::string message = "{\"type\":\"job\"";
+			if (descriptionOfJob.size() > 2) {
+				message += ',';
+				message.append(descriptionOfJob, 1, std::string::npos);
+			}
+			else {
+				message += '}';
+			}
+			publish(message);
+		}
+
+	private:
+		mutable std::mutex mutex;
+		std::unordered_set<crow::websocket::connection*> setOfConnections;
+	};
+
+}
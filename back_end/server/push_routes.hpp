@@ -0,0 +1,37 @@
+#pragma once
+
+
+#include "app.hpp"
+#include "crow.h"
+#include "../logger.hpp"
+#include "push_channel.hpp"
+#include "state_cache.hpp"
+
+
+namespace Server {
+
+    struct PushRoutes {
+
+        static void registerRoutes(App& app, PushChannel& pushChannel, StateCache& stateCache) {
+
+            /* Endpoint `/subscribe` upgrades a request to a WebSocket connection.
+            * On opening, the client receives the current version of the game state so that it can request `/state?since=<version>`.
+            * Afterward, the client receives one message per move or reset and does not need to poll.
+            */
+            CROW_WEBSOCKET_ROUTE(app, "/subscribe")
+                .onopen([&pushChannel, &stateCache](crow::websocket::connection& connection) {
+                    pushChannel.subscribe(&connection, stateCache);
+                    Logger::info("A client subscribed to pushed changes. There are " + std::to_string(pushChannel.getNumberOfSubscribers()) + " subscribers.");
+                })
+                .onclose([&pushChannel](crow::websocket::connection& connection, const std::string& reason, uint16_t) {
+                    pushChannel.unsubscribe(&connection);
+                    Logger::info("A client unsubscribed from pushed changes because " + (reason.empty() ? std::string("the connection closed") : reason) + ".");
+                })
+                .onmessage([](crow::websocket::connection&, const std::string&, bool) {
+                    // Do nothing. Clients change the game through the other endpoints.
+                });
+
+        }
+    };
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include "app.hpp"
 #include "build_next_moves.hpp"
 #include "crow.h"
 /* Add the following to Additional Include Directories:
@@ -9,12 +10,15 @@
 */
 
 #include "../config.hpp"
-#include "cors_middleware.hpp"
 #include "data_routes.hpp"
 #include "../db/database.hpp"
 #include "../game/game.hpp"
 #include "game_routes.hpp"
+#include "job_pool.hpp"
 #include "meta_routes.hpp"
+#include "push_channel.hpp"
+#include "push_routes.hpp"
+#include "state_cache.hpp"
 #include "../ai/neural_network.hpp"
 
 
@@ -22,14 +26,18 @@ namespace Server {
 
 
 	void setUpRoutes(
-		crow::App<CorsMiddleware>& app,
+		App& app,
 		DB::Database& db,
 		AI::WrapperOfNeuralNetwork& wrapperOfNeuralNetwork,
-		const Config::Config& config
+		const Config::Config& config,
+		StateCache& stateCache,
+		PushChannel& pushChannel,
+		JobPool& jobPool
 	) {
 		MetaRoutes::registerRoutes(app);
-		DataRoutes::registerRoutes(app, db);
-		GameRoutes::registerRoutes(app, db, wrapperOfNeuralNetwork, config);
+		DataRoutes::registerRoutes(app, db, stateCache);
+		GameRoutes::registerRoutes(app, db, wrapperOfNeuralNetwork, config, stateCache, pushChannel, jobPool);
+		PushRoutes::registerRoutes(app, pushChannel, stateCache);
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include "../metrics.hpp"
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace Server {
+
+	/* Class `StateCache` holds the serialized response of endpoint `/state` together with a version number.
+	* Every mutation of the live game calls `invalidate`, which increments the version and drops the serialized response.
+	* The next request rebuilds the response once, and subsequent requests are served from memory until the next mutation.
+	* The top level fields of recently built responses are retained so that a client that knows an older version
+	* can be sent only the fields that changed since that version.
+	*/
+	class StateCache {
+	public:
+
+		// Type `Fields` is a vector of pairs of top level keys and serialized JSON values of a response of `/state`.
+		using Fields = std::vector<std::pair<std::string, std::string>>;
+
+		struct Snapshot {
+			uint64_t version;
+			std::string entityTag;
+			Fields fields;
+			std::string body;
+		};
+
+		StateCache() :
+			version(1),
+			identifierOfProcess(std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count())),
+			counterOfHits(Metrics::Registry::getInstance().getCounter(NAME_OF_COUNTER_OF_LOOKUPS, HELP_OF_COUNTER_OF_LOOKUPS, { { "result", "hit" } })),
+			counterOfMisses(Metrics::Registry::getInstance().getCounter(NAME_OF_COUNTER_OF_LOOKUPS, HELP_OF_COUNTER_OF_LOOKUPS, { { "result", "miss" } }))
+		{
+			// Do nothing.
+		}
+
+		// Method `invalidate` is called after every mutation of the live game.
+		void invalidate() {
+			std::lock_guard<std::mutex> lock(mutex);
+			++version;
+			currentSnapshot.reset();
+		}
+
+		uint64_t getVersion() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return version;
+		}
+
+		/* Method `getSnapshot` returns the snapshot for the current version,
+		* calling `buildFields` to read the database only if no snapshot exists for the current version.
+		* If the game is mutated while fields are built, the built snapshot is returned but not cached.
+		*/
+		std::shared_ptr<const Snapshot> getSnapshot(const std::function<Fields()>& buildFields) {
+			uint64_t versionBeforeBuild;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (currentSnapshot) {
+					counterOfHits.increment();
+					return currentSnapshot;
+				}
+				versionBeforeBuild = version;
+			}
+			counterOfMisses.increment();
+			auto snapshot = std::make_shared<Snapshot>();
+			snapshot->version = versionBeforeBuild;
+			snapshot->entityTag = "\"" + identifierOfProcess + "-" + std::to_string(versionBeforeBuild) + "\"";
+			snapshot->fields = buildFields();
+			snapshot->fields.emplace_back("version", std::to_string(versionBeforeBuild));
+			snapshot->body = serialize(snapshot->fields);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (version == versionBeforeBuild) {
+				currentSnapshot = snapshot;
+				historyOfSnapshots.push_back(snapshot);
+				while (historyOfSnapshots.size() > MAXIMUM_NUMBER_OF_SNAPSHOTS_IN_HISTORY) {
+					historyOfSnapshots.pop_front();
+				}
+			}
+			return snapshot;
+		}
+
+		/* Method `getDelta` returns a body containing only the fields of `snapshot` whose values differ
+		* from the values of the snapshot with version `sinceVersion`.
+		* If the snapshot with version `sinceVersion` is no longer retained, the full body is returned.
+		*/
+		std::string getDelta(const Snapshot& snapshot, uint64_t sinceVersion) const {
+			std::shared_ptr<const Snapshot> earlierSnapshot;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				for (const std::shared_ptr<const Snapshot>& retainedSnapshot : historyOfSnapshots) {
+					if (retainedSnapshot->version == sinceVersion) {
+						earlierSnapshot = retainedSnapshot;
+						break;
+					}
+				}
+			}
+			if (!earlierSnapshot) {
+				return snapshot.body;
+			}
+			Fields changedFields;
+			for (const auto& [key, value] : snapshot.fields) {
+				bool fieldIsUnchanged = false;
+				for (const auto& [earlierKey, earlierValue] : earlierSnapshot->fields) {
+					if (earlierKey == key) {
+						fieldIsUnchanged = (earlierValue == value);
+						break;
+					}
+				}
+				if (!fieldIsUnchanged) {
+					changedFields.emplace_back(key, value);
+				}
+			}
+			changedFields.emplace_back("since", std::to_string(sinceVersion));
+			changedFields.emplace_back("delta", "true");
+			return serialize(changedFields);
+		}
+
+	private:
+
+		static constexpr size_t MAXIMUM_NUMBER_OF_SNAPSHOTS_IN_HISTORY = 16;
+		static constexpr const char* NAME_OF_COUNTER_OF_LOOKUPS = "catan_state_cache_lookups_total";
+		static constexpr const char* HELP_OF_COUNTER_OF_LOOKUPS = "Number of lookups of the snapshot of endpoint /state by whether a snapshot was cached.";
+
+		mutable std::mutex mutex;
+		uint64_t version;
+		std::string identifierOfProcess;
+		std::shared_ptr<const Snapshot> currentSnapshot;
+		std::deque<std::shared_ptr<const Snapshot>> historyOfSnapshots;
+		Metrics::Counter& counterOfHits;
+		Metrics::Counter& counterOfMisses;
+
+		static std::string serialize(const Fields& fields) {
+			std::string body = "{";
+			for (size_t i = 0; i < fields.size(); i++) {
+				if (i > 0) {
+					body += ',';
+				}
+				body += '"';
+				body += fields[i].first;
+				body += "\":";
+				body += fields[i].second;
+			}
+			body += '}';
+			return body;
+		}
+	};
+
+}
@@ -1,3 +1,5 @@
+import type { JobResponse } from "./types";
+
 const URL_OF_BACK_END = "http://localhost:5000";
 
 export const API = {
@@ -5,16 +7,22 @@ export const API = {
     endpoints: {
         cities: '/cities',
         automateMove: '/automateMove',
+        jobs: '/jobs',
         makeMove: '/makeMove',
         recommendMove: '/recommendMove',
         reset: '/reset',
         roads: '/roads',
         settlements: '/settlements',
         state: '/state',
+        subscribe: '/subscribe',
         walls: '/walls'
     }
 };
 
+export function webSocketUrl(endpoint: string): string {
+    return `${API.baseUrl.replace(/^http/, "ws")}${endpoint}`;
+}
+
 export async function apiFetch<T>(
     endpoint: string,
     options: RequestInit = {}
@@ -43,4 +51,18 @@ export async function apiFetch<T>(
         console.error(`[API FETCH FAILED] ${url}`, err);
         throw err;
     }
-}
\ No newline at end of file
+}
+
+// Function `awaitJob` polls a job of the back end until it finishes and returns its result.
+export async function awaitJob<T>(jobId: number, intervalInMilliseconds: number = 250): Promise<T> {
+    for (;;) {
+        const job = await apiFetch<JobResponse<T>>(`${API.endpoints.jobs}/${jobId}`);
+        if (job.status === "succeeded") {
+            return job.result as T;
+        }
+        if (job.status === "failed" || job.status === "cancelled") {
+            throw new Error(`Job ${jobId} ${job.status}${job.error ? `: ${job.error}` : "."}`);
+        }
+        await new Promise(resolve => setTimeout(resolve, intervalInMilliseconds));
+    }
+}
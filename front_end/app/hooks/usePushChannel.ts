@@ -0,0 +1,152 @@
+import { API, webSocketUrl } from '../api';
+import { AutomateAndMakeMoveResponse, Road, Settlement, WallInformation } from '../types';
+import { useEffect, useRef, useState } from 'react';
+import { useQueryClient } from '@tanstack/react-query';
+
+
+type City = { id: Number; player: Number; vertex: string };
+
+type PushedMessage =
+    | { type: "hello"; version: number }
+    | { type: "reset"; version: number }
+    | { type: "job"; jobId: number }
+    | { type: "message"; version: number; message: string }
+    | ({ type: "move"; version: number; settlement?: Settlement; city?: City; road?: Road; wall?: WallInformation } & Partial<AutomateAndMakeMoveResponse>);
+
+
+const STRUCTURE_QUERY_KEYS = ["state", "cities", "settlements", "roads", "walls"] as const;
+
+
+// Function `appendById` appends a structure to a list unless a structure with the same id is already in it.
+function appendById<T extends { id: number | Number }>(items: T[], item: T): T[] {
+    return items.some(existing => Number(existing.id) === Number(item.id)) ? items : [...items, item];
+}
+
+
+/* Hook `usePushChannel` subscribes to changes pushed by the back end and applies each change to the cached queries,
+* so that the board does not need to be refetched after each move.
+* Every mutation of the game increments its version, and a move or a message is applied only if its version follows the last version applied.
+* Older changes are skipped; a gap in versions, a move arriving while the queries are being refetched, a hello, or a reset refetches everything instead.
+* The hook returns whether the subscription is open; while it is not, callers should invalidate queries themselves.
+*/
+export function usePushChannel(): boolean {
+    const queryClient = useQueryClient();
+    const [isSubscribed, setIsSubscribed] = useState(false);
+    // A version is known only after the hello of a connection.
+    const lastVersion = useRef<number | null>(null);
+
+    useEffect(() => {
+        let socket: WebSocket | null = null;
+        let timeoutOfReconnection: ReturnType<typeof setTimeout> | null = null;
+        let isUnmounted = false;
+
+        const invalidateAll = () => {
+            STRUCTURE_QUERY_KEYS.forEach(key => queryClient.invalidateQueries({ queryKey: [key] }));
+        };
+
+        const isRefetching = () =>
+            STRUCTURE_QUERY_KEYS.some(key => queryClient.isFetching({ queryKey: [key] }) > 0);
+
+        const applyMove = (message: Extract<PushedMessage, { type: "move" }>) => {
+            const { settlement, city, road, wall } = message;
+            if (settlement) {
+                queryClient.setQueryData<{ settlements: Settlement[] }>(["settlements"], old =>
+                    old ? { settlements: appendById(old.settlements, settlement) } : old
+                );
+            }
+            if (city) {
+                queryClient.setQueryData<{ cities: City[] }>(["cities"], old =>
+                    old ? { cities: appendById(old.cities, city) } : old
+                );
+                queryClient.setQueryData<{ settlements: Settlement[] }>(["settlements"], old =>
+                    old ? { settlements: old.settlements.filter(s => !(s.vertex === city.vertex && s.player === city.player)) } : old
+                );
+            }
+            if (road) {
+                queryClient.setQueryData<{ roads: Road[] }>(["roads"], old =>
+                    old ? { roads: appendById(old.roads, road) } : old
+                );
+            }
+            if (wall) {
+                queryClient.setQueryData<{ walls: WallInformation[] }>(["walls"], old =>
+                    old ? { walls: appendById(old.walls, wall) } : old
+                );
+            }
+            queryClient.setQueryData<AutomateAndMakeMoveResponse>(["state"], old => {
+                if (!old) {
+                    return old;
+                }
+                return {
+                    ...old,
+                    message: message.message ?? old.message,
+                    phase: message.phase ?? old.phase,
+                    possibleNextMoves: message.possibleNextMoves ?? old.possibleNextMoves,
+                    dice: message.dice ?? old.dice,
+                    gainedResources: message.gainedResources ?? old.gainedResources,
+                    totalResources: message.totalResources ?? old.totalResources
+                };
+            });
+        };
+
+        const applyMessage = (message: Extract<PushedMessage, { type: "message" }>) => {
+            queryClient.setQueryData<AutomateAndMakeMoveResponse>(["state"], old =>
+                old ? { ...old, message: message.message } : old
+            );
+        };
+
+        const connect = () => {
+            socket = new WebSocket(webSocketUrl(API.endpoints.subscribe));
+            socket.onopen = () => setIsSubscribed(true);
+            socket.onmessage = event => {
+                const message = JSON.parse(event.data) as PushedMessage;
+                if (message.type === "move" || message.type === "message") {
+                    if (lastVersion.current === null || message.version <= lastVersion.current) {
+                        // The refetch after the hello, or an earlier change, already includes this change.
+                        return;
+                    }
+                    const followsLastVersion = message.version === lastVersion.current + 1;
+                    lastVersion.current = message.version;
+                    if (followsLastVersion && !isRefetching()) {
+                        if (message.type === "move") {
+                            applyMove(message);
+                        }
+                        else {
+                            applyMessage(message);
+                        }
+                    }
+                    else {
+                        // A mutation was missed, or a refetch in flight may return data older than this move.
+                        invalidateAll();
+                    }
+                }
+                else if (message.type === "job") {
+                    // Moves applied by jobs are pushed separately; callers poll jobs they submitted.
+                }
+                else {
+                    // Changes may have been missed before a hello, and a reset replaces everything.
+                    lastVersion.current = message.version;
+                    invalidateAll();
+                }
+            };
+            socket.onclose = () => {
+                setIsSubscribed(false);
+                lastVersion.current = null;
+                if (!isUnmounted) {
+                    timeoutOfReconnection = setTimeout(connect, 2000);
+                }
+            };
+        };
+
+        connect();
+
+        return () => {
+            isUnmounted = true;
+            if (timeoutOfReconnection) {
+                clearTimeout(timeoutOfReconnection);
+            }
+            socket?.close();
+        };
+    }, [queryClient]);
+
+    return isSubscribed;
+}
@@ -1,10 +1,10 @@
 'use client';
 
-import { API, apiFetch } from './api';
+import { API, apiFetch, awaitJob } from './api';
 import { Board } from './BoardLayout';
 import { Dice, RecommendMoveResponse, Totals, WallInformation } from './types';
 import HexTile from './components/HexTile';
-import { ID_Of_Hex, ResetResponse } from './types';
+import { ID_Of_Hex, JobResponse, ResetResponse } from './types';
 import { AutomateAndMakeMoveResponse } from './types';
 import Ocean from './components/Ocean';
 import { OuterContainer } from './BoardLayout';
@@ -27,6 +27,7 @@ import { useState } from 'react';
 import CanvasLayer from './CanvasLayer';
 import Marker from './components/Marker';
 import { useCentralQuery } from './hooks/useCentralQuery';
+import { usePushChannel } from './hooks/usePushChannel';
 import QueryBoundary from './components/QueryBoundary';
 import ResourcesDisplay, { ZERO_BAG } from './components/ResourcesDisplay';
 import Wall from './components/Wall';
@@ -69,6 +70,10 @@ export default function Home() {
     const queryClient = useQueryClient();
 
 
+    // While subscribed, changes are pushed by the back end and queries do not need to be invalidated after each move.
+    const isSubscribed = usePushChannel();
+
+
     const { data: stateData, isLoading: stateLoading, error: stateError } = useCentralQuery<AutomateAndMakeMoveResponse>(
         ["state"],
         () => apiFetch<AutomateAndMakeMoveResponse>(API.endpoints.state)
@@ -83,7 +88,17 @@ export default function Home() {
 
     const { mutate: fireRecommendMove, isPending: recommendLoading } = useMutation<RecommendMoveResponse, Error>(
         {
-            mutationFn: () => apiFetch<RecommendMoveResponse>(API.endpoints.recommendMove),
+            mutationFn: async () => {
+                const job = await apiFetch<JobResponse<RecommendMoveResponse>>(
+                    API.endpoints.recommendMove,
+                    {
+                        method: 'POST',
+                        headers: { 'Content-Type': 'application/json' },
+                        body: JSON.stringify({})
+                    }
+                );
+                return awaitJob<RecommendMoveResponse>(job.jobId);
+            },
             onSuccess: () => { queryClient.invalidateQueries({ queryKey: ['state'] }); }
         }
     );
@@ -136,20 +151,25 @@ export default function Home() {
 
     const { mutate: postAutomateMove, isPending: automateMoveLoading } = useMutation<AutomateAndMakeMoveResponse, Error>(
         {
-            mutationFn: () => apiFetch<AutomateAndMakeMoveResponse>(
-                API.endpoints.automateMove,
-                {
-                    method: 'POST',
-                    headers: { 'Content-Type': 'application/json' },
-                    body: JSON.stringify({})
-                }
-            ),
+            mutationFn: async () => {
+                const job = await apiFetch<JobResponse<AutomateAndMakeMoveResponse>>(
+                    API.endpoints.automateMove,
+                    {
+                        method: 'POST',
+                        headers: { 'Content-Type': 'application/json' },
+                        body: JSON.stringify({})
+                    }
+                );
+                return awaitJob<AutomateAndMakeMoveResponse>(job.jobId);
+            },
             onSuccess: (data) => {
-                queryClient.invalidateQueries({ queryKey: ["state"] });
-                queryClient.invalidateQueries({ queryKey: ["cities"] });
-                queryClient.invalidateQueries({ queryKey: ["settlements"] });
-                queryClient.invalidateQueries({ queryKey: ["roads"] });
-                queryClient.invalidateQueries({ queryKey: ["walls"] });
+                if (!isSubscribed) {
+                    queryClient.invalidateQueries({ queryKey: ["state"] });
+                    queryClient.invalidateQueries({ queryKey: ["cities"] });
+                    queryClient.invalidateQueries({ queryKey: ["settlements"] });
+                    queryClient.invalidateQueries({ queryKey: ["roads"] });
+                    queryClient.invalidateQueries({ queryKey: ["walls"] });
+                }
                 queryClient.removeQueries({ queryKey: ["recommendMove"] });
             }
         }
@@ -167,11 +187,13 @@ export default function Home() {
                 }
             ),
             onSuccess: data => {
-                queryClient.invalidateQueries( { queryKey: ['state'] });
-                queryClient.invalidateQueries( { queryKey: ['cities'] });
-                queryClient.invalidateQueries( { queryKey: ['settlements'] });
-                queryClient.invalidateQueries( { queryKey: ['roads'] });
-                queryClient.invalidateQueries( { queryKey: ['walls'] });
+                if (!isSubscribed) {
+                    queryClient.invalidateQueries( { queryKey: ['state'] });
+                    queryClient.invalidateQueries( { queryKey: ['cities'] });
+                    queryClient.invalidateQueries( { queryKey: ['settlements'] });
+                    queryClient.invalidateQueries( { queryKey: ['roads'] });
+                    queryClient.invalidateQueries( { queryKey: ['walls'] });
+                }
                 setMenuAnchor(null);
                 queryClient.removeQueries({ queryKey: ["recommendMove"] });
             }
@@ -190,11 +212,13 @@ export default function Home() {
                 }
             ),
             onSuccess: () => {
-                queryClient.invalidateQueries({ queryKey: ["state"] });
-                queryClient.invalidateQueries({ queryKey: ["cities"] });
-                queryClient.invalidateQueries({ queryKey: ["settlements"] });
-                queryClient.invalidateQueries({ queryKey: ["roads"] });
-                queryClient.invalidateQueries({ queryKey: ["walls"] });
+                if (!isSubscribed) {
+                    queryClient.invalidateQueries({ queryKey: ["state"] });
+                    queryClient.invalidateQueries({ queryKey: ["cities"] });
+                    queryClient.invalidateQueries({ queryKey: ["settlements"] });
+                    queryClient.invalidateQueries({ queryKey: ["roads"] });
+                    queryClient.invalidateQueries({ queryKey: ["walls"] });
+                }
                 queryClient.removeQueries({ queryKey: ["recommendMove"] });
                 setMenuAnchor(null);
             }
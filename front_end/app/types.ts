@@ -42,8 +42,23 @@ export interface ResourcesByKind {
 
 
 export interface RecommendMoveResponse {
+    message: string;
     move: string;
     moveType: string;
+    visitCount: number;
+    visitDistribution: { move: string; probability: number }[];
+}
+
+
+export type StatusOfJob = "queued" | "running" | "succeeded" | "failed" | "cancelled";
+
+
+export interface JobResponse<T> {
+    jobId: number;
+    kind?: string;
+    status: StatusOfJob;
+    result?: T;
+    error?: string;
 }
 
 
@@ -241,9 +241,140 @@ class BoardGeometryGenerator:
         return dictionary_of_board_geometry
 
 
+class BoardTopologyHeaderWriter:
+    '''
+    Write a C++ header of constexpr arrays of the topology, coordinates, and production of the board described by a file of isometric coordinates,
+    so that the back end compiles in the default board instead of reading and parsing the file at run time.
+    '''
+
+
+    def _format_array(self, list_of_values: List[int | str]) -> str:
+        return "{ " + ", ".join(str(value) for value in list_of_values) + " }"
+
+
+    def _format_array_of_arrays(self, list_of_lists_of_values: List[List[int | str]], indentation: str) -> str:
+        lines = [indentation + "\t{ " + ", ".join(str(value) for value in list_of_values) + " }" for list_of_values in list_of_lists_of_values]
+        return "{ {\n" + ",\n".join(lines) + "\n" + indentation + "} }"
+
+
+    def _get_indices(self, list_of_labels: List[str], length: int) -> List[int]:
+        '''
+        Convert labels like "V07" into zero based indices like 6 and pad the list with -1 to a given length.
+        '''
+        list_of_indices = [int(label[1:]) - 1 for label in list_of_labels]
+        return list_of_indices + [-1] * (length - len(list_of_indices))
+
+
+    def write_header(self, path_to_isometric_coordinates: str, path_to_header: str) -> None:
+        with open(path_to_isometric_coordinates) as f:
+            dictionary_of_isometric_coordinates = json.load(f)
+        dictionary_of_hexes_and_pairs_of_coordinates = dictionary_of_isometric_coordinates["objectOfIdsOfHexesAndPairsOfCoordinatesOfCentersOfHexes"]
+        dictionary_of_hexes_and_names_of_resources = dictionary_of_isometric_coordinates["objectOfIdsOfHexesAndNamesOfResources"]
+        dictionary_of_hexes_and_numbers_of_tokens = dictionary_of_isometric_coordinates["objectOfIdsOfHexesAndNumbersOfTokens"]
+        dictionary_of_hexes_and_lists_of_vertices = dictionary_of_isometric_coordinates["objectOfIdsOfHexesAndArraysOfIdsOfVertices"]
+        dictionary_of_vertices_and_pairs_of_coordinates = dictionary_of_isometric_coordinates["objectOfIdsOfVerticesAndPairsOfCoordinatesOfVertices"]
+        dictionary_of_vertices_and_lists_of_edges = dictionary_of_isometric_coordinates["objectOfIdsOfVerticesAndListsOfEdgesExtendingFromThoseVertices"]
+        dictionary_of_vertices_and_lists_of_adjacent_vertices = dictionary_of_isometric_coordinates["objectOfIdsOfVerticesAndListsOfIdsOfAdjacentVertices"]
+        dictionary_of_edges_and_pairs_of_coordinates = dictionary_of_isometric_coordinates["objectOfIdsOfEdgesAndPairsOfCoordinatesOfCentersOfEdges"]
+        dictionary_of_edges_and_pairs_of_vertices = dictionary_of_isometric_coordinates["objectOfIdsOfEdgesAndPairsOfIdsOfVertices"]
+
+        list_of_hexes = sorted(dictionary_of_hexes_and_pairs_of_coordinates.keys())
+        list_of_vertices = sorted(dictionary_of_vertices_and_pairs_of_coordinates.keys())
+        list_of_edges = sorted(dictionary_of_edges_and_pairs_of_coordinates.keys())
+        dictionary_of_names_and_enumerators_of_resources = {
+            "nothing": "Resource::Nothing",
+            "brick": "Resource::Brick",
+            "grain": "Resource::Grain",
+            "lumber": "Resource::Lumber",
+            "ore": "Resource::Ore",
+            "wool": "Resource::Wool"
+        }
+
+        indentation = "\t\t"
+        list_of_definitions = [
+            ("int", "NUMBER_OF_HEXES", str(len(list_of_hexes))),
+            ("int", "NUMBER_OF_VERTICES", str(len(list_of_vertices))),
+            ("int", "NUMBER_OF_EDGES", str(len(list_of_edges))),
+            (
+                "std::array<std::array<int, 2>, NUMBER_OF_HEXES>",
+                "COORDINATES_OF_CENTERS_OF_HEXES",
+                self._format_array_of_arrays([dictionary_of_hexes_and_pairs_of_coordinates[hex] for hex in list_of_hexes], indentation)
+            ),
+            (
+                "std::array<std::array<int, 6>, NUMBER_OF_HEXES>",
+                "INDICES_OF_VERTICES_OF_HEXES",
+                self._format_array_of_arrays([self._get_indices(dictionary_of_hexes_and_lists_of_vertices[hex], 6) for hex in list_of_hexes], indentation)
+            ),
+            (
+                "std::array<Resource, NUMBER_OF_HEXES>",
+                "RESOURCES_OF_HEXES",
+                self._format_array([dictionary_of_names_and_enumerators_of_resources[dictionary_of_hexes_and_names_of_resources[hex]] for hex in list_of_hexes])
+            ),
+            (
+                "std::array<int, NUMBER_OF_HEXES>",
+                "NUMBERS_OF_TOKENS_OF_HEXES",
+                self._format_array([dictionary_of_hexes_and_numbers_of_tokens[hex] for hex in list_of_hexes])
+            ),
+            (
+                "std::array<std::array<int, 2>, NUMBER_OF_VERTICES>",
+                "COORDINATES_OF_VERTICES",
+                self._format_array_of_arrays([dictionary_of_vertices_and_pairs_of_coordinates[vertex] for vertex in list_of_vertices], indentation)
+            ),
+            (
+                "std::array<std::array<int, 3>, NUMBER_OF_VERTICES>",
+                "INDICES_OF_ADJACENT_VERTICES",
+                self._format_array_of_arrays([self._get_indices(dictionary_of_vertices_and_lists_of_adjacent_vertices[vertex], 3) for vertex in list_of_vertices], indentation)
+            ),
+            (
+                "std::array<std::array<int, 3>, NUMBER_OF_VERTICES>",
+                "INDICES_OF_EDGES_OF_VERTICES",
+                self._format_array_of_arrays([self._get_indices(dictionary_of_vertices_and_lists_of_edges[vertex], 3) for vertex in list_of_vertices], indentation)
+            ),
+            (
+                "std::array<std::array<int, 2>, NUMBER_OF_EDGES>",
+                "COORDINATES_OF_CENTERS_OF_EDGES",
+                self._format_array_of_arrays([dictionary_of_edges_and_pairs_of_coordinates[edge] for edge in list_of_edges], indentation)
+            ),
+            (
+                "std::array<std::array<int, 2>, NUMBER_OF_EDGES>",
+                "INDICES_OF_VERTICES_OF_EDGES",
+                self._format_array_of_arrays([self._get_indices(dictionary_of_edges_and_pairs_of_vertices[edge], 2) for edge in list_of_edges], indentation)
+            )
+        ]
+
+        lines = [
+            "// File `board_topology_generated.hpp` is generated by `generate_board_geometry/generate_board_geometry.py`",
+            "// from `generate_board_geometry/isometric_coordinates.json`. Do not edit it; run the script instead.",
+            "#pragma once",
+            "",
+            "",
+            "#include <array>",
+            "#include \"resource_bag.hpp\"",
+            "",
+            "",
+            "namespace Game {",
+            "\tnamespace Generated {",
+            "",
+            "\t\t// Indices are zero based. Lists of adjacent vertices and of edges of vertices with fewer than 3 entries are padded with -1."
+        ]
+        for type_of_definition, name_of_definition, value_of_definition in list_of_definitions:
+            if not name_of_definition.startswith("NUMBER_OF_"):
+                lines.append("")
+            lines.append("\t\tconstexpr " + type_of_definition + " " + name_of_definition + " = " + value_of_definition + ";")
+        lines += [
+            "",
+            "\t}",
+            "}",
+            ""
+        ]
+        with open(path_to_header, "w", newline = "\n") as f:
+            f.write("\n".join(lines))
+
+
 def main():
     '''
     Generate a dictionary of board geometry and write the dictionary to a JSON file.
+    Write the topology of the board described by the isometric coordinates to a C++ header of the back end.
     '''
     generator = BoardGeometryGenerator()
     dictionary_of_board_geometry: Dict[str, List[Dict[str, str | float] | Dict[str, float]]] = generator.generate_board_geometry()
@@ -258,6 +389,11 @@ def main():
         json.dump(dictionary_of_board_geometry, f, indent = 4)
     logger.info(f"A dictionary of board geometry was written to {board_geometry_path}.")
 
+    path_to_isometric_coordinates = "generate_board_geometry/isometric_coordinates.json"
+    path_to_header = "back_end/game/board_topology_generated.hpp"
+    BoardTopologyHeaderWriter().write_header(path_to_isometric_coordinates, path_to_header)
+    logger.info(f"The topology of the board in {path_to_isometric_coordinates} was written to {path_to_header}.")
+
 
 if __name__ == "__main__":
     main()
\ No newline at end of file